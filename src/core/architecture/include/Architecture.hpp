@@ -14,6 +14,15 @@
 
 namespace llvm::noelle {
 
+    /*
+     * Distance between two cores that communicate.
+     */
+    enum class CoreDistance {
+      SMT_SIBLING,
+      SAME_SOCKET,
+      CROSS_SOCKET
+    };
+
     class Architecture {
       public:
         Architecture ();
@@ -22,9 +31,64 @@ namespace llvm::noelle {
 
         static uint32_t getNumberOfPhysicalCores (void);
 
+        static uint32_t getNumberOfSockets (void);
+
         static int32_t getCacheLineBytes (void);
 
+        /*
+         * Communication cost model.
+         *
+         * The model is loaded from the file given by -noelle-architecture (generated by "make calibrate" in tests/microbenchmarks).
+         * All latencies are in nanoseconds.
+         * When the model has not been calibrated, the latencies are the constants NOELLE assumed before calibration was available.
+         */
+        static bool isCommunicationCostModelCalibrated (void);
+
+        /*
+         * Latency of a single push (pop) of a value of @bits bits to (from) a queue shared by two cores at @distance.
+         * Widths that have not been measured are rounded up to the closest one that has been measured.
+         */
+        static double getQueuePushLatency (uint32_t bits, CoreDistance distance);
+
+        static double getQueuePopLatency (uint32_t bits, CoreDistance distance);
+
+        /*
+         * Time for a value of @bits bits pushed by a core to be popped by another core at @distance.
+         */
+        static double getQueueTransferLatency (uint32_t bits, CoreDistance distance);
+
+        /*
+         * Time for a store of a core to be visible to another core at @distance (e.g., HELIX signals).
+         */
+        static double getCoreToCoreLatency (CoreDistance distance);
+
+        /*
+         * Time to dispatch and join @cores tasks.
+         */
+        static double getForkJoinLatency (uint32_t cores);
+
+        /*
+         * Distance between the farthest cores that are used when @cores cores run in parallel.
+         */
+        static CoreDistance getDistanceOfCores (uint32_t cores);
+
+        /*
+         * Convert a latency into the units used by the profiler (instructions executed or cycles).
+         */
+        static double fromNanosecondsToInstructions (double nanoseconds);
+
+        static double fromNanosecondsToCycles (double nanoseconds);
+
       private:
+        static std::map<std::string, double> & getMachineDescription (void);
+
+        static bool hasMachineProperty (const std::string &property);
+
+        static double getMachineProperty (const std::string &property, double defaultValue);
+
+        static double getQueueProperty (const std::string &property, uint32_t bits, CoreDistance distance, double defaultValue);
+
+        static std::string getDistanceName (CoreDistance distance);
   };
 
 }
@@ -8,11 +8,15 @@
  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include <fstream>
+
 #include "Architecture.hpp"
 
 using namespace llvm;
 using namespace llvm::noelle;
 
+static cl::opt<std::string> MachineDescriptionFile("noelle-architecture", cl::ZeroOrMore, cl::Hidden, cl::desc("File that describes the communication costs of the target machine"));
+
 Architecture::Architecture (){
   return ;
 }
@@ -22,9 +26,225 @@ uint32_t Architecture::getNumberOfLogicalCores (void){
 }
 
 uint32_t Architecture::getNumberOfPhysicalCores (void){
+  if (hasMachineProperty("physical_cores")){
+    return (uint32_t)getMachineProperty("physical_cores", 1);
+  }
+
   return getNumberOfLogicalCores() / 2;
 }
 
+uint32_t Architecture::getNumberOfSockets (void){
+  return (uint32_t)getMachineProperty("sockets", 1);
+}
+
 int32_t Architecture::getCacheLineBytes (void){
   return 64;
 }
+
+bool Architecture::isCommunicationCostModelCalibrated (void){
+  return getMachineDescription().size() > 0;
+}
+
+double Architecture::getQueuePushLatency (uint32_t bits, CoreDistance distance){
+  return getQueueProperty("queue_push_ns", bits, distance, 50);
+}
+
+double Architecture::getQueuePopLatency (uint32_t bits, CoreDistance distance){
+  return getQueueProperty("queue_pop_ns", bits, distance, 50);
+}
+
+double Architecture::getQueueTransferLatency (uint32_t bits, CoreDistance distance){
+  return getQueueProperty("queue_transfer_ns", bits, distance, 100);
+}
+
+double Architecture::getCoreToCoreLatency (CoreDistance distance){
+
+  /*
+   * Distances that have not been measured (e.g., cross socket on a single socket machine) fall back to closer ones.
+   */
+  for (auto d : { distance, CoreDistance::SAME_SOCKET, CoreDistance::SMT_SIBLING }){
+    auto property = "core_to_core_ns " + getDistanceName(d);
+    if (hasMachineProperty(property)){
+      return getMachineProperty(property, 0);
+    }
+  }
+
+  return 20;
+}
+
+double Architecture::getForkJoinLatency (uint32_t cores){
+
+  /*
+   * Fetch the measurements.
+   */
+  std::map<uint32_t, double> measurements;
+  std::string prefix{"fork_join_ns "};
+  for (auto &pair : getMachineDescription()){
+    if (pair.first.compare(0, prefix.size(), prefix) != 0){
+      continue ;
+    }
+    auto measuredCores = std::stoul(pair.first.substr(prefix.size()));
+    measurements[measuredCores] = pair.second;
+  }
+  if (measurements.size() == 0){
+    return 0;
+  }
+
+  /*
+   * Interpolate linearly between the closest measurements.
+   */
+  auto upper = measurements.lower_bound(cores);
+  if (upper == measurements.end()){
+    auto last = measurements.rbegin();
+    return last->second * (((double)cores) / ((double)last->first));
+  }
+  if (  false
+        || (upper->first == cores)
+        || (upper == measurements.begin())
+    ){
+    return upper->second;
+  }
+  auto lower = std::prev(upper);
+  auto fraction = ((double)(cores - lower->first)) / ((double)(upper->first - lower->first));
+  auto latency = lower->second + fraction * (upper->second - lower->second);
+
+  return latency;
+}
+
+CoreDistance Architecture::getDistanceOfCores (uint32_t cores){
+
+  /*
+   * Threads are spread across the physical cores of a socket first.
+   * Threads that do not fit in a socket go to the other sockets if there are any.
+   * Otherwise, they share the physical cores of the only socket, yet the farthest threads still run on different physical cores of that socket.
+   */
+  auto sockets = getNumberOfSockets();
+  auto physicalCoresPerSocket = std::max(getNumberOfPhysicalCores() / std::max(sockets, (uint32_t)1), (uint32_t)1);
+  if (  true
+        && (cores > physicalCoresPerSocket)
+        && (sockets > 1)
+    ){
+    return CoreDistance::CROSS_SOCKET;
+  }
+
+  return CoreDistance::SAME_SOCKET;
+}
+
+double Architecture::fromNanosecondsToInstructions (double nanoseconds){
+  return nanoseconds / getMachineProperty("instruction_ns", 1);
+}
+
+double Architecture::fromNanosecondsToCycles (double nanoseconds){
+  return nanoseconds / getMachineProperty("cycle_ns", 1);
+}
+
+std::map<std::string, double> & Architecture::getMachineDescription (void){
+  static std::map<std::string, double> description;
+  static bool isLoaded = false;
+
+  /*
+   * Check if the description has been loaded already.
+   */
+  if (isLoaded){
+    return description;
+  }
+  isLoaded = true;
+
+  /*
+   * Check if there is a description of the machine.
+   */
+  if (MachineDescriptionFile.getNumOccurrences() == 0){
+    return description;
+  }
+  std::ifstream machineFile(MachineDescriptionFile.getValue());
+  if (!machineFile.is_open()){
+    errs() << "Architecture: ERROR = cannot open " << MachineDescriptionFile.getValue() << "\n";
+    return description;
+  }
+
+  /*
+   * Read the description.
+   * Every line has the format "PROPERTY [PARAMETER]* VALUE". Lines that start with # are comments.
+   */
+  std::string line;
+  while (std::getline(machineFile, line)){
+    std::istringstream lineStream(line);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (lineStream >> token){
+      tokens.push_back(token);
+    }
+    if (  false
+          || (tokens.size() < 2)
+          || (tokens[0][0] == '#')
+      ){
+      continue ;
+    }
+    std::string property{tokens[0]};
+    for (auto i = 1; i < (tokens.size() - 1); i++){
+      property += " " + tokens[i];
+    }
+    description[property] = std::stod(tokens.back());
+  }
+
+  return description;
+}
+
+bool Architecture::hasMachineProperty (const std::string &property){
+  auto &description = getMachineDescription();
+
+  return description.find(property) != description.end();
+}
+
+double Architecture::getMachineProperty (const std::string &property, double defaultValue){
+  auto &description = getMachineDescription();
+  auto it = description.find(property);
+  if (it == description.end()){
+    return defaultValue;
+  }
+
+  return it->second;
+}
+
+double Architecture::getQueueProperty (const std::string &property, uint32_t bits, CoreDistance distance, double defaultValue){
+
+  /*
+   * Values larger than the widest queue element are split into multiple elements.
+   */
+  auto elements = 1;
+  if (bits > 64){
+    elements = (bits + 63) / 64;
+    bits = 64;
+  }
+
+  /*
+   * Round the width up to the closest one measured.
+   * Distances that have not been measured fall back to closer ones.
+   */
+  for (auto d : { distance, CoreDistance::SAME_SOCKET, CoreDistance::SMT_SIBLING }){
+    for (uint32_t width = 8; width <= 64; width *= 2){
+      if (width < bits){
+        continue ;
+      }
+      auto widthProperty = property + " " + std::to_string(width) + " " + getDistanceName(d);
+      if (hasMachineProperty(widthProperty)){
+        return elements * getMachineProperty(widthProperty, defaultValue);
+      }
+    }
+  }
+
+  return elements * defaultValue;
+}
+
+std::string Architecture::getDistanceName (CoreDistance distance){
+  switch (distance){
+    case CoreDistance::SMT_SIBLING:
+      return "smt";
+    case CoreDistance::SAME_SOCKET:
+      return "socket";
+    case CoreDistance::CROSS_SOCKET:
+      return "cross_socket";
+  }
+
+  abort();
+}
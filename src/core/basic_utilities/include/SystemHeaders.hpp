@@ -24,8 +24,10 @@
 #include <deque>
 #include <thread>
 #include <sstream>
+#include <fstream>
 #include <math.h>
 #include <optional>
+#include <numeric>
 
 /*
  * LLVM headers.
@@ -62,5 +64,6 @@
 #include "llvm/Analysis/PostDominators.h"
 #include "llvm/IR/Mangler.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/CFG.h"
 #include <llvm/IR/Verifier.h>
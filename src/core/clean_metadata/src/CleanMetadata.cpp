@@ -63,6 +63,24 @@ void CleanMetadata::cleanProfMetadata (Module &M){
         if (I.getMetadata("prof")){
           I.setMetadata("prof", nullptr);
         }
+        if (I.getMetadata("noelle.prof.loop_trips")){
+          I.setMetadata("noelle.prof.loop_trips", nullptr);
+        }
+        if (I.getMetadata("noelle.prof.loop_insts")){
+          I.setMetadata("noelle.prof.loop_insts", nullptr);
+        }
+        if (I.getMetadata("noelle.prof.loop_cycles")){
+          I.setMetadata("noelle.prof.loop_cycles", nullptr);
+        }
+        if (I.getMetadata("noelle.prof.loop_memiters")){
+          I.setMetadata("noelle.prof.loop_memiters", nullptr);
+        }
+        if (I.getMetadata("noelle.prof.loop_meminsts")){
+          I.setMetadata("noelle.prof.loop_meminsts", nullptr);
+        }
+        if (I.getMetadata("noelle.prof.loop_memdeps")){
+          I.setMetadata("noelle.prof.loop_memdeps", nullptr);
+        }
       }
     }
   }
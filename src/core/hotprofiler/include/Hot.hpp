@@ -66,6 +66,13 @@ namespace llvm::noelle {
 
       uint64_t getTotalInstructions (SCC *scc) const ;
 
+      /*
+       * Return the total number of cycles spent in @scc.
+       * This requires time profiles (see noelle-prof-loops -noelle-loop-profiler-time).
+       * Instructions outside the loops that have been timed use the cycles per instruction of the whole program (see setDefaultCyclesPerInstruction).
+       */
+      uint64_t getTotalCycles (SCC *scc) const ;
+
 
       /*
        * =========================== Loops =======================================
@@ -111,6 +118,53 @@ namespace llvm::noelle {
 
       double getAverageTotalInstructionsPerIteration (LoopStructure *loop) const ;
 
+      /*
+       * Return true if the distribution of the iterations per invocation of @loop has been profiled (see noelle-prof-loops).
+       */
+      bool hasLoopIterationsDistribution (LoopStructure *loop) const ;
+
+      /*
+       * Return the number of iterations per invocation that is not exceeded by @percentile percent of the invocations of @loop.
+       *
+       * @percentile is between 0 and 100
+       */
+      uint64_t getLoopIterationsPercentile (LoopStructure *loop, double percentile) const ;
+
+      /*
+       * Return the fraction of the invocations of @loop that executed more than @iterations iterations.
+       *
+       * @return Between 0 and 1
+       */
+      double getFractionOfInvocationsWithMoreIterationsThan (LoopStructure *loop, uint64_t iterations) const ;
+
+      /*
+       * Return the number of instructions per invocation (excluding the instructions executed by the callees) that is not exceeded by @percentile percent of the invocations of @loop.
+       *
+       * @percentile is between 0 and 100
+       */
+      uint64_t getSelfInstructionsPerInvocationPercentile (LoopStructure *loop, double percentile) const ;
+
+      void setLoopIterationsDistribution (BasicBlock *header, std::map<uint64_t, uint64_t> histogram);
+
+      void setLoopSelfInstructionsDistribution (BasicBlock *header, std::map<uint64_t, uint64_t> histogram);
+
+      /*
+       * Return true if the time spent in @loop has been profiled (see noelle-prof-loops -noelle-loop-profiler-time).
+       */
+      bool hasLoopTimeProfile (LoopStructure *loop) const ;
+
+      /*
+       * Return the total number of cycles spent in @loop (callees included) among all its invocations.
+       * If @loop has not been timed, but other loops have, its instructions are converted into cycles (see getCyclesPerInstruction).
+       */
+      uint64_t getTotalCycles (LoopStructure *loop) const ;
+
+      double getAverageCyclesPerInvocation (LoopStructure *loop) const ;
+
+      double getAverageCyclesPerIteration (LoopStructure *loop) const ;
+
+      void setLoopTotalCycles (BasicBlock *header, uint64_t cycles);
+
       /*
        * =========================== Functions ==================================
        */
@@ -156,6 +210,22 @@ namespace llvm::noelle {
 
       void computeProgramInvocations (Module &M);
 
+      /*
+       * =========================== Time ========================================
+       */
+      bool hasTimeProfiles (void) const ;
+
+      /*
+       * Return the average number of cycles spent per instruction executed by @bb.
+       * This is the ratio between the cycles and the total instructions of the innermost loop that includes @bb and that has been timed.
+       * If no such loop exists, this is the default cycles per instruction of the program.
+       */
+      double getCyclesPerInstruction (BasicBlock *bb) const ;
+
+      void setCyclesPerInstruction (BasicBlock *bb, double cyclesPerInstruction);
+
+      void setDefaultCyclesPerInstruction (double cyclesPerInstruction);
+
     private:
       std::unordered_map<BasicBlock *, std::unordered_map<BasicBlock *, double>> branchProbability;
       std::unordered_map<BasicBlock *, uint64_t> bbInvocations;
@@ -165,6 +235,16 @@ namespace llvm::noelle {
       std::unordered_map<Instruction *, uint64_t> instructionTotalInstructions;
       uint64_t moduleNumberOfInstructionsExecuted;
 
+      /*
+       * Histograms of the loop invocations indexed by the loop header.
+       * Each histogram maps a bucket (the lower bound of a range of values) to the number of invocations that fall in it.
+       */
+      std::unordered_map<BasicBlock *, std::map<uint64_t, uint64_t>> loopIterationsHistograms;
+      std::unordered_map<BasicBlock *, std::map<uint64_t, uint64_t>> loopSelfInstructionsHistograms;
+      std::unordered_map<BasicBlock *, uint64_t> loopTotalCycles;
+      std::unordered_map<BasicBlock *, double> bbCyclesPerInstruction;
+      double defaultCyclesPerInstruction;
+
       void computeTotalInstructions (Module &M); 
 
       void computeTotalInstructions (Function &F, std::unordered_map<Function *, bool> &evaluationStack);
@@ -172,6 +252,8 @@ namespace llvm::noelle {
       void setFunctionTotalInstructions (Function *f, uint64_t totalInstructions) ;
 
       bool isFunctionTotalInstructionsAvailable (Function &F) const ;
+
+      static uint64_t getPercentile (const std::map<uint64_t, uint64_t> &histogram, double percentile) ;
   };
 
 }
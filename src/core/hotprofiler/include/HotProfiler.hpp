@@ -34,7 +34,14 @@ namespace llvm::noelle {
 
     private:
       Hot hot;
+      std::unordered_map<BasicBlock *, uint64_t> loopCycles;
 
       void analyzeProfiles (Module &M);
+
+      void analyzeLoopProfiles (Module &M);
+
+      void computeCyclesPerInstruction (Module &M);
+
+      std::map<uint64_t, uint64_t> fetchHistogram (MDNode *histogramMetadata);
   };
 }
@@ -18,6 +18,7 @@ using namespace llvm::noelle;
 
 Hot::Hot ()
   : moduleNumberOfInstructionsExecuted{0}
+  , defaultCyclesPerInstruction{1}
   {
   return ;
 }
@@ -331,3 +332,28 @@ void Hot::computeTotalInstructions (
 
   return ;
 }
+
+bool Hot::hasTimeProfiles (void) const {
+  return this->loopTotalCycles.size() > 0;
+}
+
+double Hot::getCyclesPerInstruction (BasicBlock *bb) const {
+  auto cpiIt = this->bbCyclesPerInstruction.find(bb);
+  if (cpiIt == this->bbCyclesPerInstruction.end()){
+    return this->defaultCyclesPerInstruction;
+  }
+
+  return cpiIt->second;
+}
+
+void Hot::setCyclesPerInstruction (BasicBlock *bb, double cyclesPerInstruction){
+  this->bbCyclesPerInstruction[bb] = cyclesPerInstruction;
+
+  return ;
+}
+
+void Hot::setDefaultCyclesPerInstruction (double cyclesPerInstruction){
+  this->defaultCyclesPerInstruction = cyclesPerInstruction;
+
+  return ;
+}
@@ -74,14 +74,169 @@ void HotProfiler::analyzeProfiles (Module &M){
     }
   }
 
+  /*
+   * Fetch the loop profiles.
+   */
+  this->analyzeLoopProfiles(M);
+
   /*
    * Compute the global counters.
    */
   this->hot.computeProgramInvocations(M);
 
+  /*
+   * Distribute the time spent in loops among their instructions.
+   */
+  this->computeCyclesPerInstruction(M);
+
+  return ;
+}
+
+void HotProfiler::analyzeLoopProfiles (Module &M){
+
+  /*
+   * Loop profiles are attached to the terminator of the loop headers (see noelle-meta-loop-prof-embed).
+   */
+  for (auto &F : M){
+    for (auto &bb : F){
+      auto terminator = bb.getTerminator();
+      if (terminator == nullptr){
+        continue ;
+      }
+
+      /*
+       * Fetch the distribution of the iterations per invocation.
+       */
+      if (auto histogramMetadata = terminator->getMetadata("noelle.prof.loop_trips")){
+        this->hot.setLoopIterationsDistribution(&bb, this->fetchHistogram(histogramMetadata));
+      }
+
+      /*
+       * Fetch the distribution of the instructions per invocation.
+       */
+      if (auto histogramMetadata = terminator->getMetadata("noelle.prof.loop_insts")){
+        this->hot.setLoopSelfInstructionsDistribution(&bb, this->fetchHistogram(histogramMetadata));
+      }
+
+      /*
+       * Fetch the time spent in the loop.
+       * The total is stored in the bucket 0.
+       */
+      if (auto cyclesMetadata = terminator->getMetadata("noelle.prof.loop_cycles")){
+        auto cyclesHistogram = this->fetchHistogram(cyclesMetadata);
+        this->hot.setLoopTotalCycles(&bb, cyclesHistogram[0]);
+        this->loopCycles[&bb] = cyclesHistogram[0];
+      }
+    }
+  }
+
+  return ;
+}
+
+void HotProfiler::computeCyclesPerInstruction (Module &M){
+
+  /*
+   * Check if the time has been profiled.
+   */
+  if (  false
+        || (!this->hot.hasTimeProfiles())
+        || (!this->hot.isAvailable())
+    ){
+    return ;
+  }
+
+  uint64_t timedCycles = 0;
+  uint64_t timedInsts = 0;
+  uint64_t untimedInsts = 0;
+  for (auto &F : M){
+    if (F.empty()){
+      continue ;
+    }
+    auto& LI = getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+
+    /*
+     * Visit the loops from the outermost to the innermost ones.
+     * This way, the basic blocks get the ratio of the innermost loop that has been timed.
+     */
+    std::unordered_set<BasicBlock *> timedBBs{};
+    for (auto loop : LI.getLoopsInPreorder()){
+      auto header = loop->getHeader();
+      auto cyclesIt = this->loopCycles.find(header);
+      if (cyclesIt == this->loopCycles.end()){
+        continue ;
+      }
+
+      /*
+       * Compute the average number of cycles per instruction of the loop.
+       */
+      uint64_t loopInsts = 0;
+      for (auto bb : loop->blocks()){
+        loopInsts += this->hot.getTotalInstructions(bb);
+      }
+      if (loopInsts == 0){
+        continue ;
+      }
+      auto cyclesPerInstruction = ((double)cyclesIt->second) / ((double)loopInsts);
+
+      /*
+       * Accumulate the outermost timed loops to compute the cycles per instruction of the whole program.
+       */
+      if (timedBBs.find(header) == timedBBs.end()){
+        timedCycles += cyclesIt->second;
+        timedInsts += loopInsts;
+      }
+
+      /*
+       * Assign it to the basic blocks of the loop.
+       */
+      for (auto bb : loop->blocks()){
+        this->hot.setCyclesPerInstruction(bb, cyclesPerInstruction);
+        timedBBs.insert(bb);
+      }
+    }
+
+    /*
+     * Collect the instructions executed outside the loops that have been timed.
+     */
+    for (auto &bb : F){
+      if (timedBBs.find(&bb) != timedBBs.end()){
+        continue ;
+      }
+      untimedInsts += this->hot.getSelfInstructions(&bb);
+    }
+  }
+
+  /*
+   * Instructions outside the loops that have been timed use the cycles per instruction of the loops that have.
+   */
+  if (timedInsts == 0){
+    errs() << "HotProfiler: WARNING: no timed loop executed instructions. Assuming 1 cycle per instruction for the whole program\n";
+    return ;
+  }
+  auto defaultCyclesPerInstruction = ((double)timedCycles) / ((double)timedInsts);
+  this->hot.setDefaultCyclesPerInstruction(defaultCyclesPerInstruction);
+  if (untimedInsts > 0){
+    errs() << "HotProfiler: WARNING: " << untimedInsts << " instructions executed outside timed loops. Assuming " << defaultCyclesPerInstruction << " cycles per instruction for them\n";
+  }
+
   return ;
 }
 
+std::map<uint64_t, uint64_t> HotProfiler::fetchHistogram (MDNode *histogramMetadata){
+  std::map<uint64_t, uint64_t> histogram{};
+
+  /*
+   * The histogram is encoded as a sequence of (bucket, count) pairs.
+   */
+  for (auto i = 0; (i + 1) < histogramMetadata->getNumOperands(); i += 2){
+    auto bucket = mdconst::extract<ConstantInt>(histogramMetadata->getOperand(i))->getZExtValue();
+    auto count = mdconst::extract<ConstantInt>(histogramMetadata->getOperand(i + 1))->getZExtValue();
+    histogram[bucket] = count;
+  }
+
+  return histogram;
+}
+
 Hot& HotProfiler::getHot (void){
   return this->hot;
 }
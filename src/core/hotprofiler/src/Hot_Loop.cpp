@@ -178,3 +178,202 @@ uint64_t Hot::getIterations (LoopStructure *l) const {
 
   return loopIterations;
 }
+
+bool Hot::hasLoopIterationsDistribution (LoopStructure *loop) const {
+  auto header = loop->getHeader();
+
+  return this->loopIterationsHistograms.find(header) != this->loopIterationsHistograms.end();
+}
+
+uint64_t Hot::getLoopIterationsPercentile (LoopStructure *loop, double percentile) const {
+
+  /*
+   * Fetch the histogram.
+   */
+  auto header = loop->getHeader();
+  auto histogramIt = this->loopIterationsHistograms.find(header);
+  if (histogramIt == this->loopIterationsHistograms.end()){
+    return 0;
+  }
+
+  return Hot::getPercentile(histogramIt->second, percentile);
+}
+
+double Hot::getFractionOfInvocationsWithMoreIterationsThan (LoopStructure *loop, uint64_t iterations) const {
+
+  /*
+   * Fetch the histogram.
+   */
+  auto header = loop->getHeader();
+  auto histogramIt = this->loopIterationsHistograms.find(header);
+  if (histogramIt == this->loopIterationsHistograms.end()){
+    return 0;
+  }
+
+  /*
+   * Count the invocations.
+   */
+  uint64_t invocations = 0;
+  uint64_t invocationsAbove = 0;
+  for (auto &pair : histogramIt->second){
+    invocations += pair.second;
+    if (pair.first > iterations){
+      invocationsAbove += pair.second;
+    }
+  }
+  if (invocations == 0){
+    return 0;
+  }
+
+  return ((double)invocationsAbove) / ((double)invocations);
+}
+
+uint64_t Hot::getSelfInstructionsPerInvocationPercentile (LoopStructure *loop, double percentile) const {
+
+  /*
+   * Fetch the histogram.
+   */
+  auto header = loop->getHeader();
+  auto histogramIt = this->loopSelfInstructionsHistograms.find(header);
+  if (histogramIt == this->loopSelfInstructionsHistograms.end()){
+    return 0;
+  }
+
+  return Hot::getPercentile(histogramIt->second, percentile);
+}
+
+void Hot::setLoopIterationsDistribution (BasicBlock *header, std::map<uint64_t, uint64_t> histogram){
+  this->loopIterationsHistograms[header] = histogram;
+
+  return ;
+}
+
+void Hot::setLoopSelfInstructionsDistribution (BasicBlock *header, std::map<uint64_t, uint64_t> histogram){
+  this->loopSelfInstructionsHistograms[header] = histogram;
+
+  return ;
+}
+
+uint64_t Hot::getPercentile (const std::map<uint64_t, uint64_t> &histogram, double percentile){
+
+  /*
+   * Count the invocations.
+   */
+  uint64_t invocations = 0;
+  for (auto &pair : histogram){
+    invocations += pair.second;
+  }
+  if (invocations == 0){
+    return 0;
+  }
+
+  /*
+   * Find the first bucket that includes the requested fraction of invocations.
+   */
+  auto invocationsToInclude = (percentile / 100) * ((double)invocations);
+  uint64_t invocationsIncluded = 0;
+  for (auto &pair : histogram){
+    invocationsIncluded += pair.second;
+    if (((double)invocationsIncluded) >= invocationsToInclude){
+      return pair.first;
+    }
+  }
+
+  return histogram.rbegin()->first;
+}
+
+bool Hot::hasLoopTimeProfile (LoopStructure *loop) const {
+  auto header = loop->getHeader();
+
+  return this->loopTotalCycles.find(header) != this->loopTotalCycles.end();
+}
+
+uint64_t Hot::getTotalCycles (LoopStructure *loop) const {
+  auto header = loop->getHeader();
+  auto cyclesIt = this->loopTotalCycles.find(header);
+  if (cyclesIt != this->loopTotalCycles.end()){
+    return cyclesIt->second;
+  }
+
+  /*
+   * The loop has not been timed.
+   * Convert its instructions into cycles by using the cycles per instruction of its basic blocks.
+   */
+  if (!this->hasTimeProfiles()){
+    return 0;
+  }
+  double cycles = 0;
+  for (auto bb : loop->getBasicBlocks()){
+    cycles += this->getTotalInstructions(bb) * this->getCyclesPerInstruction(bb);
+  }
+
+  return (uint64_t)cycles;
+}
+
+double Hot::getAverageCyclesPerInvocation (LoopStructure *loop) const {
+
+  /*
+   * Fetch the number of times the loop is invoked.
+   * The invocations are counted exactly by the loop profiler, so we prefer them to the ones derived from the basic block counters.
+   */
+  uint64_t loopInvocations = 0;
+  auto histogramIt = this->loopIterationsHistograms.find(loop->getHeader());
+  if (histogramIt != this->loopIterationsHistograms.end()){
+    for (auto &pair : histogramIt->second){
+      loopInvocations += pair.second;
+    }
+  } else {
+    loopInvocations = this->getInvocations(loop);
+  }
+  if (loopInvocations == 0){
+    return 0;
+  }
+
+  /*
+   * Compute the stats.
+   */
+  auto cycles = this->getTotalCycles(loop);
+  auto cyclesPerInvocation = ((double)cycles) / ((double)loopInvocations);
+
+  return cyclesPerInvocation;
+}
+
+double Hot::getAverageCyclesPerIteration (LoopStructure *loop) const {
+
+  /*
+   * Fetch the total number of iterations executed.
+   */
+  uint64_t loopIterations = 0;
+  if (this->isAvailable()){
+    loopIterations = this->getIterations(loop);
+
+  } else {
+
+    /*
+     * Approximate the iterations by the lower bounds of the buckets of the trip count distribution.
+     */
+    auto histogramIt = this->loopIterationsHistograms.find(loop->getHeader());
+    if (histogramIt != this->loopIterationsHistograms.end()){
+      for (auto &pair : histogramIt->second){
+        loopIterations += pair.first * pair.second;
+      }
+    }
+  }
+  if (loopIterations == 0){
+    return 0;
+  }
+
+  /*
+   * Compute the stats.
+   */
+  auto cycles = this->getTotalCycles(loop);
+  auto cyclesPerIteration = ((double)cycles) / ((double)loopIterations);
+
+  return cyclesPerIteration;
+}
+
+void Hot::setLoopTotalCycles (BasicBlock *header, uint64_t cycles){
+  this->loopTotalCycles[header] = cycles;
+
+  return ;
+}
@@ -39,3 +39,15 @@ uint64_t Hot::getTotalInstructions (SCC *scc) const {
 
   return t;
 }
+
+uint64_t Hot::getTotalCycles (SCC *scc) const {
+  double t=0;
+
+  auto accumulateF = [this, &t] (Instruction *i) -> bool {
+    t += this->getTotalInstructions(i) * this->getCyclesPerInstruction(i->getParent());
+    return false;
+  };
+  scc->iterateOverInstructions(accumulateF);
+
+  return (uint64_t)t;
+}
@@ -41,6 +41,7 @@ bool HotProfiler::runOnModule (Module &M) {
 void HotProfiler::getAnalysisUsage (AnalysisUsage &AU) const {
   AU.addRequired<BlockFrequencyInfoWrapperPass> ();
   AU.addRequired<BranchProbabilityInfoWrapperPass> ();
+  AU.addRequired<LoopInfoWrapperPass> ();
   AU.setPreservesAll();
 
   return ;
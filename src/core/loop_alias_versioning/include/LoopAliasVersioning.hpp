@@ -0,0 +1,51 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "LoopDependenceInfo.hpp"
+#include "SCC.hpp"
+#include "llvm/Analysis/LoopAccessAnalysis.h"
+
+namespace llvm::noelle {
+
+  class LoopAliasVersioning {
+    public:
+
+      /*
+       * Constructor
+       */
+      LoopAliasVersioning ();
+
+      /*
+       * Version the loop if its only loop-carried dependences are between memory accesses that may alias.
+       * The versioned loop runs when run-time checks prove that the memory ranges accessed by the loop do not overlap, and the original loop runs otherwise.
+       */
+      bool versionLoop (
+        LoopDependenceInfo &LDI,
+        LoopInfo &LI,
+        DominatorTree &DT,
+        LoopAccessLegacyAnalysis &LAA
+        );
+
+    private:
+
+      /*
+       * Methods
+       */
+      bool collectMemoryAccessesToDisambiguate (
+        LoopDependenceInfo &LDI,
+        std::unordered_set<Instruction *> &accesses
+        ) const ;
+
+  };
+
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LoopAliasVersioning.hpp"
+#include "llvm/Transforms/Utils/LoopVersioning.h"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+LoopAliasVersioning::LoopAliasVersioning()
+  {
+  return ;
+}
+
+bool LoopAliasVersioning::versionLoop (
+  LoopDependenceInfo &LDI,
+  LoopInfo &LI,
+  DominatorTree &DT,
+  LoopAccessLegacyAnalysis &LAA
+  ){
+
+  /*
+   * Fetch the loop summary
+   */
+  auto ls = LDI.getLoopStructure();
+  auto h = ls->getHeader();
+  auto headerTerm = h->getTerminator();
+
+  /*
+   * Check if the loop has been versioned already.
+   * Both the versioned loop and the original one are tagged, so neither of them is versioned again.
+   */
+  if (headerTerm->getMetadata("noelle.loop_versioned")){
+    return false;
+  }
+
+  /*
+   * The loop must have an induction variable that controls the number of iterations.
+   * Otherwise, the versioned loop would not be a DOALL either.
+   */
+  if (LDI.getLoopGoverningIVAttribution() == nullptr){
+    return false;
+  }
+
+  /*
+   * Collect the memory accesses that block the parallelization of the loop.
+   */
+  std::unordered_set<Instruction *> accesses;
+  if (!this->collectMemoryAccessesToDisambiguate(LDI, accesses)){
+    return false;
+  }
+  if (accesses.size() == 0){
+    return false;
+  }
+
+  /*
+   * Fetch the LLVM loop.
+   * The versioning requires it to be in simplified and LCSSA forms with a single exit block.
+   */
+  auto llvmLoop = LI.getLoopFor(h);
+  if (  false
+        || (llvmLoop == nullptr)
+        || (llvmLoop->getHeader() != h)
+        || (!llvmLoop->isLoopSimplifyForm())
+        || (llvmLoop->getExitBlock() == nullptr)
+        || (!llvmLoop->isLCSSAForm(DT))
+    ){
+    return false;
+  }
+
+  /*
+   * Compute the ranges of memory accessed by the loop.
+   * The bounds of these ranges are computed by SCEV, so the addresses of the accesses must be affine.
+   */
+  auto &LAI = LAA.getInfo(llvmLoop);
+  if (!LAI.canVectorizeMemory()){
+    return false;
+  }
+  auto rtChecking = LAI.getRuntimePointerChecking();
+  if (  false
+        || (!rtChecking->Need)
+        || (LAI.getNumRuntimePointerChecks() == 0)
+    ){
+    return false;
+  }
+
+  /*
+   * Every access that blocks the parallelization must be disambiguated by the run-time checks.
+   * Otherwise, the dependences of the versioned loop would not change.
+   */
+  std::unordered_set<Value *> checkedPointers;
+  for (auto &pointer : rtChecking->Pointers){
+    checkedPointers.insert(pointer.PointerValue);
+  }
+  for (auto access : accesses){
+    auto pointer = getLoadStorePointerOperand(access);
+    if (checkedPointers.find(pointer) == checkedPointers.end()){
+      return false;
+    }
+  }
+
+  /*
+   * Tag the loop.
+   * The tag is copied to the original loop by the versioning.
+   */
+  auto &context = headerTerm->getContext();
+  auto trueMetadataString = MDString::get(context, "true");
+  auto trueMetadata = MDNode::get(context, trueMetadataString);
+  headerTerm->setMetadata("noelle.loop_versioned", trueMetadata);
+
+  /*
+   * Version the loop.
+   * The range-overlap checks are added to the pre-header.
+   * The memory accesses of the versioned loop are annotated with alias scopes, so the dependences disproved by the checks are not part of its PDG.
+   */
+  errs() << "   Version the loop with " << LAI.getNumRuntimePointerChecks() << " run-time alias checks\n";
+  auto SE = LAI.getPSE().getSE();
+  LoopVersioning versioning(LAI, llvmLoop, &LI, &DT, SE);
+  versioning.versionLoop();
+  versioning.annotateLoopWithNoAlias();
+
+  return true;
+}
+
+bool LoopAliasVersioning::collectMemoryAccessesToDisambiguate (
+  LoopDependenceInfo &LDI,
+  std::unordered_set<Instruction *> &accesses
+  ) const {
+
+  /*
+   * Check every SCC with loop-carried data dependences that must execute sequentially.
+   */
+  auto sccManager = LDI.getSCCManager();
+  for (auto scc : sccManager->getSCCsWithLoopCarriedDataDependencies()){
+
+    /*
+     * Fetch the SCC metadata.
+     */
+    auto sccInfo = sccManager->getSCCAttrs(scc);
+
+    /*
+     * Skip SCCs that do not block the parallelization of the loop.
+     */
+    if (  false
+          || sccInfo->canExecuteReducibly()
+          || sccInfo->canBeCloned()
+          || sccInfo->canBeClonedUsingLocalMemoryLocations()
+          || sccInfo->canBeReducedUsingPrivateMemoryLocations()
+      ){
+      continue ;
+    }
+
+    /*
+     * All loop-carried dependences of the SCC must be may-alias ones between loads and stores.
+     */
+    auto onlyMayAliasAccesses = true;
+    sccManager->iterateOverLoopCarriedDataDependences(scc, [&accesses, &onlyMayAliasAccesses](DGEdge<Value> *dep) -> bool {
+      auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
+      auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
+      if (  false
+            || (!dep->isMemoryDependence())
+            || dep->isMustDependence()
+            || (fromInst == nullptr)
+            || (toInst == nullptr)
+            || (getLoadStorePointerOperand(fromInst) == nullptr)
+            || (getLoadStorePointerOperand(toInst) == nullptr)
+        ){
+        onlyMayAliasAccesses = false;
+        return true;
+      }
+      accesses.insert(fromInst);
+      accesses.insert(toInst);
+      return false;
+    });
+    if (!onlyMayAliasAccesses){
+      return false;
+    }
+  }
+
+  return true;
+}
@@ -77,13 +77,15 @@ namespace llvm::noelle {
     void generateEnvVariables (IRBuilder<>);
 
     /*
-     * Reduce live out variables given binary operators to reduce
+     * Reduce live out variables given the operators to reduce
      * with and initial values to start at
+     *
+     * The operator of a variable generates the code that combines the value accumulated so far with the private copy of a thread
      */
     BasicBlock * reduceLiveOutVariables (
       BasicBlock *bb,
       IRBuilder<>,
-      std::unordered_map<int, int> &reducableBinaryOps,
+      std::unordered_map<int, std::function<Value * (IRBuilder<> &builder, Value *accumulatedValue, Value *privateValue)>> &reducers,
       std::unordered_map<int, Value *> &initialValues,
       Value *numberOfThreadsExecuted
     );
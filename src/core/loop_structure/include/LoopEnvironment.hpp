@@ -67,6 +67,7 @@ namespace llvm::noelle {
       std::unordered_map<Value *, std::set<Value *>> prodConsumers;
 
       bool hasExitBlockEnv;
+      int64_t exitBlockIndex;
       Type *exitBlockType;
   };
 
@@ -323,7 +323,7 @@ void EnvBuilder::generateEnvVariables (IRBuilder<> builder) {
 BasicBlock * EnvBuilder::reduceLiveOutVariables (
   BasicBlock *bb,
   IRBuilder<> builder,
-  std::unordered_map<int, int> &reducableBinaryOps,
+  std::unordered_map<int, std::function<Value * (IRBuilder<> &builder, Value *accumulatedValue, Value *privateValue)>> &reducers,
   std::unordered_map<int, Value *> &initialValues,
   Value *numberOfThreadsExecuted
 ) {
@@ -445,9 +445,9 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
     auto envIndex = envIndexInitValue.first;
 
     /*
-     * Fetch the information about the operation to perform to accumulate values.
+     * Fetch the operation to perform to accumulate values.
      */
-    auto binOp = (Instruction::BinaryOps)reducableBinaryOps[envIndex];
+    auto &reducer = reducers.at(envIndex);
 
     /*
      * Fetch the accumulator, which is the PHI node related to the current reduced variable.
@@ -458,7 +458,7 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
      * Accumulate values to the accumulator of the current reduced variable.
      */
     auto privateCurrentCopy = loadedValues[count];
-    auto newAccumulatorValue = loopBodyBuilder.CreateBinOp(binOp, accumVal, privateCurrentCopy);
+    auto newAccumulatorValue = reducer(loopBodyBuilder, accumVal, privateCurrentCopy);
 
     /*
      * Keep track of the new accumulator value.
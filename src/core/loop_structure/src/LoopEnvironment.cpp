@@ -17,6 +17,8 @@ LoopEnvironment::LoopEnvironment (
   PDG *loopDG, 
   std::vector<BasicBlock *> &exitBlocks
   ) {
+  this->hasExitBlockEnv = false;
+  this->exitBlockIndex = -1;
 
   /*
    * Initialize the environment of the loop.
@@ -87,17 +89,21 @@ LoopEnvironment::LoopEnvironment (
   if (this->hasExitBlockEnv) {
     auto &cxt = exitBlocks[0]->getContext();
     this->exitBlockType = IntegerType::get(cxt, 32);
+    this->exitBlockIndex = this->envProducers.size();
   }
 
   return ;
 }
 
 Type * LoopEnvironment::typeOfEnvironmentLocation (uint64_t index) const {
-  if (index < envProducers.size()) {
-    return envProducers[index]->getType();
+  if (  true
+        && hasExitBlockEnv
+        && (index == exitBlockIndex)
+     ){
+    return exitBlockType;
   }
 
-  return exitBlockType;
+  return envProducers[index]->getType();
 }
 
 uint64_t LoopEnvironment::addProducer (Value *producer, bool liveIn){
@@ -114,6 +120,17 @@ uint64_t LoopEnvironment::addProducer (Value *producer, bool liveIn){
     c++;
   }
 
+  /*
+   * The location of the exit block taken is fixed when the environment is created.
+   * Producers added later (e.g., live-ins introduced by a parallelization technique) skip it.
+   */
+  if (  true
+        && this->hasExitBlockEnv
+        && (this->envProducers.size() == this->exitBlockIndex)
+     ){
+    this->envProducers.push_back(nullptr);
+  }
+
   /*
    * Add @producer to the environment.
    */
@@ -183,11 +200,13 @@ void LoopEnvironment::addLiveOutProducer (Value *producer) {
 }
 
 int64_t LoopEnvironment::indexOfExitBlockTaken (void) const {
-  return hasExitBlockEnv ? envProducers.size() : -1; 
+  return exitBlockIndex;
 }
 
 uint64_t LoopEnvironment::size (void) const {
-  return envProducers.size() + (hasExitBlockEnv ? 1 : 0);
+  auto isExitBlockLocationReserved = hasExitBlockEnv && (envProducers.size() > exitBlockIndex);
+
+  return envProducers.size() + ((hasExitBlockEnv && !isExitBlockLocationReserved) ? 1 : 0);
 }
 
 std::set<Value *> LoopEnvironment::consumersOf (Value *prod) const {
@@ -29,6 +29,47 @@ namespace llvm::noelle {
       bool isSubOp (unsigned op);
       unsigned accumOpForType (unsigned op, Type *type);
       Value *generateIdentityFor (Instruction *accumulator, Type *castType);
+
+      /*
+       * Check if @inst accumulates values (e.g., add, xor, min, max).
+       */
+      bool isAccumulator (Instruction *inst);
+
+      /*
+       * Generate the code that combines two values accumulated by @accumulator (e.g., the private copies of two threads).
+       */
+      Value *generateAccumulation (
+        IRBuilder<> &builder,
+        Instruction *accumulator,
+        Value *accumulatedValue,
+        Value *newValue
+        );
+
+      /*
+       * Check if @inst computes the minimum or the maximum between its operands.
+       * This is either a select between the operands of a comparison (e.g., select (icmp sgt a, b), a, b) or a call to llvm.minnum, llvm.maxnum, llvm.minimum, or llvm.maximum.
+       * Floating point selects are accepted only if NaNs and signed zeros can be ignored (see canReorderFloatingPointMinMax).
+       */
+      static bool isMinMax (Instruction *inst);
+
+      /*
+       * Check if @inst and @otherInst compute the same operation (e.g., both compute the signed maximum).
+       */
+      static bool isSameMinMax (Instruction *inst, Instruction *otherInst);
+
+    private:
+
+      /*
+       * Return the predicate P such that the minimum or maximum computed by @inst is "P(x, y) ? x : y".
+       */
+      static CmpInst::Predicate getMinMaxPredicate (Instruction *inst);
+
+      static bool isMaxPredicate (CmpInst::Predicate predicate);
+
+      /*
+       * Check if the floating point min/max computed by @selectInst with @compare can be computed in any order.
+       */
+      static bool canReorderFloatingPointMinMax (SelectInst *selectInst, CmpInst *compare);
   };
 
 }
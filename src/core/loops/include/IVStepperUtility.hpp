@@ -46,6 +46,40 @@ namespace llvm::noelle {
         Value *additionalStepSize
       );
 
+      /*
+       * Return the predicate that compares the loop-governing induction variable (as left operand) to its exit value and that holds when the loop keeps iterating.
+       */
+      static CmpInst::Predicate fetchPredicateToContinue (
+        LoopGoverningIVAttribution *attribution
+      );
+
+      /*
+       * Check if the number of iterations of an invocation of @loop can be computed before executing it.
+       */
+      static bool canComputeTripCount (
+        LoopStructure *loop,
+        LoopGoverningIVAttribution *attribution
+      );
+
+      /*
+       * Generate the code that computes the number of iterations of the current invocation of @loop.
+       * The code is generated where @builder points to, which must be outside @loop (e.g., in its preheader).
+       *
+       * Return nullptr if the trip count cannot be computed there.
+       */
+      static Value *generateCodeToComputeTripCount (
+        LoopStructure *loop,
+        LoopGoverningIVAttribution *attribution,
+        IRBuilder<> &builder
+      );
+
+      /*
+       * Check if the header of the loop compares the value of the induction variable computed for the next iteration (e.g., "i + 1 < N") rather than the current one.
+       */
+      static bool isUpdatedValueCompared (
+        LoopGoverningIVAttribution *attribution
+      );
+
   };
 
   class LoopGoverningIVUtility {
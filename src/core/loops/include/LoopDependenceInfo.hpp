@@ -38,6 +38,7 @@ namespace llvm::noelle {
        * Parallelization options
        */
       uint32_t DOALLChunkSize;
+      bool hasUserDefinedDOALLChunkSize;
 
       /*
        * Constructors.
@@ -173,6 +174,11 @@ namespace llvm::noelle {
 
       uint32_t getMaximumNumberOfCores (void) const ;
 
+      /*
+       * Change the maximum number of cores the parallelized loop can use (e.g., because of the feedback of a previous run).
+       */
+      void setMaximumNumberOfCores (uint32_t maxCores) ;
+
       /*
        * Deconstructor.
        */
@@ -237,7 +243,12 @@ namespace llvm::noelle {
 
       void removeUnnecessaryDependenciesThatCloningMemoryNegates (
         PDG *loopInternalDG,
-        DominatorSummary &DS
+        DominatorSummary &DS,
+        ScalarEvolution &SE
+      ) ;
+
+      void refinePDGWithMemoryDependenceProfiles (
+        PDG *loopDG
       ) ;
 
   };
@@ -44,6 +44,25 @@ namespace llvm::noelle {
         Instruction *to
       ) const ;
 
+      /*
+       * Return the number of bytes between the memory locations accessed by @memoryAccess on two consecutive iterations of the outermost loop.
+       * Return 0 if this distance is unknown or if it is not a compile-time constant.
+       */
+      int64_t getStrideOfMemoryAccessBetweenIterations (
+        Instruction *memoryAccess
+      ) const ;
+
+      /*
+       * Return the number of iterations of the outermost loop between an instance of the load/store @from and the instance of the load/store @to that accesses the same memory location.
+       * The distance is negative if @to accesses that location before @from does, and it is 0 if they only access the same location within the same iteration.
+       * Return std::nullopt if the distance is unknown or if it is not a compile-time constant.
+       */
+      std::optional<int64_t> getDependenceDistanceBetweenIterations (
+        Instruction *from,
+        Instruction *to,
+        ScalarEvolution &SE
+      ) const ;
+
     private:
 
       /*
@@ -25,7 +25,7 @@ namespace llvm::noelle {
 
   class MemoryCloningAnalysis {
     public:
-      MemoryCloningAnalysis (LoopStructure *loop, DominatorSummary &DS, PDG *ldg);
+      MemoryCloningAnalysis (LoopStructure *loop, DominatorSummary &DS, ScalarEvolution &SE, PDG *ldg);
 
       const ClonableMemoryLocation * getClonableMemoryLocationFor (Instruction *I) const ;
 
@@ -45,7 +45,26 @@ namespace llvm::noelle {
         PDG *ldg
       ) ;
 
-      AllocaInst * getAllocation (void) const ;
+      /*
+       * Heap object allocated by @allocation (e.g., malloc) before @loop.
+       * The object can be cloned if every iteration of @loop fully overwrites it before reading it.
+       */
+      ClonableMemoryLocation (
+        CallInst *allocation,
+        LoopStructure *loop,
+        DominatorSummary &DS,
+        ScalarEvolution &SE
+      ) ;
+
+      Instruction * getAllocation (void) const ;
+
+      bool isHeapObject (void) const ;
+
+      /*
+       * Generate the code that computes the size (in bytes) of the heap object.
+       * The code is generated where @builder points to; the operands of the allocation must be available there.
+       */
+      Value * generateCodeToComputeSizeInBytes (IRBuilder<> &builder) const ;
 
       std::unordered_set<Instruction *> getLoopInstructionsUsingLocation (void) const ;
 
@@ -61,13 +80,18 @@ namespace llvm::noelle {
 
       static bool isMemCpyInstrinsicCall (CallInst *call) ;
 
+      static bool isHeapAllocationCall (CallInst *call) ;
+
+      static bool isHeapDeallocationCall (CallInst *call) ;
+
     private:
-      AllocaInst *allocation;
+      Instruction *allocation;
       Type *allocatedType;
       uint64_t sizeInBits;
       LoopStructure *loop;
       bool isClonable;
       bool isScopeWithinLoop;
+      bool isHeap;
 
       std::unordered_set<Instruction *> castsAndGEPs;
       std::unordered_set<Instruction *> storingInstructions;
@@ -78,13 +102,13 @@ namespace llvm::noelle {
 
       bool isThereRAWThroughMemoryFromOutsideLoop (
           LoopStructure *loop, 
-          AllocaInst *al, 
+          Instruction *al, 
           PDG *ldg
           ) const ;
 
       bool isThereRAWThroughMemoryFromOutsideLoop (
           LoopStructure *loop, 
-          AllocaInst *al, 
+          Instruction *al, 
           PDG *ldg,
           std::unordered_set<Instruction *> insts
           ) const ;
@@ -106,6 +130,21 @@ namespace llvm::noelle {
 
       bool isOverrideSetFullyCoveringTheAllocationSpace (OverrideSet *overrideSet) const ;
 
+      bool isFullyOverwrittenBeforeBeingRead (
+        LoopStructure *loop,
+        DominatorSummary &DS,
+        ScalarEvolution &SE
+        ) const ;
+
+      BasicBlock * getBlockAfterFullOverwrite (
+        Instruction *storingInstruction,
+        LoopStructure *loop,
+        DominatorSummary &DS,
+        ScalarEvolution &SE
+        ) const ;
+
+      const SCEV * getSizeInBytesSCEV (ScalarEvolution &SE) const ;
+
       void setObjectScope (
         AllocaInst *allocation,
         LoopStructure *loop,
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+
+#include "PDG.hpp"
+#include "LoopsSummary.hpp"
+#include "AccumulatorOpInfo.hpp"
+
+namespace llvm::noelle {
+
+  class ReducibleMemoryLocation ;
+
+  /*
+   * Identify the memory objects (e.g., arrays and histograms) that a loop only updates with commutative and associative operations (e.g., hist[idx[i]] += w[i]).
+   *
+   * The loop-carried dependences through these objects can be removed by giving each thread a private copy of the object (initialized to the identity of the operation) and by merging the copies into the original object after the loop.
+   */
+  class MemoryReductionAnalysis {
+    public:
+      MemoryReductionAnalysis (
+        LoopStructure *loop,
+        PDG *ldg,
+        AccumulatorOpInfo &opInfo,
+        bool enableFloatAsReal
+        );
+
+      const ReducibleMemoryLocation * getReducibleMemoryLocationFor (Instruction *I) const ;
+
+      std::unordered_set<ReducibleMemoryLocation *> getReducibleMemoryLocations (void) const ;
+
+    private:
+      std::unordered_set<std::unique_ptr<ReducibleMemoryLocation>> reducibleMemoryLocations;
+  };
+
+  class ReducibleMemoryLocation {
+    public:
+      ReducibleMemoryLocation (
+        Value *pointer,
+        LoopStructure *loop,
+        PDG *ldg,
+        AccumulatorOpInfo &opInfo,
+        bool enableFloatAsReal
+        );
+
+      /*
+       * Return the loop-invariant pointer the loop uses to access the object.
+       */
+      Value * getPointer (void) const ;
+
+      /*
+       * Return the allocation of the object (an alloca, or a call to malloc or calloc).
+       */
+      Instruction * getAllocation (void) const ;
+
+      /*
+       * Return the type of the elements of the object updated by the loop.
+       */
+      Type * getElementType (void) const ;
+
+      /*
+       * Return one of the instructions that update the elements of the object.
+       * All of them compute the same operation.
+       */
+      Instruction * getAccumulator (void) const ;
+
+      /*
+       * Generate the code that computes the size of the object in bytes.
+       * The code is appended to @builder, which must be dominated by the allocation of the object.
+       */
+      Value * generateCodeToComputeSizeInBytes (IRBuilder<> &builder) const ;
+
+      bool isInstructionLoadingLocation (Instruction *I) const ;
+      bool isInstructionStoringLocation (Instruction *I) const ;
+      bool isInstructionAccumulatingLocation (Instruction *I) const ;
+
+      bool isReducibleLocation (void) const ;
+
+    private:
+      Value *pointer;
+      Instruction *allocation;
+      Type *elementType;
+      Instruction *accumulator;
+      std::vector<Value *> sizeFactors;
+      bool isReducible;
+
+      std::unordered_set<Instruction *> loadInstructions;
+      std::unordered_set<Instruction *> storingInstructions;
+      std::unordered_set<Instruction *> accumulators;
+
+      bool identifyAllocationAndSize (void) ;
+
+      bool identifyUpdates (
+        LoopStructure *loop,
+        AccumulatorOpInfo &opInfo,
+        bool enableFloatAsReal
+        ) ;
+
+      bool identifyUpdate (
+        LoadInst *load,
+        Value *address,
+        AccumulatorOpInfo &opInfo
+        ) ;
+
+      bool isThereAnotherMemoryDependence (
+        LoopStructure *loop,
+        PDG *ldg
+        ) const ;
+  };
+
+}
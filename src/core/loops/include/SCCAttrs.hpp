@@ -16,6 +16,7 @@
 #include "SCC.hpp"
 #include "Variable.hpp"
 #include "MemoryCloningAnalysis.hpp"
+#include "MemoryReductionAnalysis.hpp"
 
 using namespace llvm;
 
@@ -99,6 +100,11 @@ namespace llvm::noelle {
        */
       bool canBeClonedUsingLocalMemoryLocations (void) const;
 
+      /*
+       * Return true if the loop-carried dependences of the SCC can be removed by reducing private copies of memory objects (e.g., histograms)
+       */
+      bool canBeReducedUsingPrivateMemoryLocations (void) const;
+
       /*
        * Return true if the SCC exists because of updates of an induction variable.
        * Return false otherwise.
@@ -183,7 +189,13 @@ namespace llvm::noelle {
 
       void addClonableMemoryLocationsContainedInSCC (std::unordered_set<const ClonableMemoryLocation *> locations) ;
 
-      std::unordered_set<AllocaInst *> getMemoryLocationsToClone (void) const ;
+      std::unordered_set<Instruction *> getMemoryLocationsToClone (void) const ;
+
+      void setSCCToBeReducibleUsingPrivateMemory (void) ;
+
+      void addReducibleMemoryLocationsContainedInSCC (std::unordered_set<const ReducibleMemoryLocation *> locations) ;
+
+      std::unordered_set<const ReducibleMemoryLocation *> getMemoryLocationsToReduce (void) const ;
 
     private:
       SCC *scc;
@@ -199,6 +211,9 @@ namespace llvm::noelle {
       std::unordered_set<const ClonableMemoryLocation *> clonableMemoryLocations;
       bool isSCCClonableIntoLocalMemory;
 
+      std::unordered_set<const ReducibleMemoryLocation *> reducibleMemoryLocations;
+      bool isSCCReducibleIntoPrivateMemory;
+
       bool isClonable;
       bool hasIV;
   
@@ -21,6 +21,7 @@
 #include "LoopEnvironment.hpp"
 #include "Variable.hpp"
 #include "MemoryCloningAnalysis.hpp"
+#include "MemoryReductionAnalysis.hpp"
 
   using namespace std;
   using namespace llvm;
@@ -105,6 +106,7 @@
         PDG *loopDG;
         SCCDAG *sccdag;     /* SCCDAG of the related loop.  */
         MemoryCloningAnalysis *memoryCloningAnalysis;
+        MemoryReductionAnalysis *memoryReductionAnalysis;
 
         /*
          * Helper methods on SCCDAG
@@ -125,6 +127,7 @@
         );
         void checkIfClonable (SCC *scc, ScalarEvolution &SE, LoopsSummary &LIS);
         void checkIfClonableByUsingLocalMemory(SCC *scc, LoopsSummary &LIS) ;
+        void checkIfReducibleByUsingPrivateMemory (SCC *scc) ;
         bool isClonableByInductionVars (SCC *scc) const ;
         bool isClonableBySyntacticSugarInstrs (SCC *scc) const ;
         bool isClonableByCmpBrInstrs (SCC *scc) const ;
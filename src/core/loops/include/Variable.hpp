@@ -169,12 +169,14 @@ namespace llvm::noelle {
       bool isMul (void) const ;
       bool isSub (void) const ;
       bool isSubTransformableToAdd (void) const ;
+      bool isMinMax (void) const ;
 
     private:
 
       bool isBothUpdatesAddOrSub (const EvolutionUpdate &otherUpdate) const ;
       bool isBothUpdatesMul (const EvolutionUpdate &otherUpdate) const ;
       bool isBothUpdatesSameBitwiseLogicalOp (const EvolutionUpdate &otherUpdate) const ;
+      bool isBothUpdatesSameMinMax (const EvolutionUpdate &otherUpdate) const ;
 
       /*
        * The instruction that constitutes the update
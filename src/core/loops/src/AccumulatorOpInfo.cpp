@@ -22,7 +22,8 @@ AccumulatorOpInfo::AccumulatorOpInfo () {
     Instruction::Sub,
     Instruction::FSub,
     Instruction::Or,
-    Instruction::And
+    Instruction::And,
+    Instruction::Xor
   };
 
   this->accumOps = std::set<unsigned>(sideEffectFreeOps.begin(), sideEffectFreeOps.end());
@@ -35,7 +36,8 @@ AccumulatorOpInfo::AccumulatorOpInfo () {
     { Instruction::Sub, 0 },
     { Instruction::FSub, 0 },
     { Instruction::Or, 0 },
-    { Instruction::And, 1 }
+    { Instruction::And, 1 },
+    { Instruction::Xor, 0 }
   };
 
   this->integerReducingOperators = {
@@ -46,7 +48,8 @@ AccumulatorOpInfo::AccumulatorOpInfo () {
     { Instruction::Sub, Instruction::Add },
     { Instruction::FSub, Instruction::Add },
     { Instruction::Or, Instruction::Or },
-    { Instruction::And, Instruction::And }
+    { Instruction::And, Instruction::And },
+    { Instruction::Xor, Instruction::Xor }
   };
 
   this->floatingReducingOperators = {
@@ -90,6 +93,34 @@ unsigned AccumulatorOpInfo::accumOpForType (unsigned op, Type *type) {
 }
 
 Value *AccumulatorOpInfo::generateIdentityFor (Instruction *accumulator, Type *castType) {
+
+  /*
+   * The identity of the maximum is the smallest value of the type and vice versa.
+   */
+  if (AccumulatorOpInfo::isMinMax(accumulator)){
+    auto predicate = AccumulatorOpInfo::getMinMaxPredicate(accumulator);
+    auto isMax = AccumulatorOpInfo::isMaxPredicate(predicate);
+    if (castType->isFloatingPointTy()){
+      return ConstantFP::getInfinity(castType, isMax);
+    }
+    assert(castType->isIntegerTy());
+    auto bits = castType->getIntegerBitWidth();
+    if (CmpInst::isSigned(predicate)){
+      return ConstantInt::get(castType, isMax ? APInt::getSignedMinValue(bits) : APInt::getSignedMaxValue(bits));
+    }
+    return ConstantInt::get(castType, isMax ? APInt::getMinValue(bits) : APInt::getMaxValue(bits));
+  }
+
+  /*
+   * The identity of the bitwise and has all bits set.
+   */
+  if (  true
+        && (accumulator->getOpcode() == Instruction::And)
+        && castType->isIntegerTy()
+    ){
+    return Constant::getAllOnesValue(castType);
+  }
+
   Value *initVal = nullptr;
   auto opIdentity = this->opIdentities[accumulator->getOpcode()];
   if (castType->isIntegerTy()) initVal = ConstantInt::get(castType, opIdentity);
@@ -98,3 +129,236 @@ Value *AccumulatorOpInfo::generateIdentityFor (Instruction *accumulator, Type *c
   assert(initVal != nullptr);
   return initVal;
 }
+
+bool AccumulatorOpInfo::isAccumulator (Instruction *inst) {
+  if (this->accumOps.find(inst->getOpcode()) != this->accumOps.end()){
+    return true;
+  }
+
+  return AccumulatorOpInfo::isMinMax(inst);
+}
+
+Value *AccumulatorOpInfo::generateAccumulation (
+  IRBuilder<> &builder,
+  Instruction *accumulator,
+  Value *accumulatedValue,
+  Value *newValue
+  ) {
+
+  /*
+   * Check if the accumulator is a minimum or a maximum.
+   */
+  if (AccumulatorOpInfo::isMinMax(accumulator)){
+    if (auto intrinsic = dyn_cast<IntrinsicInst>(accumulator)){
+      return builder.CreateBinaryIntrinsic(intrinsic->getIntrinsicID(), accumulatedValue, newValue);
+    }
+    auto predicate = AccumulatorOpInfo::getMinMaxPredicate(accumulator);
+    if (CmpInst::isFPPredicate(predicate)){
+
+      /*
+       * Keep the fast-math flags that made the floating point min/max reducible.
+       */
+      auto originalCompare = cast<SelectInst>(accumulator)->getCondition();
+      auto compare = builder.CreateFCmp(predicate, accumulatedValue, newValue);
+      if (auto compareInst = dyn_cast<Instruction>(compare)){
+        compareInst->copyFastMathFlags(cast<Instruction>(originalCompare));
+      }
+      return builder.CreateSelect(compare, accumulatedValue, newValue);
+    }
+    auto compare = builder.CreateICmp(predicate, accumulatedValue, newValue);
+    return builder.CreateSelect(compare, accumulatedValue, newValue);
+  }
+
+  /*
+   * The accumulator is a binary operator.
+   */
+  auto binOp = (Instruction::BinaryOps)this->accumOpForType(accumulator->getOpcode(), accumulatedValue->getType());
+  return builder.CreateBinOp(binOp, accumulatedValue, newValue);
+}
+
+bool AccumulatorOpInfo::isMinMax (Instruction *inst) {
+
+  /*
+   * Check the intrinsics.
+   */
+  if (auto intrinsic = dyn_cast<IntrinsicInst>(inst)){
+    switch (intrinsic->getIntrinsicID()){
+      case Intrinsic::minnum:
+      case Intrinsic::maxnum:
+      case Intrinsic::minimum:
+      case Intrinsic::maximum:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /*
+   * Check if the instruction selects one of the two values compared by its condition.
+   */
+  auto selectInst = dyn_cast<SelectInst>(inst);
+  if (selectInst == nullptr){
+    return false;
+  }
+  auto compare = dyn_cast<CmpInst>(selectInst->getCondition());
+  if (compare == nullptr){
+    return false;
+  }
+  auto trueValue = selectInst->getTrueValue();
+  auto falseValue = selectInst->getFalseValue();
+  auto firstOperand = compare->getOperand(0);
+  auto secondOperand = compare->getOperand(1);
+  if (  true
+        && ((trueValue != firstOperand) || (falseValue != secondOperand))
+        && ((trueValue != secondOperand) || (falseValue != firstOperand))
+    ){
+    return false;
+  }
+
+  /*
+   * Check that the comparison is an ordering one (e.g., not an equality).
+   */
+  switch (compare->getPredicate()){
+    case CmpInst::ICMP_SGT:
+    case CmpInst::ICMP_SGE:
+    case CmpInst::ICMP_SLT:
+    case CmpInst::ICMP_SLE:
+    case CmpInst::ICMP_UGT:
+    case CmpInst::ICMP_UGE:
+    case CmpInst::ICMP_ULT:
+    case CmpInst::ICMP_ULE:
+      return true;
+    case CmpInst::FCMP_OGT:
+    case CmpInst::FCMP_OGE:
+    case CmpInst::FCMP_OLT:
+    case CmpInst::FCMP_OLE:
+    case CmpInst::FCMP_UGT:
+    case CmpInst::FCMP_UGE:
+    case CmpInst::FCMP_ULT:
+    case CmpInst::FCMP_ULE:
+      return AccumulatorOpInfo::canReorderFloatingPointMinMax(selectInst, compare);
+    default:
+      return false;
+  }
+}
+
+bool AccumulatorOpInfo::canReorderFloatingPointMinMax (SelectInst *selectInst, CmpInst *compare) {
+
+  /*
+   * A floating point min/max written as a select is neither associative nor commutative when NaNs or signed zeros are compared (e.g., "m = (m > x) ? m : x" restarts from the value after a NaN).
+   * Hence, it can be reduced only if NaNs and signed zeros can be ignored (as LLVM does for its recurrences).
+   * This is stated either by the fast-math flags of the comparison (or the select) or by the attributes of the function.
+   */
+  auto hasFlags = [](Instruction *inst) -> bool {
+    if (!isa<FPMathOperator>(inst)){
+      return false;
+    }
+    return inst->hasNoNaNs() && inst->hasNoSignedZeros();
+  };
+  if (  false
+        || hasFlags(compare)
+        || hasFlags(selectInst)
+    ){
+    return true;
+  }
+  auto f = selectInst->getFunction();
+  if (  true
+        && (f != nullptr)
+        && (f->getFnAttribute("no-nans-fp-math").getValueAsString() == "true")
+        && (f->getFnAttribute("no-signed-zeros-fp-math").getValueAsString() == "true")
+    ){
+    return true;
+  }
+
+  return false;
+}
+
+bool AccumulatorOpInfo::isSameMinMax (Instruction *inst, Instruction *otherInst) {
+  if (  false
+        || (!AccumulatorOpInfo::isMinMax(inst))
+        || (!AccumulatorOpInfo::isMinMax(otherInst))
+    ){
+    return false;
+  }
+
+  /*
+   * Intrinsics differ in the way they handle NaNs.
+   */
+  auto intrinsic = dyn_cast<IntrinsicInst>(inst);
+  auto otherIntrinsic = dyn_cast<IntrinsicInst>(otherInst);
+  if (  true
+        && (intrinsic != nullptr)
+        && (otherIntrinsic != nullptr)
+    ){
+    return intrinsic->getIntrinsicID() == otherIntrinsic->getIntrinsicID();
+  }
+  if (  false
+        || (intrinsic != nullptr)
+        || (otherIntrinsic != nullptr)
+    ){
+    return false;
+  }
+
+  /*
+   * Both instructions are selects: they must agree on the direction (minimum or maximum), on the kind of values compared, and on the signedness.
+   */
+  auto predicate = AccumulatorOpInfo::getMinMaxPredicate(inst);
+  auto otherPredicate = AccumulatorOpInfo::getMinMaxPredicate(otherInst);
+  if (AccumulatorOpInfo::isMaxPredicate(predicate) != AccumulatorOpInfo::isMaxPredicate(otherPredicate)){
+    return false;
+  }
+  if (CmpInst::isFPPredicate(predicate) != CmpInst::isFPPredicate(otherPredicate)){
+    return false;
+  }
+  if (CmpInst::isFPPredicate(predicate)){
+    return true;
+  }
+
+  return CmpInst::isSigned(predicate) == CmpInst::isSigned(otherPredicate);
+}
+
+CmpInst::Predicate AccumulatorOpInfo::getMinMaxPredicate (Instruction *inst) {
+  assert(AccumulatorOpInfo::isMinMax(inst));
+
+  /*
+   * Intrinsics.
+   */
+  if (auto intrinsic = dyn_cast<IntrinsicInst>(inst)){
+    switch (intrinsic->getIntrinsicID()){
+      case Intrinsic::maxnum:
+      case Intrinsic::maximum:
+        return CmpInst::FCMP_OGT;
+      default:
+        return CmpInst::FCMP_OLT;
+    }
+  }
+
+  /*
+   * Selects.
+   * The predicate of the comparison needs to be swapped if the select picks the second operand of the comparison when the latter is true.
+   */
+  auto selectInst = cast<SelectInst>(inst);
+  auto compare = cast<CmpInst>(selectInst->getCondition());
+  auto predicate = compare->getPredicate();
+  if (selectInst->getTrueValue() == compare->getOperand(0)){
+    return predicate;
+  }
+
+  return CmpInst::getSwappedPredicate(predicate);
+}
+
+bool AccumulatorOpInfo::isMaxPredicate (CmpInst::Predicate predicate) {
+  switch (predicate){
+    case CmpInst::ICMP_SGT:
+    case CmpInst::ICMP_SGE:
+    case CmpInst::ICMP_UGT:
+    case CmpInst::ICMP_UGE:
+    case CmpInst::FCMP_OGT:
+    case CmpInst::FCMP_OGE:
+    case CmpInst::FCMP_UGT:
+    case CmpInst::FCMP_UGE:
+      return true;
+    default:
+      return false;
+  }
+}
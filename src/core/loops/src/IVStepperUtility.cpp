@@ -13,6 +13,18 @@
 using namespace llvm;
 using namespace llvm::noelle;
 
+CmpInst::Predicate IVUtility::fetchPredicateToContinue (LoopGoverningIVAttribution *attribution) {
+  auto cmpInst = attribution->getHeaderCmpInst();
+  auto exitsOnTrue = attribution->getHeaderBrInst()->getSuccessor(0) == attribution->getExitBlockFromHeader();
+  auto predicate = exitsOnTrue ? cmpInst->getInversePredicate() : cmpInst->getPredicate();
+  auto isIVLeftOperand = cmpInst->getOperand(0) == attribution->getIntermediateValueUsedInCompare();
+  if (!isIVLeftOperand){
+    predicate = CmpInst::getSwappedPredicate(predicate);
+  }
+
+  return predicate;
+}
+
 PHINode *IVUtility::createChunkPHI (BasicBlock *preheaderB, BasicBlock *headerB, Type *chunkPHIType, Value *chunkSize) {
 
   // TODO: Add asserts to ensure the basic blocks/terminators are well formed
@@ -118,6 +130,194 @@ Value *IVUtility::offsetIVPHI (
   return offsetStartValue;
 }
 
+bool IVUtility::canComputeTripCount (
+  LoopStructure *ls,
+  LoopGoverningIVAttribution *attribution
+) {
+
+  /*
+   * Fetch the loop governing induction variable.
+   */
+  if (attribution == nullptr){
+    return false;
+  }
+  auto &IV = attribution->getInductionVariable();
+
+  /*
+   * Fetch the step value.
+   * The loop governing IV attribution guarantees it is a constant integer.
+   */
+  auto stepValue = dyn_cast_or_null<ConstantInt>(IV.getSingleComputedStepValue());
+  if (  false
+        || (stepValue == nullptr)
+        || (stepValue->isZero())
+    ){
+    return false;
+  }
+
+  /*
+   * Fetch the start and the exit values of the induction variable.
+   */
+  auto startValue = IV.getStartValue();
+  auto exitValue = attribution->getHeaderCmpInstConditionValue();
+  if (  false
+        || (startValue == nullptr)
+        || (exitValue == nullptr)
+        || (!startValue->getType()->isIntegerTy())
+        || (!exitValue->getType()->isIntegerTy())
+    ){
+    return false;
+  }
+
+  /*
+   * Check that both values are available at the preheader.
+   */
+  auto isAvailableAtPreHeader = [ls](Value *v) -> bool {
+    if (auto inst = dyn_cast<Instruction>(v)){
+      return !ls->isIncluded(inst);
+    }
+    return true;
+  };
+  if (  false
+        || (!isAvailableAtPreHeader(startValue))
+        || (!isAvailableAtPreHeader(exitValue))
+    ){
+    return false;
+  }
+
+  /*
+   * The trip count is computed on 64 bits.
+   */
+  if (startValue->getType()->getIntegerBitWidth() > 64){
+    return false;
+  }
+
+  /*
+   * The predicate that keeps executing the loop must be consistent with the direction of the induction variable.
+   * Loops governed by "!=" are handled only if the induction variable cannot jump over the exit value.
+   */
+  auto isStepPositive = stepValue->getValue().isStrictlyPositive();
+  switch (fetchPredicateToContinue(attribution)){
+    case CmpInst::Predicate::ICMP_SLT:
+    case CmpInst::Predicate::ICMP_SLE:
+    case CmpInst::Predicate::ICMP_ULT:
+    case CmpInst::Predicate::ICMP_ULE:
+      return isStepPositive;
+
+    case CmpInst::Predicate::ICMP_SGT:
+    case CmpInst::Predicate::ICMP_SGE:
+    case CmpInst::Predicate::ICMP_UGT:
+    case CmpInst::Predicate::ICMP_UGE:
+      return !isStepPositive;
+
+    case CmpInst::Predicate::ICMP_NE:
+
+      /*
+       * If the header compares the updated value of the induction variable, a start value equal to the exit value runs the whole range of the type before exiting.
+       */
+      if (IVUtility::isUpdatedValueCompared(attribution)){
+        return false;
+      }
+      return stepValue->getValue().abs().isOneValue();
+
+    default:
+      return false;
+  }
+}
+
+Value *IVUtility::generateCodeToComputeTripCount (
+  LoopStructure *ls,
+  LoopGoverningIVAttribution *attribution,
+  IRBuilder<> &builder
+) {
+
+  /*
+   * Check if the trip count can be computed outside the loop.
+   */
+  if (!IVUtility::canComputeTripCount(ls, attribution)){
+    return nullptr;
+  }
+
+  /*
+   * Fetch the loop governing induction variable and its start, exit, and step values.
+   */
+  auto &IV = attribution->getInductionVariable();
+  auto stepValue = cast<ConstantInt>(IV.getSingleComputedStepValue());
+  auto startValue = IV.getStartValue();
+  auto exitValue = attribution->getHeaderCmpInstConditionValue();
+
+  /*
+   * Fetch the predicate that keeps executing the loop.
+   */
+  auto int64 = builder.getInt64Ty();
+  auto zero = ConstantInt::get(int64, 0);
+  auto one = ConstantInt::get(int64, 1);
+  auto predicate = fetchPredicateToContinue(attribution);
+  auto isStepPositive = stepValue->getValue().isStrictlyPositive();
+  auto lowValue = isStepPositive ? startValue : exitValue;
+  auto highValue = isStepPositive ? exitValue : startValue;
+
+  /*
+   * Loops governed by "!=" have a unit step, so they execute one iteration per value between the start and the exit values.
+   * This distance is computed in the type of the induction variable to handle wrapping.
+   */
+  if (predicate == CmpInst::Predicate::ICMP_NE){
+    auto distance = builder.CreateSub(highValue, lowValue);
+    return builder.CreateZExtOrTrunc(distance, int64);
+  }
+
+  /*
+   * Extend the values to 64 bits according to the signedness of the predicate.
+   * The distance between them is then an unsigned 64-bit value as long as the loop iterates.
+   */
+  auto isSigned = CmpInst::isSigned(predicate);
+  auto low64 = isSigned ? builder.CreateSExtOrTrunc(lowValue, int64) : builder.CreateZExtOrTrunc(lowValue, int64);
+  auto high64 = isSigned ? builder.CreateSExtOrTrunc(highValue, int64) : builder.CreateZExtOrTrunc(highValue, int64);
+  auto distance = builder.CreateSub(high64, low64);
+
+  /*
+   * Compute the number of iterations.
+   * Strict predicates (e.g., "<") execute ceil(distance / step) iterations, while inclusive ones (e.g., "<=") execute floor(distance / step) + 1 iterations.
+   */
+  auto absStepValue = ConstantInt::get(int64, stepValue->getValue().abs().getZExtValue());
+  auto quotient = builder.CreateUDiv(distance, absStepValue);
+  Value *tripCount = nullptr;
+  Value *doesNotIterate = nullptr;
+  auto isInclusive = false
+    || (predicate == CmpInst::Predicate::ICMP_SLE)
+    || (predicate == CmpInst::Predicate::ICMP_ULE)
+    || (predicate == CmpInst::Predicate::ICMP_SGE)
+    || (predicate == CmpInst::Predicate::ICMP_UGE);
+  if (isInclusive){
+    tripCount = builder.CreateAdd(quotient, one);
+    doesNotIterate = isSigned ? builder.CreateICmpSGT(low64, high64) : builder.CreateICmpUGT(low64, high64);
+  } else {
+    auto remainder = builder.CreateURem(distance, absStepValue);
+    auto hasRemainder = builder.CreateICmpNE(remainder, zero);
+    tripCount = builder.CreateAdd(quotient, builder.CreateZExt(hasRemainder, int64));
+    doesNotIterate = isSigned ? builder.CreateICmpSGE(low64, high64) : builder.CreateICmpUGE(low64, high64);
+  }
+
+  /*
+   * Loops whose start value already fails the predicate do not iterate.
+   * If the header compares the updated value of the induction variable, the first iteration runs before the predicate is evaluated.
+   * Hence, these loops execute one iteration.
+   */
+  auto minimumTripCount = IVUtility::isUpdatedValueCompared(attribution) ? one : zero;
+  tripCount = builder.CreateSelect(doesNotIterate, minimumTripCount, tripCount);
+
+  return tripCount;
+}
+
+bool IVUtility::isUpdatedValueCompared (
+  LoopGoverningIVAttribution *attribution
+) {
+  auto &IV = attribution->getInductionVariable();
+  auto comparedValue = attribution->getIntermediateValueUsedInCompare();
+
+  return comparedValue != IV.getLoopEntryPHI();
+}
+
 /*
  * LoopGoverningIVUtility implementation
  */
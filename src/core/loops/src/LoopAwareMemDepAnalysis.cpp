@@ -246,6 +246,70 @@ void refinePDGWithLIDS(
   }
 
 }
+
+void refinePDGWithDependenceDistances(
+  PDG *loopDG,
+  LoopStructure *loopStructure,
+  LoopsSummary *liSummary,
+  LoopIterationDomainSpaceAnalysis *LIDS,
+  ScalarEvolution &SE
+) {
+
+  auto dfr = computeReachabilityFromInstructions(loopStructure);
+
+  std::unordered_set<DGEdge<Value> *> edgesToRemove;
+  std::unordered_set<DGEdge<Value> *> edgesWithinIterations;
+  for (auto dependency : LoopCarriedDependencies::getLoopCarriedDependenciesForLoop(*loopStructure, *liSummary, *loopDG)) {
+
+    /*
+    * Only memory dependences between loads and stores have a distance that can be computed
+    */
+    if (!dependency->isMemoryDependence()) continue;
+
+    auto fromInst = dyn_cast<Instruction>(dependency->getOutgoingT());
+    auto toInst = dyn_cast<Instruction>(dependency->getIncomingT());
+    if (!fromInst || !toInst) continue;
+
+    auto distance = LIDS->getDependenceDistanceBetweenIterations(fromInst, toInst, SE);
+    if (!distance) continue;
+
+    /*
+    * The consumer accesses the memory location of a later instance of the producer
+    */
+    if (*distance > 0) {
+      dependency->setDependenceDistance(*distance);
+      continue;
+    }
+
+    /*
+    * The two instructions only access the same memory location within an iteration.
+    * The dependence exists only if the producer can reach the consumer within that iteration
+    */
+    auto &afterInstructions = dfr->OUT(fromInst);
+    if (  true
+          && (*distance == 0)
+          && (fromInst != toInst)
+          && (afterInstructions.find(toInst) != afterInstructions.end())
+      ){
+      edgesWithinIterations.insert(dependency);
+      continue;
+    }
+
+    /*
+    * The consumer never accesses the memory location after the producer
+    */
+    edgesToRemove.insert(dependency);
+  }
+
+  for (auto edge : edgesWithinIterations) {
+    edge->setLoopCarried(false);
+  }
+  for (auto edge : edgesToRemove) {
+    edge->setLoopCarried(false);
+    loopDG->removeEdge(edge);
+  }
+
+}
       
 NoelleSCAFIntegration::NoelleSCAFIntegration ()
   : ModulePass{ID}
@@ -45,4 +45,13 @@ namespace llvm::noelle {
     LoopIterationDomainSpaceAnalysis *LIDS
   );
 
+  // Attach the iteration distance to the loop-carried memory dependences of the loop PDG
+  void refinePDGWithDependenceDistances(
+    PDG *loopDG,
+    LoopStructure *loopStructure,
+    LoopsSummary *liSummary,
+    LoopIterationDomainSpaceAnalysis *LIDS,
+    ScalarEvolution &SE
+  );
+
 } // namespace llvm::noelle
@@ -75,6 +75,7 @@ LoopDependenceInfo::LoopDependenceInfo(
   std::unordered_set<LoopDependenceInfoOptimization> optimizations,
   bool enableLoopAwareDependenceAnalyses
 ) : DOALLChunkSize{8},
+    hasUserDefinedDOALLChunkSize{false},
     maximumNumberOfCoresForTheParallelization{maxCores},
     liSummary{l},
     enabledOptimizations{optimizations},
@@ -133,6 +134,7 @@ LoopDependenceInfo::LoopDependenceInfo(
 
 void LoopDependenceInfo::copyParallelizationOptionsFrom (LoopDependenceInfo *otherLDI) {
   this->DOALLChunkSize = otherLDI->DOALLChunkSize;
+  this->hasUserDefinedDOALLChunkSize = otherLDI->hasUserDefinedDOALLChunkSize;
   this->enabledTransformations = otherLDI->enabledTransformations;
   this->maximumNumberOfCoresForTheParallelization = otherLDI->maximumNumberOfCoresForTheParallelization;
   this->areLoopAwareAnalysesEnabled = otherLDI->areLoopAwareAnalysesEnabled;
@@ -221,13 +223,19 @@ std::pair<PDG *, SCCDAG *> LoopDependenceInfo::createDGsForLoop (
   auto domainSpace = LoopIterationDomainSpaceAnalysis(liSummary, ivManager, SE);
   if (this->areLoopAwareAnalysesEnabled){
     refinePDGWithLoopAwareMemDepAnalysis(loopDG, l, loopStructure, &liSummary, &domainSpace);
+    refinePDGWithDependenceDistances(loopDG, loopStructure, &liSummary, &domainSpace, SE);
   }
 
   /*
-   * Analyze the loop to identify opportunities of cloning stack objects.
+   * Use the memory dependences observed at run time (if they have been profiled) to identify the loop-carried memory dependences that never occur.
+   */
+  refinePDGWithMemoryDependenceProfiles(loopDG);
+
+  /*
+   * Analyze the loop to identify opportunities of cloning stack and heap objects.
    */
   if (enabledOptimizations.find(LoopDependenceInfoOptimization::MEMORY_CLONING_ID) != enabledOptimizations.end()) {
-    removeUnnecessaryDependenciesThatCloningMemoryNegates(loopDG, DS);
+    removeUnnecessaryDependenciesThatCloningMemoryNegates(loopDG, DS, SE);
   }
 
   /*
@@ -268,7 +276,8 @@ std::pair<PDG *, SCCDAG *> LoopDependenceInfo::createDGsForLoop (
 
 void LoopDependenceInfo::removeUnnecessaryDependenciesThatCloningMemoryNegates (
   PDG *loopInternalDG,
-  DominatorSummary &DS
+  DominatorSummary &DS,
+  ScalarEvolution &SE
 ) {
 
   /*
@@ -279,7 +288,7 @@ void LoopDependenceInfo::removeUnnecessaryDependenciesThatCloningMemoryNegates (
   /*
    * Create the memory cloning analyzer.
    */
-  this->memoryCloningAnalysis = new MemoryCloningAnalysis(rootLoop, DS, loopInternalDG);
+  this->memoryCloningAnalysis = new MemoryCloningAnalysis(rootLoop, DS, SE, loopInternalDG);
 
   /*
    * Identify opportunities for cloning stack locations.
@@ -336,6 +345,138 @@ void LoopDependenceInfo::removeUnnecessaryDependenciesThatCloningMemoryNegates (
   }
 }
  
+void LoopDependenceInfo::refinePDGWithMemoryDependenceProfiles (
+  PDG *loopDG
+) {
+
+  /*
+   * The memory dependence profiles are embedded (by LoopProfilesEmbedder) into the terminator of the header of the loop.
+   */
+  auto rootLoop = liSummary.getLoopNestingTreeRoot();
+  auto headerTerminator = rootLoop->getHeader()->getTerminator();
+  auto readProfile = [headerTerminator](const std::string &kind) -> std::map<uint64_t, uint64_t> {
+    std::map<uint64_t, uint64_t> profile;
+    auto profileMetadata = headerTerminator->getMetadata("noelle.prof.loop_" + kind);
+    if (profileMetadata == nullptr){
+      return profile;
+    }
+    for (auto i = 0; (i + 1) < profileMetadata->getNumOperands(); i += 2){
+      auto bucket = mdconst::extract<ConstantInt>(profileMetadata->getOperand(i))->getZExtValue();
+      auto count = mdconst::extract<ConstantInt>(profileMetadata->getOperand(i + 1))->getZExtValue();
+      profile[bucket] += count;
+    }
+    return profile;
+  };
+  auto iterationsProfile = readProfile("memiters");
+  if (iterationsProfile[0] == 0){
+    return ;
+  }
+  double iterations = (double)iterationsProfile[0];
+  auto instructionsProfile = readProfile("meminsts");
+  auto dependencesProfile = readProfile("memdeps");
+
+  /*
+   * Map the instructions of the loop to their IDs.
+   * The profiled instructions are identified by the IDs of their nodes in the embedded PDG.
+   */
+  std::unordered_map<Instruction *, uint64_t> instIDs;
+  std::unordered_map<uint64_t, Instruction *> instsByID;
+  for (auto inst : rootLoop->getInstructions()){
+    auto idMetadata = inst->getMetadata("noelle.pdg.inst.id");
+    if (idMetadata == nullptr){
+      continue ;
+    }
+    auto id = mdconst::extract<ConstantInt>(idMetadata->getOperand(0))->getZExtValue();
+    instIDs[inst] = id;
+    instsByID[id] = inst;
+  }
+
+  /*
+   * Check that the profile matches the code of the loop.
+   * Every profiled instruction is encoded as (ID << 1) | isStore, so it must still be a load or a store with that ID.
+   * Profiles that do not match (e.g., the code changed after profiling) are dropped.
+   */
+  std::unordered_map<uint64_t, uint64_t> executionsByID;
+  for (auto &pair : instructionsProfile){
+    auto id = pair.first >> 1;
+    auto isStore = (pair.first & 1) == 1;
+    if (  false
+          || (instsByID.find(id) == instsByID.end())
+          || (isStore && !isa<StoreInst>(instsByID[id]))
+          || (!isStore && !isa<LoadInst>(instsByID[id]))
+      ){
+      return ;
+    }
+    executionsByID[id] += pair.second;
+  }
+
+  /*
+   * Compute the number of times each pair of instructions has been found dependent across iterations.
+   * Every dependence is encoded as (source ID << 40) | (destination ID << 16) | iteration distance.
+   */
+  std::map<std::pair<uint64_t, uint64_t>, uint64_t> observedDependences;
+  for (auto &pair : dependencesProfile){
+    auto srcID = pair.first >> 40;
+    auto dstID = (pair.first >> 16) & 0xFFFFFF;
+    if (  false
+          || (executionsByID.find(srcID) == executionsByID.end())
+          || (executionsByID.find(dstID) == executionsByID.end())
+      ){
+      return ;
+    }
+    observedDependences[std::make_pair(srcID, dstID)] += pair.second;
+  }
+
+  /*
+   * Attach the observed frequencies to the loop-carried memory dependences of the loop.
+   */
+  for (auto edge : LoopCarriedDependencies::getLoopCarriedDependenciesForLoop(*rootLoop, liSummary, *loopDG)) {
+    if (!edge->isMemoryDependence()) {
+      continue;
+    }
+
+    /*
+     * Only dependences between loads and stores that have been executed while profiling are considered.
+     * Other instructions (e.g., calls) have not been profiled.
+     */
+    auto producer = dyn_cast<Instruction>(edge->getOutgoingT());
+    auto consumer = dyn_cast<Instruction>(edge->getIncomingT());
+    if (  false
+          || (producer == nullptr)
+          || (consumer == nullptr)
+          || (!isa<LoadInst>(producer) && !isa<StoreInst>(producer))
+          || (!isa<LoadInst>(consumer) && !isa<StoreInst>(consumer))
+          || (instIDs.find(producer) == instIDs.end())
+          || (instIDs.find(consumer) == instIDs.end())
+      ){
+      continue;
+    }
+    auto producerID = instIDs[producer];
+    auto consumerID = instIDs[consumer];
+    if (  false
+          || (executionsByID[producerID] == 0)
+          || (executionsByID[consumerID] == 0)
+      ){
+      continue;
+    }
+
+    /*
+     * Attach the frequency.
+     */
+    auto occurrences = observedDependences[std::make_pair(producerID, consumerID)];
+    edge->setProfiledFrequency(((double)occurrences) / iterations);
+
+    /*
+     * Dependences that never occurred can be removed by speculative techniques.
+     */
+    if (occurrences == 0){
+      edge->setRemovable(true);
+    }
+  }
+
+  return ;
+}
+
 bool LoopDependenceInfo::isTransformationEnabled (Transformation transformation){
   auto exist = this->enabledTransformations.find(transformation) != this->enabledTransformations.end();
 
@@ -435,6 +576,12 @@ uint32_t LoopDependenceInfo::getMaximumNumberOfCores (void) const {
   return this->maximumNumberOfCoresForTheParallelization;
 }
 
+void LoopDependenceInfo::setMaximumNumberOfCores (uint32_t maxCores) {
+  this->maximumNumberOfCoresForTheParallelization = maxCores;
+
+  return ;
+}
+
 InvariantManager * LoopDependenceInfo::getInvariantManager (void) const {
   return this->invariantManager;
 }
@@ -67,6 +67,122 @@ bool LoopIterationDomainSpaceAnalysis::areInstructionsAccessingDisjointMemoryLoc
   return (accessSpaceI == accessSpaceJ) || isMemoryAccessSpaceEquivalentForTopLoopIVSubscript(accessSpaceI, accessSpaceJ);
 }
 
+int64_t LoopIterationDomainSpaceAnalysis::getStrideOfMemoryAccessBetweenIterations (
+  Instruction *memoryAccess
+) const {
+  if (accessSpaceByInstruction.find(memoryAccess) == accessSpaceByInstruction.end()) {
+    return 0;
+  }
+  auto accessSpace = accessSpaceByInstruction.at(memoryAccess);
+
+  /*
+   * Skip the evolutions of the sub-loops to reach the one of the outermost loop
+   */
+  auto rootLoopStructure = loops.getLoopNestingTreeRoot();
+  auto scev = accessSpace->memoryAccessorSCEV;
+  while (auto addRec = dyn_cast_or_null<SCEVAddRecExpr>(scev)) {
+    if (addRec->getLoop()->getHeader() != rootLoopStructure->getHeader()) {
+      scev = addRec->getStart();
+      continue;
+    }
+
+    /*
+     * The stride is the step of the evolution of the accessed address
+     */
+    if (!addRec->isAffine()) return 0;
+    auto step = dyn_cast<SCEVConstant>(addRec->getOperand(1));
+    if (!step) return 0;
+    return step->getAPInt().getSExtValue();
+  }
+
+  /*
+   * The address does not evolve with the outermost loop
+   */
+  return 0;
+}
+
+std::optional<int64_t> LoopIterationDomainSpaceAnalysis::getDependenceDistanceBetweenIterations (
+  Instruction *from,
+  Instruction *to,
+  ScalarEvolution &SE
+) const {
+
+  /*
+   * Fetch the memory locations accessed.
+   */
+  if (  false
+        || (!isa<LoadInst>(from) && !isa<StoreInst>(from))
+        || (!isa<LoadInst>(to) && !isa<StoreInst>(to))
+        || (accessSpaceByInstruction.find(from) == accessSpaceByInstruction.end())
+        || (accessSpaceByInstruction.find(to) == accessSpaceByInstruction.end())
+    ){
+    return std::nullopt;
+  }
+  auto fromSCEV = dyn_cast_or_null<SCEVAddRecExpr>(accessSpaceByInstruction.at(from)->memoryAccessorSCEV);
+  auto toSCEV = dyn_cast_or_null<SCEVAddRecExpr>(accessSpaceByInstruction.at(to)->memoryAccessorSCEV);
+  if (!fromSCEV || !toSCEV) {
+    return std::nullopt;
+  }
+
+  /*
+   * Both addresses must evolve linearly with the outermost loop only.
+   */
+  auto rootLoopStructure = loops.getLoopNestingTreeRoot();
+  for (auto addRec : { fromSCEV, toSCEV }) {
+    if (  false
+          || (addRec->getLoop()->getHeader() != rootLoopStructure->getHeader())
+          || (!addRec->isAffine())
+          || (!isa<SCEVConstant>(addRec->getOperand(1)))
+      ){
+      return std::nullopt;
+    }
+  }
+  auto fromStride = cast<SCEVConstant>(fromSCEV->getOperand(1))->getAPInt().getSExtValue();
+  auto toStride = cast<SCEVConstant>(toSCEV->getOperand(1))->getAPInt().getSExtValue();
+  if (  false
+        || (fromStride != toStride)
+        || (fromStride == 0)
+    ){
+    return std::nullopt;
+  }
+
+  /*
+   * The two instructions must access elements of the same size, and consecutive iterations must access different elements.
+   */
+  auto &DL = from->getModule()->getDataLayout();
+  auto fetchAccessedType = [](Instruction *memoryAccess) -> Type * {
+    if (auto store = dyn_cast<StoreInst>(memoryAccess)) {
+      return store->getValueOperand()->getType();
+    }
+    return memoryAccess->getType();
+  };
+  auto fromSize = (int64_t)DL.getTypeStoreSize(fetchAccessedType(from));
+  auto toSize = (int64_t)DL.getTypeStoreSize(fetchAccessedType(to));
+  if (  false
+        || (fromSize != toSize)
+        || (std::abs(fromStride) < fromSize)
+    ){
+    return std::nullopt;
+  }
+
+  /*
+   * The addresses must start a constant number of bytes apart, and this number must be a multiple of the stride.
+   */
+  auto startDifference = dyn_cast<SCEVConstant>(SE.getMinusSCEV(fromSCEV->getStart(), toSCEV->getStart()));
+  if (!startDifference) {
+    return std::nullopt;
+  }
+  auto bytes = startDifference->getAPInt().getSExtValue();
+  if ((bytes % fromStride) != 0) {
+    return std::nullopt;
+  }
+
+  /*
+   * Iteration j of @to accesses the location accessed by iteration i of @from when j - i = (start of @from - start of @to) / stride.
+   */
+  return bytes / fromStride;
+}
+
 bool LoopIterationDomainSpaceAnalysis::isMemoryAccessSpaceEquivalentForTopLoopIVSubscript (
   MemoryAccessSpace *space1,
   MemoryAccessSpace *space2
@@ -16,6 +16,7 @@ using namespace llvm::noelle;
 MemoryCloningAnalysis::MemoryCloningAnalysis (
     LoopStructure *loop, 
     DominatorSummary &DS,
+    ScalarEvolution &SE,
     PDG *ldg
     ){ 
   assert(loop != nullptr);
@@ -81,6 +82,49 @@ MemoryCloningAnalysis::MemoryCloningAnalysis (
     this->clonableMemoryLocations.insert(std::move(location));
   }
 
+  /*
+   * Collect the heap objects allocated before the loop (e.g., scratch buffers allocated once and reused by every iteration).
+   */
+  for (auto &B : *function) {
+
+    /*
+     * The allocation must be executed before the loop starts.
+     */
+    if (loop->isIncluded(&B)) {
+      continue;
+    }
+    if (!DS.DT.dominates(&B, loop->getHeader())) {
+      continue;
+    }
+
+    for (auto &I : B) {
+
+      /*
+       * Check if the current instruction allocates a heap object.
+       */
+      auto call = dyn_cast<CallInst>(&I);
+      if (  false
+            || (call == nullptr)
+            || (!ClonableMemoryLocation::isHeapAllocationCall(call))
+        ){
+        continue;
+      }
+
+      /*
+       * Check if the heap object is clonable.
+       */
+      auto location = std::make_unique<ClonableMemoryLocation>(call, loop, DS, SE);
+      if (!location->isClonableLocation()) {
+        continue;
+      }
+
+      /*
+       * The heap object is clonable.
+       */
+      this->clonableMemoryLocations.insert(std::move(location));
+    }
+  }
+
   return ;
 }
 
@@ -199,6 +243,7 @@ ClonableMemoryLocation::ClonableMemoryLocation (
     ,loop{loop}
     ,isClonable{false}
     ,isScopeWithinLoop{false}
+    ,isHeap{false}
 {
 
   /*
@@ -250,6 +295,57 @@ ClonableMemoryLocation::ClonableMemoryLocation (
   return;
 }
 
+ClonableMemoryLocation::ClonableMemoryLocation (
+  CallInst *allocation,
+  LoopStructure *loop,
+  DominatorSummary &DS,
+  ScalarEvolution &SE
+) : allocation{allocation}
+    ,allocatedType{nullptr}
+    ,sizeInBits{0}
+    ,loop{loop}
+    ,isClonable{false}
+    ,isScopeWithinLoop{false}
+    ,isHeap{true}
+{
+  assert(ClonableMemoryLocation::isHeapAllocationCall(allocation));
+
+  /*
+   * Identify the instructions that access the heap object.
+   */
+  if (!this->identifyStoresAndOtherUsers(loop, DS)) {
+    return;
+  }
+
+  /*
+   * Instructions of the loop can only access the heap object through loads, stores, and memory intrinsics.
+   * Other users (e.g., calls) could access the object in ways we cannot track.
+   */
+  for (auto inst : this->nonStoringInstructions) {
+    if (!loop->isIncluded(inst)) {
+      continue;
+    }
+    if (!isa<MemIntrinsic>(inst)) {
+      return;
+    }
+  }
+
+  /*
+   * Every iteration of the loop must fully overwrite the heap object before reading it.
+   * In other words, there is no RAW data dependence that involves this heap object and that crosses iterations or that reaches the loop from outside.
+   */
+  if (!this->isFullyOverwrittenBeforeBeingRead(loop, DS, SE)) {
+    return;
+  }
+
+  /*
+   * The location is clonable.
+   */
+  this->isClonable = true;
+
+  return;
+}
+
 void ClonableMemoryLocation::setObjectScope (
   AllocaInst *allocation,
   LoopStructure *loop,
@@ -294,10 +390,32 @@ void ClonableMemoryLocation::setObjectScope (
   return ;
 }
 
-AllocaInst * ClonableMemoryLocation::getAllocation (void) const {
+Instruction * ClonableMemoryLocation::getAllocation (void) const {
   return this->allocation;
 }
 
+bool ClonableMemoryLocation::isHeapObject (void) const {
+  return this->isHeap;
+}
+
+Value * ClonableMemoryLocation::generateCodeToComputeSizeInBytes (IRBuilder<> &builder) const {
+  assert(this->isHeap);
+
+  /*
+   * calloc(numberOfElements, sizeOfElement)
+   */
+  auto call = cast<CallInst>(this->allocation);
+  auto callee = call->getCalledFunction();
+  if (callee->getName() == "calloc"){
+    return builder.CreateMul(call->getArgOperand(0), call->getArgOperand(1));
+  }
+
+  /*
+   * malloc(size), new(size), and new[](size)
+   */
+  return call->getArgOperand(0);
+}
+
 bool ClonableMemoryLocation::isClonableLocation (void) const {
   return this->isClonable;
 }
@@ -326,6 +444,40 @@ bool ClonableMemoryLocation::isMemCpyInstrinsicCall (CallInst *call) {
   return nameString.find("llvm.memcpy") != std::string::npos;
 }
 
+bool ClonableMemoryLocation::isHeapAllocationCall (CallInst *call) {
+  auto callee = call->getCalledFunction();
+  if (  false
+        || (callee == nullptr)
+        || (!callee->isDeclaration())
+    ){
+    return false;
+  }
+  auto name = callee->getName();
+  return false
+         || (name == "malloc")
+         || (name == "calloc")
+         || (name == "_Znwm")
+         || (name == "_Znam")
+         ;
+}
+
+bool ClonableMemoryLocation::isHeapDeallocationCall (CallInst *call) {
+  auto callee = call->getCalledFunction();
+  if (  false
+        || (callee == nullptr)
+        || (!callee->isDeclaration())
+    ){
+    return false;
+  }
+  auto name = callee->getName();
+  return false
+         || (name == "free")
+         || (name == "_ZdlPv")
+         || (name == "_ZdaPv")
+         || (name == "_ZdlPvm")
+         ;
+}
+
 bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, DominatorSummary &DS) {
 
   /*
@@ -372,6 +524,13 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
       } 
       if (auto store = dyn_cast<StoreInst>(user)) {
 
+        /*
+         * Storing the pointer to the object into memory lets other code access the object.
+         */
+        if (store->getValueOperand() == I) {
+          return false;
+        }
+
         /*
          * As straightforward as it gets
          */
@@ -395,11 +554,23 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
         }
 
         /*
-         * We consider llvm.memcpy as a storing instruction if the use is the dest (first operand) 
+         * Heap objects can be released after the loop.
+         * The release does not read the content of the object.
+         */
+        if (  true
+              && this->isHeap
+              && ClonableMemoryLocation::isHeapDeallocationCall(call)
+              && (!loop->isIncluded(call))
+          ){
+          continue;
+        }
+
+        /*
+         * We consider llvm.memcpy and llvm.memset as storing instructions if the use is the dest (first operand) 
          */
-        auto isMemCpy = ClonableMemoryLocation::isMemCpyInstrinsicCall(call);
+        auto isMemCpyOrMemSet = ClonableMemoryLocation::isMemCpyInstrinsicCall(call) || isa<MemSetInst>(call);
         auto isUseTheDestinationOp = (call->getNumArgOperands() == 4) && (call->getArgOperand(0) == I);
-        if (isMemCpy && isUseTheDestinationOp) {
+        if (isMemCpyOrMemSet && isUseTheDestinationOp) {
           storingInstructions.insert(call);
         } else {
           this->nonStoringInstructions.insert(call);
@@ -447,7 +618,7 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
 
 bool ClonableMemoryLocation::isThereRAWThroughMemoryFromOutsideLoop (
   LoopStructure *loop, 
-  AllocaInst *al, 
+  Instruction *al, 
   PDG *ldg, 
   std::unordered_set<Instruction *> insts
   ) const {
@@ -517,7 +688,7 @@ bool ClonableMemoryLocation::isThereRAWThroughMemoryFromOutsideLoop (
   return false;
 }
         
-bool ClonableMemoryLocation::isThereRAWThroughMemoryFromOutsideLoop (LoopStructure *loop, AllocaInst *al, PDG *ldg) const {
+bool ClonableMemoryLocation::isThereRAWThroughMemoryFromOutsideLoop (LoopStructure *loop, Instruction *al, PDG *ldg) const {
 
   /*
    * Check every read of the stack object.
@@ -678,7 +849,7 @@ bool ClonableMemoryLocation::isOverrideSetFullyCoveringTheAllocationSpace (
       }
 
     } else if (auto call = dyn_cast<CallInst>(storingInstruction)) {
-      assert(ClonableMemoryLocation::isMemCpyInstrinsicCall(call));
+      assert(isa<MemIntrinsic>(call));
 
       // call->print(errs() << "Examining llvm.memcpy call: "); errs() << "\n";
 
@@ -694,7 +865,7 @@ bool ClonableMemoryLocation::isOverrideSetFullyCoveringTheAllocationSpace (
     }
   }
 
-  if (this->allocation->getAllocatedType()->isStructTy()) {
+  if (this->allocatedType->isStructTy()) {
 
     // errs() << "Number of elements covered: " << structElementsStoredTo.size()
       // << " versus struct element number: " << this->allocatedType->getStructNumElements() << "\n";
@@ -704,3 +875,232 @@ bool ClonableMemoryLocation::isOverrideSetFullyCoveringTheAllocationSpace (
 
   return false;
 }
+
+bool ClonableMemoryLocation::isFullyOverwrittenBeforeBeingRead (
+  LoopStructure *loop,
+  DominatorSummary &DS,
+  ScalarEvolution &SE
+) const {
+
+  /*
+   * Fetch the instructions of the loop that read the object.
+   */
+  std::unordered_set<Instruction *> readers{};
+  for (auto inst : this->loadInstructions) {
+    if (loop->isIncluded(inst)) {
+      readers.insert(inst);
+    }
+  }
+  for (auto inst : this->nonStoringInstructions) {
+    if (loop->isIncluded(inst)) {
+      readers.insert(inst);
+    }
+  }
+
+  /*
+   * Identify the storing instructions of the loop that overwrite the whole object.
+   * For each of them, fetch the basic block from which the object is known to be fully overwritten.
+   */
+  std::unordered_map<Instruction *, BasicBlock *> fullOverwrites{};
+  for (auto storingInstruction : this->storingInstructions) {
+    if (!loop->isIncluded(storingInstruction)) {
+      continue;
+    }
+    auto block = this->getBlockAfterFullOverwrite(storingInstruction, loop, DS, SE);
+    if (block != nullptr) {
+      fullOverwrites[storingInstruction] = block;
+    }
+  }
+
+  /*
+   * Check that every read is preceded by a full overwrite of the object within the same iteration.
+   *
+   * Both the overwrite and the read are within the loop.
+   * Hence, if the former dominates the latter, then the former is executed first in every iteration that executes the latter.
+   */
+  auto isBefore = [](Instruction *first, Instruction *second) -> bool {
+    for (auto &I : *first->getParent()) {
+      if (&I == first) {
+        return true;
+      }
+      if (&I == second) {
+        return false;
+      }
+    }
+    return false;
+  };
+  for (auto reader : readers) {
+    auto readerBlock = reader->getParent();
+    auto isCovered = false;
+    for (auto overwrite : fullOverwrites) {
+      auto storingInstruction = overwrite.first;
+      auto block = overwrite.second;
+      if (!DS.DT.dominates(block, readerBlock)) {
+        continue;
+      }
+      if (  true
+            && (storingInstruction->getParent() == readerBlock)
+            && (!isBefore(storingInstruction, reader))
+        ){
+        continue;
+      }
+      isCovered = true;
+      break;
+    }
+    if (!isCovered) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+BasicBlock * ClonableMemoryLocation::getBlockAfterFullOverwrite (
+  Instruction *storingInstruction,
+  LoopStructure *loop,
+  DominatorSummary &DS,
+  ScalarEvolution &SE
+) const {
+
+  /*
+   * Fetch the size of the object.
+   */
+  auto sizeSCEV = this->getSizeInBytesSCEV(SE);
+  auto sizeType = sizeSCEV->getType();
+  auto isTheSizeOfTheObject = [&SE, sizeSCEV, sizeType](const SCEV *bytes) -> bool {
+    if (bytes->getType() == sizeType) {
+      return bytes == sizeSCEV;
+    }
+    if (  false
+          || (!bytes->getType()->isIntegerTy())
+          || (SE.getTypeSizeInBits(bytes->getType()) > SE.getTypeSizeInBits(sizeType))
+      ){
+      return false;
+    }
+    return false
+           || (SE.getZeroExtendExpr(bytes, sizeType) == sizeSCEV)
+           || (SE.getSignExtendExpr(bytes, sizeType) == sizeSCEV)
+           ;
+  };
+
+  /*
+   * Case 1: llvm.memset or llvm.memcpy that starts from the beginning of the object and that writes its whole size.
+   */
+  if (auto memIntrinsic = dyn_cast<MemIntrinsic>(storingInstruction)) {
+    if (memIntrinsic->getRawDest()->stripPointerCasts() != this->allocation) {
+      return nullptr;
+    }
+    if (!isTheSizeOfTheObject(SE.getSCEV(memIntrinsic->getLength()))) {
+      return nullptr;
+    }
+    return memIntrinsic->getParent();
+  }
+
+  /*
+   * Only stores are left.
+   */
+  auto store = dyn_cast<StoreInst>(storingInstruction);
+  if (store == nullptr) {
+    return nullptr;
+  }
+  auto &DL = store->getModule()->getDataLayout();
+  auto storeSize = DL.getTypeStoreSize(store->getValueOperand()->getType());
+  auto pointer = store->getPointerOperand();
+
+  /*
+   * Case 2: a single store that writes the whole object.
+   */
+  if (pointer->stripPointerCasts() == this->allocation) {
+    if (!isTheSizeOfTheObject(SE.getConstant(sizeType, storeSize))) {
+      return nullptr;
+    }
+    return store->getParent();
+  }
+
+  /*
+   * Case 3: a store of an inner loop that writes the object contiguously from its beginning to its end (e.g., for (j=0; j < N; j++) tmp[j] = ...).
+   *
+   * Check the pointer is {object,+,sizeOfTheStore} of the inner loop.
+   */
+  auto pointerSCEV = dyn_cast<SCEVAddRecExpr>(SE.getSCEV(pointer));
+  if (  false
+        || (pointerSCEV == nullptr)
+        || (!pointerSCEV->isAffine())
+        || (pointerSCEV->getStart() != SE.getSCEV(this->allocation))
+    ){
+    return nullptr;
+  }
+  auto stepSCEV = dyn_cast<SCEVConstant>(pointerSCEV->getStepRecurrence(SE));
+  if (  false
+        || (stepSCEV == nullptr)
+        || (stepSCEV->getAPInt().getSExtValue() != static_cast<int64_t>(storeSize))
+    ){
+    return nullptr;
+  }
+
+  /*
+   * The recurrence must be of an inner loop of @loop.
+   */
+  auto innerLoop = pointerSCEV->getLoop();
+  auto innerHeader = innerLoop->getHeader();
+  if (  false
+        || (innerHeader == loop->getHeader())
+        || (!loop->isIncluded(innerHeader))
+    ){
+    return nullptr;
+  }
+
+  /*
+   * The store must be executed by every iteration of the inner loop.
+   */
+  auto latch = innerLoop->getLoopLatch();
+  auto exitBlock = innerLoop->getExitBlock();
+  if (  false
+        || (latch == nullptr)
+        || (exitBlock == nullptr)
+        || (innerLoop->getExitingBlock() != latch)
+        || (!DS.DT.dominates(store->getParent(), latch))
+    ){
+    return nullptr;
+  }
+
+  /*
+   * The iterations of the inner loop must cover the whole object.
+   */
+  auto backedgeTakenCount = SE.getBackedgeTakenCount(innerLoop);
+  if (isa<SCEVCouldNotCompute>(backedgeTakenCount)) {
+    return nullptr;
+  }
+  if (SE.getTypeSizeInBits(backedgeTakenCount->getType()) > SE.getTypeSizeInBits(sizeType)) {
+    return nullptr;
+  }
+  auto isCoveringTheObject = false;
+  for (auto extendedBackedgeTakenCount : { SE.getZeroExtendExpr(backedgeTakenCount, sizeType), SE.getSignExtendExpr(backedgeTakenCount, sizeType) }) {
+    auto tripCount = SE.getAddExpr(extendedBackedgeTakenCount, SE.getOne(sizeType));
+    auto bytesStored = SE.getMulExpr(tripCount, SE.getConstant(sizeType, storeSize));
+    if (isTheSizeOfTheObject(bytesStored)) {
+      isCoveringTheObject = true;
+      break;
+    }
+  }
+  if (!isCoveringTheObject) {
+    return nullptr;
+  }
+
+  /*
+   * The object has been fully overwritten when the inner loop exits.
+   */
+  return exitBlock;
+}
+
+const SCEV * ClonableMemoryLocation::getSizeInBytesSCEV (ScalarEvolution &SE) const {
+  assert(this->isHeap);
+
+  auto call = cast<CallInst>(this->allocation);
+  auto sizeSCEV = SE.getSCEV(call->getArgOperand(0));
+  if (call->getCalledFunction()->getName() == "calloc"){
+    sizeSCEV = SE.getMulExpr(sizeSCEV, SE.getSCEV(call->getArgOperand(1)));
+  }
+
+  return sizeSCEV;
+}
@@ -0,0 +1,532 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "MemoryReductionAnalysis.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+MemoryReductionAnalysis::MemoryReductionAnalysis (
+    LoopStructure *loop,
+    PDG *ldg,
+    AccumulatorOpInfo &opInfo,
+    bool enableFloatAsReal
+    ){
+  assert(loop != nullptr);
+  assert(ldg != nullptr);
+
+  /*
+   * Collect the loop-invariant pointers used to store to memory within the loop.
+   */
+  std::set<Value *> pointers;
+  for (auto inst : loop->getInstructions()){
+    auto storeInst = dyn_cast<StoreInst>(inst);
+    if (storeInst == nullptr){
+      continue ;
+    }
+
+    /*
+     * Fetch the pointer the address of the store has been computed from.
+     */
+    auto pointer = storeInst->getPointerOperand();
+    if (auto gep = dyn_cast<GetElementPtrInst>(pointer)){
+      if (loop->isIncluded(gep)){
+        pointer = gep->getPointerOperand();
+      }
+    }
+
+    /*
+     * The pointer must be defined outside the loop.
+     */
+    auto pointerInst = dyn_cast<Instruction>(pointer);
+    if (  false
+          || (pointerInst == nullptr)
+          || loop->isIncluded(pointerInst)
+      ){
+      continue ;
+    }
+
+    pointers.insert(pointer);
+  }
+
+  /*
+   * Check which object pointed by them can be reduced.
+   */
+  for (auto pointer : pointers){
+    auto location = std::make_unique<ReducibleMemoryLocation>(pointer, loop, ldg, opInfo, enableFloatAsReal);
+    if (!location->isReducibleLocation()){
+      continue ;
+    }
+
+    /*
+     * The object can be reduced.
+     */
+    this->reducibleMemoryLocations.insert(std::move(location));
+  }
+
+  return ;
+}
+
+const ReducibleMemoryLocation * MemoryReductionAnalysis::getReducibleMemoryLocationFor (Instruction *I) const {
+  for (auto &location : this->reducibleMemoryLocations) {
+    if (  false
+          || location->isInstructionLoadingLocation(I)
+          || location->isInstructionStoringLocation(I)
+          || location->isInstructionAccumulatingLocation(I)
+      ){
+      return location.get();
+    }
+  }
+
+  return nullptr;
+}
+
+std::unordered_set<ReducibleMemoryLocation *> MemoryReductionAnalysis::getReducibleMemoryLocations (void) const {
+  std::unordered_set<ReducibleMemoryLocation *> locations;
+  for (auto &location : this->reducibleMemoryLocations) {
+    locations.insert(location.get());
+  }
+
+  return locations;
+}
+
+ReducibleMemoryLocation::ReducibleMemoryLocation (
+  Value *pointer,
+  LoopStructure *loop,
+  PDG *ldg,
+  AccumulatorOpInfo &opInfo,
+  bool enableFloatAsReal
+  ) : pointer{pointer}, allocation{nullptr}, elementType{nullptr}, accumulator{nullptr}, isReducible{false} {
+
+  /*
+   * The size of the object must be known before the loop starts.
+   */
+  if (!this->identifyAllocationAndSize()){
+    return ;
+  }
+
+  /*
+   * The loop must only update the object with the same commutative and associative operation.
+   */
+  if (!this->identifyUpdates(loop, opInfo, enableFloatAsReal)){
+    return ;
+  }
+
+  /*
+   * No other instruction of the loop can access the object.
+   */
+  if (this->isThereAnotherMemoryDependence(loop, ldg)){
+    return ;
+  }
+
+  this->isReducible = true;
+
+  return ;
+}
+
+bool ReducibleMemoryLocation::identifyAllocationAndSize (void) {
+  auto int64 = IntegerType::get(this->pointer->getContext(), 64);
+
+  /*
+   * Stack objects.
+   * Their size is either known at compile time or given by the number of elements allocated (e.g., variable-length arrays).
+   */
+  auto object = this->pointer->stripPointerCasts();
+  if (auto alloca = dyn_cast<AllocaInst>(object)){
+    auto &DL = alloca->getModule()->getDataLayout();
+    this->allocation = alloca;
+    this->sizeFactors.push_back(ConstantInt::get(int64, DL.getTypeAllocSize(alloca->getAllocatedType())));
+    if (alloca->isArrayAllocation()){
+      this->sizeFactors.push_back(alloca->getArraySize());
+    }
+    return true;
+  }
+
+  /*
+   * Heap objects.
+   * Their size is given by the arguments of the allocator.
+   */
+  auto callInst = dyn_cast<CallInst>(object);
+  if (callInst == nullptr){
+    return false;
+  }
+  auto callee = callInst->getCalledFunction();
+  if (callee == nullptr){
+    return false;
+  }
+  if (callee->getName() == "malloc"){
+    this->allocation = callInst;
+    this->sizeFactors.push_back(callInst->getArgOperand(0));
+    return true;
+  }
+  if (callee->getName() == "calloc"){
+    this->allocation = callInst;
+    this->sizeFactors.push_back(callInst->getArgOperand(0));
+    this->sizeFactors.push_back(callInst->getArgOperand(1));
+    return true;
+  }
+
+  return false;
+}
+
+bool ReducibleMemoryLocation::identifyUpdates (
+  LoopStructure *loop,
+  AccumulatorOpInfo &opInfo,
+  bool enableFloatAsReal
+  ) {
+
+  /*
+   * Collect the addresses of the object computed within the loop.
+   */
+  std::unordered_set<Value *> addresses;
+  for (auto user : this->pointer->users()){
+    auto userInst = dyn_cast<Instruction>(user);
+    if (userInst == nullptr){
+      return false;
+    }
+    if (!loop->isIncluded(userInst)){
+      continue ;
+    }
+
+    /*
+     * The pointer can be used to compute the address of an element of the object.
+     */
+    if (auto gep = dyn_cast<GetElementPtrInst>(userInst)){
+      if (gep->getPointerOperand() != this->pointer){
+        return false;
+      }
+      addresses.insert(gep);
+      continue ;
+    }
+
+    /*
+     * The pointer can be used to access the object directly.
+     */
+    if (isa<LoadInst>(userInst)){
+      addresses.insert(this->pointer);
+      continue ;
+    }
+    if (auto storeInst = dyn_cast<StoreInst>(userInst)){
+      if (storeInst->getValueOperand() == this->pointer){
+        return false;
+      }
+      addresses.insert(this->pointer);
+      continue ;
+    }
+
+    return false;
+  }
+
+  /*
+   * Every element must be accessed by a load, an accumulator, and a store back to the same address.
+   */
+  std::unordered_set<Instruction *> stores;
+  for (auto address : addresses){
+    for (auto user : address->users()){
+      auto userInst = cast<Instruction>(user);
+      if (!loop->isIncluded(userInst)){
+        if (address == this->pointer){
+          continue ;
+        }
+        return false;
+      }
+      if (  true
+            && (address == this->pointer)
+            && isa<GetElementPtrInst>(userInst)
+        ){
+        continue ;
+      }
+
+      if (auto loadInst = dyn_cast<LoadInst>(userInst)){
+        if (!this->identifyUpdate(loadInst, address, opInfo)){
+          return false;
+        }
+        continue ;
+      }
+      if (auto storeInst = dyn_cast<StoreInst>(userInst)){
+        if (storeInst->getValueOperand() == address){
+          return false;
+        }
+        stores.insert(storeInst);
+        continue ;
+      }
+
+      return false;
+    }
+  }
+  if (this->loadInstructions.size() == 0){
+    return false;
+  }
+  for (auto storeInst : stores){
+    if (this->storingInstructions.find(storeInst) == this->storingInstructions.end()){
+      return false;
+    }
+  }
+
+  /*
+   * All updates must compute the same operation on the same type of elements.
+   * This is the operation (and the type) used to merge the private copies of the object.
+   */
+  for (auto accumulator : this->accumulators){
+    if (AccumulatorOpInfo::isMinMax(this->accumulator)){
+      if (!AccumulatorOpInfo::isSameMinMax(this->accumulator, accumulator)){
+        return false;
+      }
+    } else if (accumulator->getOpcode() != this->accumulator->getOpcode()){
+      return false;
+    }
+  }
+  for (auto loadInst : this->loadInstructions){
+    if (loadInst->getType() != this->elementType){
+      return false;
+    }
+  }
+  if (this->elementType->isFloatingPointTy()){
+    if (!enableFloatAsReal){
+      return false;
+    }
+    if (  true
+          && (!this->elementType->isFloatTy())
+          && (!this->elementType->isDoubleTy())
+      ){
+      return false;
+    }
+  } else if (!this->elementType->isIntegerTy()){
+    return false;
+  }
+
+  /*
+   * The runtime merges the private copies in blocks of cache lines.
+   * Hence, elements cannot cross cache lines.
+   */
+  auto &DL = this->allocation->getModule()->getDataLayout();
+  auto elementSize = DL.getTypeAllocSize(this->elementType);
+  if (  false
+        || (elementSize == 0)
+        || ((64 % elementSize) != 0)
+    ){
+    return false;
+  }
+
+  /*
+   * The merge combines all elements of the object.
+   * Hence, stack objects must only include elements of the type updated by the loop.
+   */
+  if (auto alloca = dyn_cast<AllocaInst>(this->allocation)){
+    auto allocatedType = alloca->getAllocatedType();
+    while (auto arrayType = dyn_cast<ArrayType>(allocatedType)){
+      allocatedType = arrayType->getElementType();
+    }
+    if (allocatedType != this->elementType){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool ReducibleMemoryLocation::identifyUpdate (
+  LoadInst *load,
+  Value *address,
+  AccumulatorOpInfo &opInfo
+  ) {
+  if (!load->isSimple()){
+    return false;
+  }
+
+  /*
+   * Fetch the accumulator that consumes the loaded value.
+   * The only other user of the loaded value can be the comparison of a select that computes a minimum or a maximum.
+   */
+  Instruction *accumulator = nullptr;
+  std::unordered_set<CmpInst *> compares;
+  for (auto user : load->users()){
+    auto userInst = cast<Instruction>(user);
+    if (auto compare = dyn_cast<CmpInst>(userInst)){
+      compares.insert(compare);
+      continue ;
+    }
+    if (  false
+          || (accumulator != nullptr)
+          || (!opInfo.isAccumulator(userInst))
+      ){
+      return false;
+    }
+    accumulator = userInst;
+  }
+  if (accumulator == nullptr){
+    return false;
+  }
+  for (auto compare : compares){
+    auto selectInst = dyn_cast<SelectInst>(accumulator);
+    if (  false
+          || (selectInst == nullptr)
+          || (selectInst->getCondition() != compare)
+          || (!compare->hasOneUse())
+      ){
+      return false;
+    }
+  }
+
+  /*
+   * The accumulator must combine the loaded value with a different one.
+   * Subtractions are reducible only if they subtract from the loaded value.
+   */
+  auto loadedValueUses = 0;
+  for (auto &op : accumulator->operands()){
+    if (op.get() == load){
+      loadedValueUses++;
+    }
+  }
+  if (loadedValueUses != 1){
+    return false;
+  }
+  if (  true
+        && opInfo.isSubOp(accumulator->getOpcode())
+        && (accumulator->getOperand(0) != load)
+    ){
+    return false;
+  }
+
+  /*
+   * The accumulated value must be stored back to the same address and nowhere else.
+   */
+  if (!accumulator->hasOneUse()){
+    return false;
+  }
+  auto storeInst = dyn_cast<StoreInst>(*accumulator->user_begin());
+  if (  false
+        || (storeInst == nullptr)
+        || (!storeInst->isSimple())
+        || (storeInst->getValueOperand() != accumulator)
+        || (storeInst->getPointerOperand() != address)
+    ){
+    return false;
+  }
+
+  /*
+   * Nothing can write to memory between the load and the store.
+   */
+  if (storeInst->getParent() != load->getParent()){
+    return false;
+  }
+  for (auto inst = load->getNextNode(); inst != storeInst; inst = inst->getNextNode()){
+    if (inst == nullptr){
+      return false;
+    }
+    if (inst->mayWriteToMemory()){
+      return false;
+    }
+  }
+
+  /*
+   * We found an update of the object.
+   */
+  if (this->accumulator == nullptr){
+    this->accumulator = accumulator;
+    this->elementType = load->getType();
+  }
+  this->loadInstructions.insert(load);
+  this->accumulators.insert(accumulator);
+  this->storingInstructions.insert(storeInst);
+
+  return true;
+}
+
+bool ReducibleMemoryLocation::isThereAnotherMemoryDependence (
+  LoopStructure *loop,
+  PDG *ldg
+  ) const {
+
+  /*
+   * Every memory dependence between instructions of the loop that involves the object must be between its updates.
+   */
+  auto functor = [this, loop](Value *otherValue, DGEdge<Value> *d) -> bool {
+    auto otherInst = dyn_cast<Instruction>(otherValue);
+    if (otherInst == nullptr){
+      return false;
+    }
+    if (!loop->isIncluded(otherInst)){
+      return false;
+    }
+    if (  false
+          || this->isInstructionLoadingLocation(otherInst)
+          || this->isInstructionStoringLocation(otherInst)
+      ){
+      return false;
+    }
+
+    /*
+     * We found a memory dependence with another instruction of the loop.
+     */
+    return true;
+  };
+  std::unordered_set<Instruction *> memoryInsts(this->loadInstructions.begin(), this->loadInstructions.end());
+  memoryInsts.insert(this->storingInstructions.begin(), this->storingInstructions.end());
+  for (auto inst : memoryInsts){
+    if (!ldg->isInGraph(inst)){
+      continue ;
+    }
+    if (  false
+          || ldg->iterateOverDependencesFrom(inst, false, true, false, functor)
+          || ldg->iterateOverDependencesTo(inst, false, true, false, functor)
+      ){
+      return true;
+    }
+  }
+
+  return false;
+}
+
+Value * ReducibleMemoryLocation::generateCodeToComputeSizeInBytes (IRBuilder<> &builder) const {
+  Value *sizeInBytes = nullptr;
+  for (auto factor : this->sizeFactors){
+    auto factorInt64 = builder.CreateZExtOrTrunc(factor, builder.getInt64Ty());
+    if (sizeInBytes == nullptr){
+      sizeInBytes = factorInt64;
+      continue ;
+    }
+    sizeInBytes = builder.CreateMul(sizeInBytes, factorInt64);
+  }
+
+  return sizeInBytes;
+}
+
+Value * ReducibleMemoryLocation::getPointer (void) const {
+  return this->pointer;
+}
+
+Instruction * ReducibleMemoryLocation::getAllocation (void) const {
+  return this->allocation;
+}
+
+Type * ReducibleMemoryLocation::getElementType (void) const {
+  return this->elementType;
+}
+
+Instruction * ReducibleMemoryLocation::getAccumulator (void) const {
+  return this->accumulator;
+}
+
+bool ReducibleMemoryLocation::isInstructionLoadingLocation (Instruction *I) const {
+  return this->loadInstructions.find(I) != this->loadInstructions.end();
+}
+
+bool ReducibleMemoryLocation::isInstructionStoringLocation (Instruction *I) const {
+  return this->storingInstructions.find(I) != this->storingInstructions.end();
+}
+
+bool ReducibleMemoryLocation::isInstructionAccumulatingLocation (Instruction *I) const {
+  return this->accumulators.find(I) != this->accumulators.end();
+}
+
+bool ReducibleMemoryLocation::isReducibleLocation (void) const {
+  return this->isReducible;
+}
@@ -29,6 +29,7 @@ SCCAttrs::SCCAttrs (
     , loopCarriedVariables{}
     , isClonable{0}
     , isSCCClonableIntoLocalMemory{0}
+    , isSCCReducibleIntoPrivateMemory{0}
     , hasIV{0}
   {
 
@@ -145,14 +146,9 @@ void SCCAttrs::collectPHIsAndAccumulators (LoopStructure &LS) {
     if (auto I = dyn_cast<Instruction>(V)) {
 
       /*
-       * Fetch the opcode.
+       * Check if this is an operation we handle.
        */
-      auto binOp = I->getOpcode();
-
-      /*
-       * Check if this is an opcode we handle.
-       */
-      if (accumOpInfo.accumOps.find(binOp) != accumOpInfo.accumOps.end()) {
+      if (accumOpInfo.isAccumulator(I)) {
         this->accumulators.insert(I);
         continue;
       }
@@ -341,8 +337,8 @@ void SCCAttrs::addClonableMemoryLocationsContainedInSCC (std::unordered_set<cons
   this->clonableMemoryLocations = locations;
 }
 
-std::unordered_set<AllocaInst *> SCCAttrs::getMemoryLocationsToClone (void) const {
-  std::unordered_set<AllocaInst *> allocations;
+std::unordered_set<Instruction *> SCCAttrs::getMemoryLocationsToClone (void) const {
+  std::unordered_set<Instruction *> allocations;
   for (auto location : clonableMemoryLocations) {
     allocations.insert(location->getAllocation());
   }
@@ -374,3 +370,19 @@ SCCAttrs::~SCCAttrs () {
     delete var;
   }
 }
+
+void SCCAttrs::setSCCToBeReducibleUsingPrivateMemory (void) {
+  this->isSCCReducibleIntoPrivateMemory = true;
+}
+
+bool SCCAttrs::canBeReducedUsingPrivateMemoryLocations (void) const {
+  return this->isSCCReducibleIntoPrivateMemory;
+}
+
+void SCCAttrs::addReducibleMemoryLocationsContainedInSCC (std::unordered_set<const ReducibleMemoryLocation *> locations) {
+  this->reducibleMemoryLocations = locations;
+}
+
+std::unordered_set<const ReducibleMemoryLocation *> SCCAttrs::getMemoryLocationsToReduce (void) const {
+  return this->reducibleMemoryLocations;
+}
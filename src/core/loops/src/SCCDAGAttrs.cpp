@@ -24,7 +24,7 @@ SCCDAGAttrs::SCCDAGAttrs (
   InductionVariableManager &IV,
   DominatorSummary &DS
 ) : 
-  enableFloatAsReal{enableFloatAsReal}, loopDG{loopDG}, sccdag{loopSCCDAG}, memoryCloningAnalysis{nullptr} 
+  enableFloatAsReal{enableFloatAsReal}, loopDG{loopDG}, sccdag{loopSCCDAG}, memoryCloningAnalysis{nullptr}, memoryReductionAnalysis{nullptr} 
   {
 
   /*
@@ -61,7 +61,12 @@ SCCDAGAttrs::SCCDAGAttrs (
    * Compute memory cloning location analysis
    */
   auto rootLoop = LIS.getLoopNestingTreeRoot();
-  this->memoryCloningAnalysis = new MemoryCloningAnalysis(rootLoop, DS, loopDG);
+  this->memoryCloningAnalysis = new MemoryCloningAnalysis(rootLoop, DS, SE, loopDG);
+
+  /*
+   * Compute the analysis of memory objects that can be reduced
+   */
+  this->memoryReductionAnalysis = new MemoryReductionAnalysis(rootLoop, loopDG, this->accumOpInfo, enableFloatAsReal);
 
   /*
    * Tag SCCs depending on their characteristics.
@@ -81,6 +86,7 @@ SCCDAGAttrs::SCCDAGAttrs (
     sccInfo->setSCCToBeInductionVariable(doesSCCOnlyContainIV);
 
     this->checkIfClonable(scc, SE, LIS);
+    this->checkIfReducibleByUsingPrivateMemory(scc);
 
     /*
      * Categorize the current SCC.
@@ -600,6 +606,66 @@ void SCCDAGAttrs::checkIfClonableByUsingLocalMemory(SCC *scc, LoopsSummary &LIS)
   return ;
 }
 
+void SCCDAGAttrs::checkIfReducibleByUsingPrivateMemory (SCC *scc) {
+
+  /*
+   * Ignore SCC without loop carried dependencies
+   */
+  if (this->sccToLoopCarriedDependencies.find(scc) == this->sccToLoopCarriedDependencies.end()) {
+    return;
+  }
+
+  /*
+   * Ensure that all loop carried dependencies are between updates of memory objects that can be reduced.
+   */
+  std::unordered_set<const llvm::noelle::ReducibleMemoryLocation *> locations;
+  for (auto dependency : this->sccToLoopCarriedDependencies.at(scc)) {
+
+    /*
+     * Only memory dependences can be removed by reducing private copies of memory objects.
+     * Control dependences are handled by the parallelization techniques.
+     */
+    if (dependency->isControlDependence()){
+      continue ;
+    }
+    if (!dependency->isMemoryDependence()){
+      return ;
+    }
+    auto producer = dyn_cast<Instruction>(dependency->getOutgoingT());
+    auto consumer = dyn_cast<Instruction>(dependency->getIncomingT());
+    if (  false
+          || (producer == nullptr)
+          || (consumer == nullptr)
+      ){
+      return ;
+    }
+
+    /*
+     * Both instructions must update the same reducible object.
+     */
+    auto location = this->memoryReductionAnalysis->getReducibleMemoryLocationFor(producer);
+    if (  false
+          || (location == nullptr)
+          || (location != this->memoryReductionAnalysis->getReducibleMemoryLocationFor(consumer))
+      ){
+      return ;
+    }
+    locations.insert(location);
+  }
+
+  /*
+   * All loop-carried data dependences can be removed by reducing private copies of memory objects.
+   */
+  if (locations.size() == 0) {
+    return;
+  }
+  auto sccInfo = this->sccToInfo.at(scc);
+  sccInfo->setSCCToBeReducibleUsingPrivateMemory();
+  sccInfo->addReducibleMemoryLocationsContainedInSCC(locations);
+
+  return ;
+}
+
 bool SCCDAGAttrs::isClonableByHavingNoMemoryOrLoopCarriedDataDependencies (SCC *scc, LoopsSummary &LIS) const {
 
   /*
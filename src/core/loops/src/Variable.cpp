@@ -10,6 +10,7 @@
  */
 #include "Variable.hpp"
 #include "LoopCarriedDependencies.hpp"
+#include "AccumulatorOpInfo.hpp"
 
 using namespace llvm;
 using namespace llvm::noelle;
@@ -103,8 +104,12 @@ LoopCarriedVariable::LoopCarriedVariable (
       /*
        * Select instructions contain a condition that controls the evolution of the variable 
        * There is no need to check them for producing control dependencies, so we continue
+       *
+       * The condition of a select that computes the minimum or maximum is part of the update itself
        */
-      this->controlValuesGoverningEvolution.insert(selectInst->getCondition());
+      if (!AccumulatorOpInfo::isMinMax(selectInst)) {
+        this->controlValuesGoverningEvolution.insert(selectInst->getCondition());
+      }
       continue;
     }
 
@@ -188,11 +193,39 @@ bool LoopCarriedVariable::isEvolutionReducibleAcrossLoopIterations (void) const
      */
     if (update->mayUpdateBeOverride()) return false;
 
+    /*
+     * Minimum and maximum are arithmetic updates even when they are implemented with selects
+     */
     auto updateInstruction = update->getUpdateInstruction();
+    if (update->isMinMax()) {
+      arithmeticUpdates.insert(update);
+      continue;
+    }
     if (isa<PHINode>(updateInstruction) || isa<SelectInst>(updateInstruction)) continue;
+
+    /*
+     * Comparisons used only to compute minimum or maximum are part of those updates
+     */
+    if (isa<CmpInst>(updateInstruction)) {
+      auto isPartOfMinMax = true;
+      for (auto user : updateInstruction->users()) {
+        auto userInst = dyn_cast<Instruction>(user);
+        isPartOfMinMax &= (userInst != nullptr) && AccumulatorOpInfo::isMinMax(userInst);
+      }
+      if (isPartOfMinMax) continue;
+    }
     arithmeticUpdates.insert(update);
   }
 
+  /*
+   * Casts within the variable would change the values compared by minimum and maximum
+   */
+  if (castsInternalToVariableComputation.size() > 0) {
+    for (auto update : arithmeticUpdates) {
+      if (update->isMinMax()) return false;
+    }
+  }
+
   /*
    * Do not allow any casts to cause rounding error if the variable is reduced
    */
@@ -466,13 +499,28 @@ EvolutionUpdate::EvolutionUpdate (Instruction *updateInstruction, SCC *dataMemor
 }
 
 bool EvolutionUpdate::mayUpdateBeOverride (void) const {
+
+  /*
+   * The minimum or maximum between a previous value of the variable
+   * and another value does not override the variable
+   */
+  if (isMinMax()) {
+    return internalValuesUsed.size() == 0;
+  }
+
   if (isa<SelectInst>(updateInstruction) || isa<PHINode>(updateInstruction)) {
 
     /*
-     * If any operand in the select or phi instruction is external,
+     * If any value propagated by the select or phi instruction is external,
      * then the instruction can possibly override the variable
+     *
+     * The condition of a select only chooses between the values propagated
      */
-    return externalValuesUsed.size() > 0;
+    for (auto use : externalValuesUsed) {
+      if (isa<SelectInst>(updateInstruction) && use->getOperandNo() == 0) continue;
+      return true;
+    }
+    return false;
   }
 
   /*
@@ -513,6 +561,7 @@ bool EvolutionUpdate::mayUpdateBeOverride (void) const {
 
 bool EvolutionUpdate::isCommutativeWithSelf (void) const {
   if (mayUpdateBeOverride()) return false;
+  if (isMinMax()) return true;
   return updateInstruction->isCommutative();
 }
 
@@ -528,6 +577,10 @@ bool EvolutionUpdate::isMul (void) const {
     || Instruction::FMul == op;
 }
 
+bool EvolutionUpdate::isMinMax (void) const {
+  return AccumulatorOpInfo::isMinMax(updateInstruction);
+}
+
 bool EvolutionUpdate::isSub (void) const {
   auto op = updateInstruction->getOpcode();
   return Instruction::Sub == op
@@ -548,6 +601,7 @@ bool EvolutionUpdate::isSubTransformableToAdd () const {
 bool EvolutionUpdate::isTransformablyCommutativeWithSelf (void) const {
   if (mayUpdateBeOverride()) return false;
   if (updateInstruction->isCommutative()) return true;
+  if (isMinMax()) return true;
 
   return isSubTransformableToAdd();
 }
@@ -562,6 +616,7 @@ bool EvolutionUpdate::isAssociativeWithSelf (void) const {
    */
   if (isAdd()) return true;
   if (isMul()) return true;
+  if (isMinMax()) return true;
 
   return isSubTransformableToAdd();
 }
@@ -581,10 +636,13 @@ bool EvolutionUpdate::isTransformablyCommutativeWith (const EvolutionUpdate &oth
    * Multiplication is not mutually commutative with any other than multiplication
    * 
    * Logical operators are only mutually commutative with each other
+   * 
+   * Minimum and maximum are only mutually commutative with the same kind of minimum or maximum
    */
   if (isBothUpdatesAddOrSub(otherUpdate)) return true;
   if (isBothUpdatesMul(otherUpdate)) return true;
   if (isBothUpdatesSameBitwiseLogicalOp(otherUpdate)) return true;
+  if (isBothUpdatesSameMinMax(otherUpdate)) return true;
 
   return false;
 }
@@ -604,10 +662,13 @@ bool EvolutionUpdate::isAssociativeWith (const EvolutionUpdate &otherUpdate) con
    * Multiplication is not mutually associative with any other than multiplication
    * 
    * Logical operators are only mutually associative with each other
+   * 
+   * Minimum and maximum are only mutually associative with the same kind of minimum or maximum
    */
   if (isBothUpdatesAddOrSub(otherUpdate)) return true;
   if (isBothUpdatesMul(otherUpdate)) return true;
   if (isBothUpdatesSameBitwiseLogicalOp(otherUpdate)) return true;
+  if (isBothUpdatesSameMinMax(otherUpdate)) return true;
 
   return false;
 }
@@ -632,6 +693,10 @@ bool EvolutionUpdate::isBothUpdatesSameBitwiseLogicalOp (const EvolutionUpdate &
     && thisOp == otherOp;
 }
 
+bool EvolutionUpdate::isBothUpdatesSameMinMax (const EvolutionUpdate &otherUpdate) const {
+  return AccumulatorOpInfo::isSameMinMax(this->updateInstruction, otherUpdate.updateInstruction);
+}
+
 Instruction *EvolutionUpdate::getUpdateInstruction (void) const {
   return updateInstruction;
 }
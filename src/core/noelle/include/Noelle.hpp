@@ -21,6 +21,7 @@
 #include "FunctionsManager.hpp"
 #include "TypesManager.hpp"
 #include "CompilationOptionsManager.hpp"
+#include "RuntimeFeedbackManager.hpp"
 
 namespace llvm::noelle {
 
@@ -50,6 +51,8 @@ namespace llvm::noelle {
       FunctionsManager * getFunctionsManager (void) ;
 
       CompilationOptionsManager * getCompilationOptionsManager (void) ;
+
+      RuntimeFeedbackManager * getRuntimeFeedbackManager (void) ;
       
       TypesManager * getTypesManager (void) ;
 
@@ -212,6 +215,7 @@ namespace llvm::noelle {
       FunctionsManager *fm;
       TypesManager *tm;
       CompilationOptionsManager *om;
+      RuntimeFeedbackManager *fbm;
 
       uint32_t fetchTheNextValue (
         std::stringstream &stream
@@ -230,6 +234,8 @@ namespace llvm::noelle {
         std::unordered_set<LoopDependenceInfoOptimization> optimizations
       );
 
+      LoopDependenceInfo * tuneLoopWithRuntimeFeedback (LoopDependenceInfo *ldi) ;
+
       bool isLoopHot (LoopStructure *loopStructure, double minimumHotness) ;
       bool isFunctionHot (Function *function, double minimumHotness) ;
 
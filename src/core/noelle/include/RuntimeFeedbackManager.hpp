@@ -0,0 +1,58 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "LoopDependenceInfo.hpp"
+
+namespace llvm::noelle {
+
+  /*
+   * Feedback written by the NOELLE runtime about a parallelized loop (see NOELLE_FEEDBACK_FILE in the runtime).
+   */
+  struct LoopRuntimeFeedback {
+    uint32_t cores;
+    uint32_t chunkSize;
+    uint64_t invocations;
+    double imbalance;
+    double speedup;
+  };
+
+  /*
+   * Feedback-directed tuning of the parallelized loops.
+   *
+   * The feedback of the previous run of the program is keyed by the loop ID, which is stable across compilations when loop IDs are embedded in the IR (noelle-meta-loop-embed).
+   */
+  class RuntimeFeedbackManager {
+    public:
+      RuntimeFeedbackManager (
+        const char *fileName,
+        uint32_t maxCores
+        );
+
+      bool isAvailable (void) const ;
+
+      bool hasFeedback (uint64_t loopID) const ;
+
+      const LoopRuntimeFeedback & getFeedback (uint64_t loopID) const ;
+
+      /*
+       * Adjust the number of cores, the DOALL chunk size, and the techniques of @ldi based on how the loop performed in the previous run.
+       * Return true if @ldi has been modified.
+       */
+      bool tuneLoop (LoopDependenceInfo *ldi) const ;
+
+    private:
+      uint32_t maxCores;
+      std::unordered_map<uint64_t, LoopRuntimeFeedback> loops;
+  };
+
+}
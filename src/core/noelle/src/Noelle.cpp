@@ -27,6 +27,7 @@ Noelle::Noelle()
   , fm{nullptr}
   , tm{nullptr}
   , om{nullptr}
+  , fbm{nullptr}
 {
 
   return ;
@@ -294,4 +295,9 @@ CompilationOptionsManager * Noelle::getCompilationOptionsManager (void) {
   return this->om;
 }
 
+RuntimeFeedbackManager * Noelle::getRuntimeFeedbackManager (void) {
+  assert(this->fbm != nullptr);
+  return this->fbm;
+}
+
 }
@@ -219,6 +219,7 @@ LoopDependenceInfo * Noelle::getLoop (
    */
   if (this->loopHeaderToLoopIndexMap.find(header) == this->loopHeaderToLoopIndexMap.end()){
     auto ldi = new LoopDependenceInfo(funcPDG, llvmLoop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, optimizations, this->loopAwareDependenceAnalysis);
+    this->tuneLoopWithRuntimeFeedback(ldi);
 
     delete DS;
     return ldi;
@@ -234,6 +235,7 @@ LoopDependenceInfo * Noelle::getLoop (
    */
   if (!this->hasReadFilterFile) {
     auto ldi = new LoopDependenceInfo(funcPDG, llvmLoop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, optimizations, this->loopAwareDependenceAnalysis);
+    this->tuneLoopWithRuntimeFeedback(ldi);
 
     delete DS;
     return ldi;
@@ -348,6 +350,7 @@ std::vector<LoopDependenceInfo *> * Noelle::getLoops (
       assert(!edge->isLoopCarriedDependence() && "Flag set");
     }
     auto ldi = new LoopDependenceInfo(funcPDG, loop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, this->loopAwareDependenceAnalysis);
+    this->tuneLoopWithRuntimeFeedback(ldi);
     allLoops->push_back(ldi);
   }
 
@@ -464,6 +467,7 @@ std::vector<LoopDependenceInfo *> * Noelle::getLoops (
          * Allocate the loop wrapper.
          */
         auto ldi = new LoopDependenceInfo(funcPDG, loop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, this->loopAwareDependenceAnalysis);
+        this->tuneLoopWithRuntimeFeedback(ldi);
 
         allLoops->push_back(ldi);
         continue ;
@@ -931,6 +935,7 @@ LoopDependenceInfo * Noelle::getLoopDependenceInfoForLoop (
    * DOALL chunk size is the one defined by INDEX_FILE + 1. This is because chunk size must start from 1.
    */
   ldi->DOALLChunkSize = DOALLChunkSizeForLoop + 1;
+  ldi->hasUserDefinedDOALLChunkSize = true;
 
   /*
    * Set the techniques that are enabled.
@@ -976,6 +981,22 @@ LoopDependenceInfo * Noelle::getLoopDependenceInfoForLoop (
   return ldi;
 }
 
+LoopDependenceInfo * Noelle::tuneLoopWithRuntimeFeedback (LoopDependenceInfo *ldi) {
+
+  /*
+   * Tune the loop with the feedback of the previous run of the program.
+   * Loops configured by the user (INDEX_FILE) do not reach this point.
+   */
+  if (!this->fbm->tuneLoop(ldi)){
+    return ldi;
+  }
+  if (this->verbose != Verbosity::Disabled){
+    errs() << "Noelle:  Loop " << ldi->getID() << " has been tuned with the feedback of the previous run\n";
+  }
+
+  return ldi;
+}
+
 bool Noelle::isLoopHot (LoopStructure *loopStructure, double minimumHotness) {
   if (!profiles->isAvailable()) {
     return true;
@@ -25,6 +25,7 @@ static cl::opt<bool> DisableDOALL("noelle-disable-doall", cl::ZeroOrMore, cl::Hi
 static cl::opt<bool> DisableDistribution("noelle-disable-loop-distribution", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the loop distribution"));
 static cl::opt<bool> DisableInvCM("noelle-disable-loop-invariant-code-motion", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the loop invariant code motion"));
 static cl::opt<bool> DisableWhilifier("noelle-disable-whilifier", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the loop whilifier"));
+static cl::opt<bool> DisableAliasVersioning("noelle-disable-loop-alias-versioning", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the versioning of loops with run-time alias checks"));
 static cl::opt<bool> DisableSCEVSimplification("noelle-disable-scev-simplification", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable IV related SCEV simplification"));
 static cl::opt<bool> DisableLoopAwareDependenceAnalyses("noelle-disable-loop-aware-dependence-analyses", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable loop aware dependence analyses"));
 static cl::opt<bool> DisableInliner("noelle-disable-inliner", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the function inliner"));
@@ -69,6 +70,9 @@ bool Noelle::doInitialization (Module &M) {
   if (DisableWhilifier.getNumOccurrences() > 0){
     this->enabledTransformations.erase(LOOP_WHILIFIER_ID);
   }
+  if (DisableAliasVersioning.getNumOccurrences() > 0){
+    this->enabledTransformations.erase(LOOP_ALIAS_VERSIONING_ID);
+  }
   if (DisableSCEVSimplification.getNumOccurrences() > 0){
     this->enabledTransformations.erase(SCEV_SIMPLIFICATION_ID);
   }
@@ -89,6 +93,7 @@ bool Noelle::doInitialization (Module &M) {
    * Allocate the managers.
    */
   this->om = new CompilationOptionsManager(M, optMaxCores);
+  this->fbm = new RuntimeFeedbackManager(getenv("NOELLE_FEEDBACK_FILE"), optMaxCores);
 
   /*
    * Store the module.
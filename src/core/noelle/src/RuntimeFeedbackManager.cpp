@@ -0,0 +1,137 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "RuntimeFeedbackManager.hpp"
+
+namespace llvm::noelle {
+
+/*
+ * Imbalance (slowest task over average task) above which the iterations are interleaved more finely between cores.
+ */
+static const double maximumImbalance = 1.2;
+
+RuntimeFeedbackManager::RuntimeFeedbackManager (
+  const char *fileName,
+  uint32_t maxCores
+  )
+  : maxCores{maxCores}
+{
+
+  /*
+   * Check if there is feedback.
+   */
+  if (fileName == nullptr){
+    return ;
+  }
+  std::ifstream feedbackFile(fileName);
+  if (!feedbackFile.is_open()){
+    return ;
+  }
+
+  /*
+   * Parse the file.
+   * Every line that is not a comment describes a loop:
+   *   loopID cores chunkSize invocations imbalance speedup
+   */
+  std::string line;
+  while (std::getline(feedbackFile, line)){
+    if (  false
+          || (line.size() == 0)
+          || (line[0] == '#')
+      ){
+      continue ;
+    }
+    std::stringstream lineStream{line};
+    uint64_t loopID;
+    LoopRuntimeFeedback feedback;
+    lineStream >> loopID >> feedback.cores >> feedback.chunkSize >> feedback.invocations >> feedback.imbalance >> feedback.speedup;
+    if (lineStream.fail()){
+      errs() << "Noelle: WARNING: the line \"" << line << "\" of the feedback file " << fileName << " is malformed\n";
+      continue ;
+    }
+    this->loops[loopID] = feedback;
+  }
+
+  return ;
+}
+
+bool RuntimeFeedbackManager::isAvailable (void) const {
+  return this->loops.size() > 0;
+}
+
+bool RuntimeFeedbackManager::hasFeedback (uint64_t loopID) const {
+  return this->loops.find(loopID) != this->loops.end();
+}
+
+const LoopRuntimeFeedback & RuntimeFeedbackManager::getFeedback (uint64_t loopID) const {
+  assert(this->hasFeedback(loopID));
+
+  return this->loops.at(loopID);
+}
+
+bool RuntimeFeedbackManager::tuneLoop (LoopDependenceInfo *ldi) const {
+
+  /*
+   * Fetch the feedback of the loop.
+   */
+  auto loopID = ldi->getID();
+  if (!this->hasFeedback(loopID)){
+    return false;
+  }
+  auto &feedback = this->getFeedback(loopID);
+
+  /*
+   * Check if the parallelized loop was slower than the tasks it executed (i.e., slower than the sequential loop).
+   * In this case, DOALL is not worth it.
+   */
+  if (feedback.speedup < 1){
+    ldi->disableTransformation(DOALL_ID);
+    return true;
+  }
+
+  /*
+   * Start from the configuration used by the previous run.
+   */
+  auto cores = std::min(std::max(feedback.cores, (uint32_t)2), this->maxCores);
+  auto chunkSize = std::max(feedback.chunkSize, (uint32_t)1);
+
+  /*
+   * Check if the cores were used efficiently.
+   * If the speedup is below half of the cores, the extra cores mostly add dispatching and contention overhead.
+   */
+  if (  true
+        && (cores > 2)
+        && (feedback.speedup < (cores / 2.0))
+    ){
+    cores = std::max((uint32_t)ceil(feedback.speedup * 2), (uint32_t)2);
+  }
+
+  /*
+   * Check if the tasks were imbalanced.
+   * Smaller chunks interleave the iterations more finely between the cores.
+   */
+  if (  true
+        && (feedback.imbalance > maximumImbalance)
+        && (chunkSize > 1)
+    ){
+    chunkSize = chunkSize / 2;
+  }
+
+  /*
+   * Tune the loop.
+   */
+  ldi->setMaximumNumberOfCores(cores);
+  ldi->DOALLChunkSize = chunkSize;
+  ldi->hasUserDefinedDOALLChunkSize = true;
+
+  return true;
+}
+
+}
@@ -244,7 +244,8 @@ namespace llvm::noelle {
      DGEdgeBase(DGNode<T> *src, DGNode<T> *dst)
          : from(src), to(dst), memory(false), must(false),
            dataDepType(DG_DATA_NONE), isControl(false), isLoopCarried(false),
-           isRemovable(false), remeds(nullptr) {}
+           isRemovable(false), remeds(nullptr), profiledFrequency(-1),
+           dependenceDistance(0) {}
      DGEdgeBase(const DGEdgeBase<T, SubT> &oldEdge);
 
      typedef typename std::unordered_set<DGEdge<SubT> *>::iterator edges_iterator;
@@ -275,6 +276,18 @@ namespace llvm::noelle {
     bool isLoopCarriedDependence() const { return isLoopCarried; }
     DataDependenceType dataDependenceType() const { return dataDepType; }
     bool isRemovableDependence() const { return isRemovable; }
+
+    /*
+     * Frequency of the dependence observed by a profiler (i.e., average number of times it occurred per loop iteration).
+     */
+    bool hasProfiledFrequency() const { return profiledFrequency >= 0; }
+    double getProfiledFrequency() const { return profiledFrequency; }
+
+    /*
+     * Number of iterations between the instance of the source and the instance of the destination of a loop-carried dependence (e.g., 4 for a[i] = a[i-4]).
+     */
+    bool hasDependenceDistance() const { return dependenceDistance > 0; }
+    int64_t getDependenceDistance() const { return dependenceDistance; }
     std::optional<SetOfRemedies> getRemedies() const {
       return (remeds) ? std::make_optional<SetOfRemedies>(*remeds)
                       : std::nullopt;
@@ -297,6 +310,8 @@ namespace llvm::noelle {
       remeds->insert(R);
     }
     void setRemovable(bool rem) { isRemovable = rem; }
+    void setProfiledFrequency(double frequency) { profiledFrequency = frequency; }
+    void setDependenceDistance(int64_t distance) { dependenceDistance = distance; }
 
     void setEdgeAttributes(bool mem, bool must, std::string str, bool ctrl, bool lc, bool rm) {
       setMemMustType(mem, must, stringToDataDep(str));
@@ -357,6 +372,10 @@ namespace llvm::noelle {
     DataDependenceType dataDepType;
 
     SetOfRemedies_ptr remeds;
+
+    double profiledFrequency;
+
+    int64_t dependenceDistance;
   };
 
   /*
@@ -765,6 +784,8 @@ namespace llvm::noelle {
     setLoopCarried(oldEdge.isLoopCarriedDependence());
     setRemovable(oldEdge.isRemovableDependence());
     setRemedies(oldEdge.getRemedies());
+    setProfiledFrequency(oldEdge.getProfiledFrequency());
+    setDependenceDistance(oldEdge.getDependenceDistance());
     for (auto subEdge : oldEdge.subEdges) addSubEdge(subEdge);
   }
 
@@ -17,8 +17,18 @@
 #include <condition_variable>
 #include <mutex>
 #include <queue>
+#include <map>
 #include <utility>
 #include <iostream>
+#include <fstream>
+#include <chrono>
+
+#include <ucontext.h>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 /*
  * OPTIONS
@@ -31,6 +41,21 @@ using namespace MARC;
 
 #define CACHE_LINE_SIZE 64
 
+/*
+ * Size of the stack of a DSWP stage executed cooperatively.
+ */
+#define DSWP_COOPERATIVE_STAGE_STACK_SIZE (8 * 1024 * 1024)
+
+/*
+ * Number of values a DSWP stage executed cooperatively can push before yielding to the other stages of its worker.
+ */
+#define DSWP_COOPERATIVE_PUSHES_BEFORE_YIELD 128
+
+/*
+ * Minimum number of bytes of a reduced memory object merged by a core.
+ */
+#define NOELLE_REDUCTION_MIN_BYTES_PER_CORE (16 * 1024)
+
 #ifdef DSWP_STATS
 static int64_t numberOfPushes8 = 0;
 static int64_t numberOfPushes16 = 0;
@@ -46,6 +71,9 @@ typedef struct {
   int64_t coreID ;
   int64_t numCores;
   int64_t chunkSize ;
+  uint64_t loopID;
+  uint64_t submissionTime;
+  uint64_t taskTime;
   pthread_mutex_t endLock;
 } DOALL_args_t ;
 
@@ -82,6 +110,124 @@ class NoelleRuntime {
     mutable pthread_spinlock_t spinLock;
 };
 
+/*
+ * Hardware events sampled around the tasks of parallelized loops.
+ */
+#define NOELLE_PERF_EVENTS 5
+static const char *NOELLE_perfEventNames[NOELLE_PERF_EVENTS] = {"cycles", "instructions", "llc_misses", "remote_node_accesses", "contention"};
+
+/*
+ * Hardware performance counters of the workers aggregated per parallelized loop.
+ *
+ * Counters are enabled by the environment variable NOELLE_PERF_COUNTERS (no recompilation is needed).
+ * The contention event is model specific: its raw code (in hexadecimal) is given by NOELLE_PERF_CONTENTION_EVENT (e.g., the loads that hit a modified line in another core).
+ * Events that cannot be opened (e.g., because of perf_event_paranoid or because the machine does not support them) are not counted.
+ */
+class NoellePerformanceCounters {
+  public:
+    NoellePerformanceCounters ();
+
+    ~NoellePerformanceCounters ();
+
+    bool isEnabled (void) const ;
+
+    /*
+     * Read the counters of the calling thread.
+     */
+    void read (uint64_t *values);
+
+    /*
+     * Add the events counted by the calling thread since @startValues to the ones of the loop @loopID.
+     */
+    void accumulate (uint64_t loopID, uint64_t *startValues);
+
+    void countInvocation (uint64_t loopID);
+
+  private:
+    bool enabled;
+    int64_t contentionEvent;
+
+    typedef struct {
+      uint64_t invocations;
+      uint64_t values[NOELLE_PERF_EVENTS];
+    } LoopCounters ;
+    std::map<uint64_t, LoopCounters> loops;
+    mutable pthread_spinlock_t lock;
+
+    /*
+     * Counter group of a worker thread.
+     * Events that could not be added to the group have index -1.
+     */
+    typedef struct {
+      bool isOpened;
+      int leaderFD;
+      int32_t indexes[NOELLE_PERF_EVENTS];
+    } WorkerCounters ;
+    static thread_local WorkerCounters workerCounters;
+
+    void openCounters (void);
+};
+
+/*
+ * Feedback of the parallelized loops for the next compilation of the program.
+ *
+ * When the environment variable NOELLE_FEEDBACK_FILE is set, the runtime measures the DOALL loops it dispatches and it writes the following line per loop to that file at exit:
+ *   loopID cores chunkSize invocations imbalance speedup
+ * Imbalance is the time of the slowest task of an invocation divided by the average time of the tasks (1 means no imbalance).
+ * Speedup is the time spent in the tasks divided by the time spent in the dispatcher; this is the speedup over the sequential loop if the tasks do not include parallelization overhead.
+ * Loops of the file that have not been executed are preserved.
+ */
+class NoelleLoopFeedback {
+  public:
+    NoelleLoopFeedback ();
+
+    ~NoelleLoopFeedback ();
+
+    bool isEnabled (void) const ;
+
+    void recordDOALLInvocation (
+      DOALL_args_t *argsForAllCores,
+      uint32_t numCores,
+      uint64_t endTime
+      );
+
+    static uint64_t getCurrentTime (void);
+
+  private:
+    char *fileName;
+
+    typedef struct {
+      uint32_t cores;
+      int64_t chunkSize;
+      uint64_t invocations;
+      double slowestTasksTime;
+      double averageTasksTime;
+      double tasksTime;
+      double dispatcherTime;
+    } LoopFeedback ;
+    std::map<uint64_t, LoopFeedback> loops;
+    mutable pthread_spinlock_t lock;
+};
+
+/*
+ * Buffers used by a thread as private copies of heap objects cloned by parallelized loops.
+ *
+ * Released buffers are kept to be reused by the next acquisitions of the same thread (e.g., by the next invocation of the loop).
+ * Every buffer starts with a cache line that stores its capacity; the rest of the buffer is given to the caller.
+ */
+class NoellePrivateBufferPool {
+  public:
+    ~NoellePrivateBufferPool ();
+
+    void * acquire (int64_t sizeInBytes);
+
+    void release (void *buffer);
+
+  private:
+    static const uint64_t maximumNumberOfFreeBuffers = 8;
+    std::vector<void *> freeBuffers;
+};
+
 #ifdef RUNTIME_PROFILE
 pthread_spinlock_t printLock;
 uint64_t clocks_starts[64];
@@ -90,6 +236,107 @@ uint64_t clocks_ends[64];
 
 static NoelleRuntime runtime{};
 
+static NoellePerformanceCounters performanceCounters{};
+
+static NoelleLoopFeedback loopFeedback{};
+
+thread_local NoellePerformanceCounters::WorkerCounters NoellePerformanceCounters::workerCounters = {false, -1, {}};
+
+/*
+ * ID of the parallelized loop the current thread is about to dispatch.
+ */
+static thread_local uint64_t currentLoopID = 0;
+
+static thread_local NoellePrivateBufferPool privateBufferPool{};
+
+/*
+ * DSWP stage executed as a user-level task by a worker thread.
+ */
+typedef struct {
+  void (*stage)(void *, void *, int64_t);
+  void *env;
+  void *localQueues;
+  int64_t replicaID;
+  ucontext_t context;
+  void *stack;
+  bool isOver;
+  uint32_t pushesSinceLastYield;
+} NOELLE_DSWP_cooperativeStage_t ;
+
+/*
+ * Worker thread that executes multiple DSWP stages cooperatively.
+ */
+typedef struct {
+  NOELLE_DSWP_cooperativeStage_t *stages;
+  uint32_t numberOfStages;
+  uint64_t loopID;
+  NOELLE_DSWP_cooperativeStage_t *currentStage;
+  ucontext_t schedulerContext;
+} NOELLE_DSWP_worker_t ;
+
+/*
+ * Worker the current thread belongs to.
+ * This is nullptr when the thread executes a single stage (or no stage at all).
+ */
+static thread_local NOELLE_DSWP_worker_t *currentDSWPWorker = nullptr;
+
+static void NOELLE_DSWPYield (void){
+
+  /*
+   * Give the control back to the scheduler of the worker.
+   */
+  auto stage = currentDSWPWorker->currentStage;
+  stage->pushesSinceLastYield = 0;
+  swapcontext(&stage->context, &currentDSWPWorker->schedulerContext);
+
+  return ;
+}
+
+template <typename T>
+static void NOELLE_DSWPQueuePush (ThreadSafeQueue<T> *queue, T *val){
+  queue->push(*val);
+
+  /*
+   * Check if the stage is executed cooperatively.
+   */
+  if (currentDSWPWorker == nullptr){
+    return ;
+  }
+
+  /*
+   * Queues are unbounded.
+   * Hence, we consider the queue full after a fixed number of pushes so the consumers sharing the worker can catch up.
+   */
+  auto stage = currentDSWPWorker->currentStage;
+  stage->pushesSinceLastYield++;
+  if (stage->pushesSinceLastYield >= DSWP_COOPERATIVE_PUSHES_BEFORE_YIELD){
+    NOELLE_DSWPYield();
+  }
+
+  return ;
+}
+
+template <typename T>
+static void NOELLE_DSWPQueuePop (ThreadSafeQueue<T> *queue, T *val){
+
+  /*
+   * Check if the stage is executed cooperatively.
+   */
+  if (currentDSWPWorker == nullptr){
+    queue->waitPop(*val);
+    return ;
+  }
+
+  /*
+   * Let the other stages of the worker run until the queue has a value for us.
+   */
+  while (!queue->tryPop(*val)){
+    NOELLE_DSWPYield();
+  }
+
+  return ;
+}
+
 extern "C" {
 
   /******************************************** NOELLE APIs ***********************************************/
@@ -110,6 +357,100 @@ extern "C" {
     int64_t chunkSize
     );
 
+  /*
+   * Dispatch threads to run a DOALL loop without waiting for them.
+   * The handle returned must be given to NOELLE_DOALLJoin to wait for the loop to complete.
+   */
+  void * NOELLE_DOALLDispatcherAsync (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t), 
+    void *env, 
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize
+    );
+
+  DispatcherInfo NOELLE_DOALLJoin (
+    void *handle
+    );
+
+  /*
+   * Set the ID of the parallelized loop dispatched next by the current thread.
+   * This ID is used to aggregate the hardware performance counters (see NOELLE_PERF_COUNTERS).
+   */
+  void NOELLE_setCurrentLoopID (
+    uint64_t loopID
+    );
+
+  /*
+   * Allocate @numberOfCopies private copies of a memory object of @sizeInBytes bytes that is reduced by a parallelized loop (e.g., a histogram).
+   */
+  void * NOELLE_allocatePrivateCopies (
+    int64_t sizeInBytes,
+    int64_t numberOfCopies
+    );
+
+  /*
+   * Initialize the private copy @copyID by invoking @initializer on it.
+   * Return the private copy.
+   */
+  void * NOELLE_initializePrivateCopy (
+    void *copies,
+    int64_t copyID,
+    void (*initializer)(void *, int64_t)
+    );
+
+  /*
+   * Merge the first @numberOfCopiesUsed private copies into the original memory object using at most @maxNumberOfCores cores.
+   * @reducer merges its second argument into its first one (both have the size given by its third argument).
+   * The private copies are freed.
+   */
+  void NOELLE_reducePrivateCopies (
+    void *copies,
+    void *original,
+    void (*reducer)(void *, void *, int64_t),
+    int64_t numberOfCopiesUsed,
+    int64_t maxNumberOfCores
+    );
+
+  /*
+   * Allocate @numberOfPartials partial results of a parallelized loop that reduces a variable deterministically.
+   * There is one partial per chunk plus one per task for the chunk it would execute after its last one.
+   * Every partial has @partialSizeInBytes bytes and it is initialized to @identity.
+   */
+  void * NOELLE_allocateChunkPartials (
+    int64_t numberOfPartials,
+    int64_t partialSizeInBytes,
+    void *identity
+    );
+
+  /*
+   * Combine the @numberOfPartials partial results in a fixed pairwise order and accumulate the outcome into @result.
+   * @reducer merges its second argument into its first one (both have the size given by its third argument).
+   * The partials are freed.
+   */
+  void NOELLE_reduceChunkPartials (
+    void *partials,
+    int64_t numberOfPartials,
+    int64_t partialSizeInBytes,
+    void (*reducer)(void *, void *, int64_t),
+    void *result
+    );
+
+  /*
+   * Acquire a private buffer of at least @sizeInBytes bytes for the calling thread.
+   * The buffer is aligned to a cache line and its content is undefined.
+   */
+  void * NOELLE_acquirePrivateBuffer (
+    int64_t sizeInBytes
+    );
+
+  /*
+   * Release a buffer returned by NOELLE_acquirePrivateBuffer.
+   * The buffer must be released by the thread that acquired it.
+   */
+  void NOELLE_releasePrivateBuffer (
+    void *buffer
+    );
+
 
     #ifdef RUNTIME_PROFILE
     static __inline__ int64_t rdtsc_s(void) {
@@ -129,7 +470,15 @@ extern "C" {
 
   /******************************************** NOELLE API implementations ***********************************************/
 
-  typedef void (*stageFunctionPtr_t)(void *, void*);
+  typedef void (*stageFunctionPtr_t)(void *, void*, int64_t);
+
+  void NOELLE_setCurrentLoopID (
+    uint64_t loopID
+    ){
+    currentLoopID = loopID;
+
+    return ;
+  }
 
   void printReachedS(std::string s)
   {
@@ -150,7 +499,7 @@ extern "C" {
   }
 
   void queuePush8(ThreadSafeQueue<int8_t> *queue, int8_t *val) { 
-    queue->push(*val); 
+    NOELLE_DSWPQueuePush(queue, val);
 
     #ifdef DSWP_STATS
     numberOfPushes8++;
@@ -160,12 +509,12 @@ extern "C" {
   }
 
   void queuePop8(ThreadSafeQueue<int8_t> *queue, int8_t *val) { 
-    queue->waitPop(*val); 
+    NOELLE_DSWPQueuePop(queue, val);
     return ;
   }
 
   void queuePush16(ThreadSafeQueue<int16_t> *queue, int16_t *val) { 
-    queue->push(*val); 
+    NOELLE_DSWPQueuePush(queue, val);
 
     #ifdef DSWP_STATS
     numberOfPushes16++;
@@ -175,11 +524,11 @@ extern "C" {
   }
 
   void queuePop16(ThreadSafeQueue<int16_t> *queue, int16_t *val) { 
-    queue->waitPop(*val);
+    NOELLE_DSWPQueuePop(queue, val);
   }
 
   void queuePush32(ThreadSafeQueue<int32_t> *queue, int32_t *val) { 
-    queue->push(*val); 
+    NOELLE_DSWPQueuePush(queue, val);
 
     #ifdef DSWP_STATS
     numberOfPushes32++;
@@ -189,11 +538,11 @@ extern "C" {
   }
 
   void queuePop32(ThreadSafeQueue<int32_t> *queue, int32_t *val) { 
-    queue->waitPop(*val);
+    NOELLE_DSWPQueuePop(queue, val);
   }
 
   void queuePush64(ThreadSafeQueue<int64_t> *queue, int64_t *val) { 
-    queue->push(*val); 
+    NOELLE_DSWPQueuePush(queue, val);
 
     #ifdef DSWP_STATS
     numberOfPushes64++;
@@ -203,7 +552,7 @@ extern "C" {
   }
 
   void queuePop64(ThreadSafeQueue<int64_t> *queue, int64_t *val) { 
-    queue->waitPop(*val); 
+    NOELLE_DSWPQueuePop(queue, val);
 
     return ;
   }
@@ -221,11 +570,21 @@ extern "C" {
      * Fetch the arguments.
      */
     auto DOALLArgs = (DOALL_args_t *) args;
+    uint64_t countersAtStart[NOELLE_PERF_EVENTS];
+    performanceCounters.read(countersAtStart);
 
     /*
      * Invoke
      */
+    uint64_t taskStart = 0;
+    if (loopFeedback.isEnabled()){
+      taskStart = NoelleLoopFeedback::getCurrentTime();
+    }
     DOALLArgs->parallelizedLoop(DOALLArgs->env, DOALLArgs->coreID, DOALLArgs->numCores, DOALLArgs->chunkSize);
+    if (loopFeedback.isEnabled()){
+      DOALLArgs->taskTime = NoelleLoopFeedback::getCurrentTime() - taskStart;
+    }
+    performanceCounters.accumulate(DOALLArgs->loopID, countersAtStart);
     #ifdef RUNTIME_PROFILE
     auto clocks_end = rdtsc_e();
     clocks_starts[DOALLArgs->coreID] = clocks_start;
@@ -236,19 +595,22 @@ extern "C" {
     return ;
   }
 
-  DispatcherInfo NOELLE_DOALLDispatcher (
+  static DOALL_args_t * NOELLE_DOALLSubmit (
     void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t), 
     void *env, 
     int64_t maxNumberOfCores, 
-    int64_t chunkSize
+    int64_t chunkSize,
+    uint32_t *numCoresReserved,
+    uint32_t *doallMemoryIndex
     ){
-    #ifdef RUNTIME_PROFILE
-    auto clocks_start = rdtsc_s();
-    #endif
 
     /*
      * Set the number of cores to use.
      */
+    uint64_t submissionTime = 0;
+    if (loopFeedback.isEnabled()){
+      submissionTime = NoelleLoopFeedback::getCurrentTime();
+    }
     auto numCores = runtime.reserveCores(maxNumberOfCores);
     #ifdef RUNTIME_PRINT
     std::cerr << "Starting dispatcher: num cores " << numCores << ", chunk size: " << chunkSize << std::endl;
@@ -257,8 +619,8 @@ extern "C" {
     /*
      * Allocate the memory to store the arguments.
      */
-    uint32_t doallMemoryIndex;
-    auto argsForAllCores = runtime.getDOALLArgs(numCores, &doallMemoryIndex);
+    auto argsForAllCores = runtime.getDOALLArgs(numCores, doallMemoryIndex);
+    performanceCounters.countInvocation(currentLoopID);
 
     /*
      * Submit DOALL tasks.
@@ -273,6 +635,8 @@ extern "C" {
       argsPerCore->env = env;
       argsPerCore->numCores = numCores;
       argsPerCore->chunkSize = chunkSize;
+      argsPerCore->loopID = currentLoopID;
+      argsPerCore->submissionTime = submissionTime;
 
       /*
        * Submit
@@ -285,22 +649,63 @@ extern "C" {
     #ifdef RUNTIME_PRINT
     std::cerr << "Submitted pool" << std::endl;
     #endif
-    #ifdef RUNTIME_PROFILE
-    auto clocks_after_fork = rdtsc_e();
-    #endif
+
+    (*numCoresReserved) = numCores;
+    return argsForAllCores;
+  }
+
+  static void NOELLE_DOALLWait (
+    DOALL_args_t *argsForAllCores,
+    uint32_t numCores
+    ){
 
     /*
      * Wait for DOALL tasks.
      */
-    #ifdef RUNTIME_PROFILE
-    auto clocks_before_join = rdtsc_s();
-    #endif
     for (auto i = 0; i < numCores; ++i) {
       pthread_mutex_lock(&(argsForAllCores[i].endLock));
     }
     #ifdef RUNTIME_PRINT
     std::cerr << "All tasks completed" << std::endl;
     #endif
+
+    /*
+     * Record how the tasks performed.
+     */
+    if (loopFeedback.isEnabled()){
+      loopFeedback.recordDOALLInvocation(argsForAllCores, numCores, NoelleLoopFeedback::getCurrentTime());
+    }
+
+    return ;
+  }
+
+  DispatcherInfo NOELLE_DOALLDispatcher (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t), 
+    void *env, 
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize
+    ){
+    #ifdef RUNTIME_PROFILE
+    auto clocks_start = rdtsc_s();
+    #endif
+
+    /*
+     * Submit DOALL tasks.
+     */
+    uint32_t numCores;
+    uint32_t doallMemoryIndex;
+    auto argsForAllCores = NOELLE_DOALLSubmit(parallelizedLoop, env, maxNumberOfCores, chunkSize, &numCores, &doallMemoryIndex);
+    #ifdef RUNTIME_PROFILE
+    auto clocks_after_fork = rdtsc_e();
+    #endif
+
+    /*
+     * Wait for DOALL tasks.
+     */
+    #ifdef RUNTIME_PROFILE
+    auto clocks_before_join = rdtsc_s();
+    #endif
+    NOELLE_DOALLWait(argsForAllCores, numCores);
     #ifdef RUNTIME_PROFILE
     auto clocks_after_join = rdtsc_e();
     auto clocks_before_cleanup = rdtsc_s();
@@ -365,56 +770,348 @@ extern "C" {
     return dispatcherInfo;
   }
 
-  #ifdef RUNTIME_PRINT
-  void *mySSGlobal = nullptr;
-  #endif
-
-
-  /**********************************************************************
-   *                HELIX
-   **********************************************************************/
   typedef struct {
-    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *);
-    void *env ;
-    void *loopCarriedArray;
-    void *ssArrayPast;
-    void *ssArrayFuture;
-    uint64_t coreID;
-    uint64_t numCores;
-    uint64_t *loopIsOverFlag;
-  } NOELLE_HELIX_args_t ;
+    DOALL_args_t *argsForAllCores;
+    uint32_t numCores;
+    uint32_t doallMemoryIndex;
+  } NOELLE_DOALL_handle_t ;
 
-  static void NOELLE_HELIXTrampoline (void *args){
+  void * NOELLE_DOALLDispatcherAsync (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t), 
+    void *env, 
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize
+    ){
 
     /*
-     * Fetch the arguments.
+     * Allocate the handle.
      */
-    auto HELIX_args = (NOELLE_HELIX_args_t *) args;
+    auto handle = (NOELLE_DOALL_handle_t *) malloc(sizeof(NOELLE_DOALL_handle_t));
+    if (handle == nullptr){
+      fprintf(stderr, "DOALL: dispatcher: ERROR = not enough memory to allocate the handle\n");
+      abort();
+    }
 
     /*
-     * Invoke
+     * Submit DOALL tasks.
      */
-    HELIX_args->parallelizedLoop(
-      HELIX_args->env, 
-      HELIX_args->loopCarriedArray, 
-      HELIX_args->ssArrayPast, 
-      HELIX_args->ssArrayFuture, 
-      HELIX_args->coreID,
-      HELIX_args->numCores,
-      HELIX_args->loopIsOverFlag
-      );
+    handle->argsForAllCores = NOELLE_DOALLSubmit(parallelizedLoop, env, maxNumberOfCores, chunkSize, &handle->numCores, &handle->doallMemoryIndex);
 
-    return ;
+    return handle;
   }
 
-  static void HELIX_helperThread (void *ssArray, uint32_t numOfsequentialSegments, uint64_t *theLoopIsOver){
-
-    while ((*theLoopIsOver) == 0){
+  DispatcherInfo NOELLE_DOALLJoin (
+    void *handle
+    ){
 
-      /*
-       * Prefetch all sequential segment cache lines of the current loop iteration.
-       */
-      for (auto i = 0 ; ((*theLoopIsOver) == 0) && (i < numOfsequentialSegments); i++){
+    /*
+     * Fetch the handle.
+     */
+    auto doallHandle = (NOELLE_DOALL_handle_t *) handle;
+    auto numCores = doallHandle->numCores;
+
+    /*
+     * Wait for DOALL tasks.
+     */
+    NOELLE_DOALLWait(doallHandle->argsForAllCores, numCores);
+
+    /*
+     * Free the cores and memory.
+     */
+    runtime.releaseCores(numCores);
+    runtime.releaseDOALLArgs(doallHandle->doallMemoryIndex);
+    free(doallHandle);
+
+    /*
+     * Prepare the return value.
+     */
+    DispatcherInfo dispatcherInfo;
+    dispatcherInfo.numberOfThreadsUsed = numCores;
+
+    return dispatcherInfo;
+  }
+
+  /**********************************************************************
+   *                Reduction of memory objects
+   **********************************************************************/
+  typedef struct {
+    int64_t sizeInBytes;
+    int64_t stride;
+    int64_t numberOfCopies;
+  } NOELLE_privateCopies_t ;
+
+  typedef struct {
+    void (*reducer)(void *, void *, int64_t);
+    char *firstCopy;
+    int64_t stride;
+    int64_t numberOfCopies;
+    char *destination;
+    int64_t offset;
+    int64_t sizeInBytes;
+  } NOELLE_reduction_args_t ;
+
+  static void NOELLE_reductionTrampoline (void *args){
+
+    /*
+     * Fetch the arguments.
+     */
+    auto reductionArgs = (NOELLE_reduction_args_t *) args;
+
+    /*
+     * Merge the block of every private copy into the original memory object.
+     */
+    for (auto i = 0; i < reductionArgs->numberOfCopies; i++){
+      auto source = reductionArgs->firstCopy + (i * reductionArgs->stride) + reductionArgs->offset;
+      reductionArgs->reducer(reductionArgs->destination + reductionArgs->offset, source, reductionArgs->sizeInBytes);
+    }
+
+    return ;
+  }
+
+  void * NOELLE_allocatePrivateCopies (
+    int64_t sizeInBytes,
+    int64_t numberOfCopies
+    ){
+
+    /*
+     * Every private copy starts at a new cache line to avoid false sharing between the threads updating them.
+     * The first cache line includes the description of the copies.
+     */
+    auto stride = ((sizeInBytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+    void *copies = nullptr;
+    if (posix_memalign(&copies, CACHE_LINE_SIZE, CACHE_LINE_SIZE + (stride * numberOfCopies)) != 0){
+      fprintf(stderr, "NOELLE: reduction: ERROR = not enough memory to allocate %ld private copies of %ld bytes\n", numberOfCopies, sizeInBytes);
+      abort();
+    }
+    auto copiesInfo = (NOELLE_privateCopies_t *) copies;
+    copiesInfo->sizeInBytes = sizeInBytes;
+    copiesInfo->stride = stride;
+    copiesInfo->numberOfCopies = numberOfCopies;
+
+    return copies;
+  }
+
+  void * NOELLE_initializePrivateCopy (
+    void *copies,
+    int64_t copyID,
+    void (*initializer)(void *, int64_t)
+    ){
+
+    /*
+     * Fetch the private copy.
+     */
+    auto copiesInfo = (NOELLE_privateCopies_t *) copies;
+    assert(copyID < copiesInfo->numberOfCopies);
+    auto copy = ((char *) copies) + CACHE_LINE_SIZE + (copyID * copiesInfo->stride);
+
+    /*
+     * Initialize it.
+     */
+    initializer(copy, copiesInfo->sizeInBytes);
+
+    return copy;
+  }
+
+  void NOELLE_reducePrivateCopies (
+    void *copies,
+    void *original,
+    void (*reducer)(void *, void *, int64_t),
+    int64_t numberOfCopiesUsed,
+    int64_t maxNumberOfCores
+    ){
+
+    /*
+     * Fetch the private copies.
+     */
+    auto copiesInfo = (NOELLE_privateCopies_t *) copies;
+    auto sizeInBytes = copiesInfo->sizeInBytes;
+    assert(numberOfCopiesUsed <= copiesInfo->numberOfCopies);
+
+    /*
+     * Split the memory object in blocks of cache lines.
+     * Small objects are merged by the current thread as the cost of submitting tasks would not be amortized.
+     */
+    auto cacheLines = (sizeInBytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE;
+    auto maxBlocks = (sizeInBytes + NOELLE_REDUCTION_MIN_BYTES_PER_CORE - 1) / NOELLE_REDUCTION_MIN_BYTES_PER_CORE;
+    auto numCores = std::min<int64_t>(std::max<int64_t>(maxBlocks, 1), std::max<int64_t>(maxNumberOfCores, 1));
+    uint32_t helperCores = 0;
+    if (numCores > 1){
+      helperCores = runtime.reserveCores(numCores - 1);
+      numCores = helperCores + 1;
+    }
+    auto cacheLinesPerBlock = (cacheLines + numCores - 1) / numCores;
+
+    /*
+     * Merge the blocks.
+     * The current thread merges the first one.
+     */
+    std::vector<NOELLE_reduction_args_t> argsForAllBlocks(numCores);
+    std::vector<MARC::TaskFuture<void>> localFutures;
+    for (auto i = numCores - 1; i >= 0; i--){
+      auto argsPerBlock = &argsForAllBlocks[i];
+      argsPerBlock->reducer = reducer;
+      argsPerBlock->firstCopy = ((char *) copies) + CACHE_LINE_SIZE;
+      argsPerBlock->stride = copiesInfo->stride;
+      argsPerBlock->numberOfCopies = numberOfCopiesUsed;
+      argsPerBlock->destination = (char *) original;
+      argsPerBlock->offset = std::min<int64_t>(i * cacheLinesPerBlock * CACHE_LINE_SIZE, sizeInBytes);
+      argsPerBlock->sizeInBytes = std::min<int64_t>(argsPerBlock->offset + (cacheLinesPerBlock * CACHE_LINE_SIZE), sizeInBytes) - argsPerBlock->offset;
+      if (i == 0){
+        NOELLE_reductionTrampoline(argsPerBlock);
+        continue ;
+      }
+      localFutures.push_back(pool.submit(NOELLE_reductionTrampoline, argsPerBlock));
+    }
+    for (auto& future : localFutures){
+      future.get();
+    }
+
+    /*
+     * Free the cores and memory.
+     */
+    if (helperCores > 0){
+      runtime.releaseCores(helperCores);
+    }
+    free(copies);
+
+    return ;
+  }
+
+  /**********************************************************************
+   *                Deterministic reduction of variables
+   **********************************************************************/
+  void * NOELLE_allocateChunkPartials (
+    int64_t numberOfPartials,
+    int64_t partialSizeInBytes,
+    void *identity
+    ){
+
+    /*
+     * The partials of a chunk are written once, when the chunk completes.
+     * Hence, they are packed together.
+     */
+    auto partials = (char *) malloc(numberOfPartials * partialSizeInBytes);
+    if (partials == nullptr){
+      fprintf(stderr, "NOELLE: reduction: ERROR = not enough memory to allocate %ld partials of %ld bytes\n", numberOfPartials, partialSizeInBytes);
+      abort();
+    }
+
+    /*
+     * Slots that are not written by any task must not change the result.
+     */
+    for (int64_t i = 0; i < numberOfPartials; i++){
+      memcpy(partials + (i * partialSizeInBytes), identity, partialSizeInBytes);
+    }
+
+    return partials;
+  }
+
+  void NOELLE_reduceChunkPartials (
+    void *partials,
+    int64_t numberOfPartials,
+    int64_t partialSizeInBytes,
+    void (*reducer)(void *, void *, int64_t),
+    void *result
+    ){
+
+    /*
+     * Combine the partials as the leaves of a balanced binary tree.
+     * The shape of the tree only depends on the number of chunks, so the floating point result does not depend on the cores that executed them.
+     * The spare slots are the rightmost leaves and they hold the identity, so they do not change how the partials of the chunks are combined.
+     */
+    auto firstPartial = (char *) partials;
+    for (int64_t distance = 1; distance < numberOfPartials; distance *= 2){
+      for (int64_t i = 0; (i + distance) < numberOfPartials; i += (2 * distance)){
+        reducer(firstPartial + (i * partialSizeInBytes), firstPartial + ((i + distance) * partialSizeInBytes), partialSizeInBytes);
+      }
+    }
+
+    /*
+     * Accumulate the root of the tree into the result.
+     */
+    if (numberOfPartials > 0){
+      reducer(result, firstPartial, partialSizeInBytes);
+    }
+
+    /*
+     * Free the memory.
+     */
+    free(partials);
+
+    return ;
+  }
+
+  /**********************************************************************
+   *                Private copies of heap objects
+   **********************************************************************/
+  void * NOELLE_acquirePrivateBuffer (
+    int64_t sizeInBytes
+    ){
+    return privateBufferPool.acquire(sizeInBytes);
+  }
+
+  void NOELLE_releasePrivateBuffer (
+    void *buffer
+    ){
+    privateBufferPool.release(buffer);
+
+    return ;
+  }
+
+  #ifdef RUNTIME_PRINT
+  void *mySSGlobal = nullptr;
+  #endif
+
+
+  /**********************************************************************
+   *                HELIX
+   **********************************************************************/
+  typedef struct {
+    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *);
+    void *env ;
+    void *loopCarriedArray;
+    void *ssArrayPast;
+    void *ssArrayFuture;
+    uint64_t coreID;
+    uint64_t numCores;
+    uint64_t *loopIsOverFlag;
+    uint64_t loopID;
+  } NOELLE_HELIX_args_t ;
+
+  static void NOELLE_HELIXTrampoline (void *args){
+
+    /*
+     * Fetch the arguments.
+     */
+    auto HELIX_args = (NOELLE_HELIX_args_t *) args;
+    uint64_t countersAtStart[NOELLE_PERF_EVENTS];
+    performanceCounters.read(countersAtStart);
+
+    /*
+     * Invoke
+     */
+    HELIX_args->parallelizedLoop(
+      HELIX_args->env, 
+      HELIX_args->loopCarriedArray, 
+      HELIX_args->ssArrayPast, 
+      HELIX_args->ssArrayFuture, 
+      HELIX_args->coreID,
+      HELIX_args->numCores,
+      HELIX_args->loopIsOverFlag
+      );
+    performanceCounters.accumulate(HELIX_args->loopID, countersAtStart);
+
+    return ;
+  }
+
+  static void HELIX_helperThread (void *ssArray, uint32_t numOfsequentialSegments, uint64_t *theLoopIsOver){
+
+    while ((*theLoopIsOver) == 0){
+
+      /*
+       * Prefetch all sequential segment cache lines of the current loop iteration.
+       */
+      for (auto i = 0 ; ((*theLoopIsOver) == 0) && (i < numOfsequentialSegments); i++){
 
         /*
          * Fetch the pointer.
@@ -524,6 +1221,7 @@ extern "C" {
      */
     NOELLE_HELIX_args_t *argsForAllCores;
     posix_memalign((void **)&argsForAllCores, CACHE_LINE_SIZE, sizeof(NOELLE_HELIX_args_t) * numCores);
+    performanceCounters.countInvocation(currentLoopID);
 
     /*
      * Launch threads
@@ -564,6 +1262,7 @@ extern "C" {
       argsPerCore->coreID = i;
       argsPerCore->numCores = numCores;
       argsPerCore->loopIsOverFlag = &loopIsOverFlag;
+      argsPerCore->loopID = currentLoopID;
 
       /*
        * Set the affinity for both the thread and its helper.
@@ -707,10 +1406,12 @@ extern "C" {
     stageFunctionPtr_t funcToInvoke;
     void *env;
     void *localQueues;
+    int64_t replicaID;
+    uint64_t loopID;
   } NOELLE_DSWP_args_t ;
 
-  void stageExecuter(void (*stage)(void *, void *), void *env, void *queues){ 
-    return stage(env, queues);
+  void stageExecuter(void (*stage)(void *, void *, int64_t), void *env, void *queues, int64_t replicaID){ 
+    return stage(env, queues, replicaID);
   }
 
   static void NOELLE_DSWPTrampoline (void *args){
@@ -719,19 +1420,228 @@ extern "C" {
      * Fetch the arguments.
      */
     auto DSWPArgs = (NOELLE_DSWP_args_t *) args;
+    uint64_t countersAtStart[NOELLE_PERF_EVENTS];
+    performanceCounters.read(countersAtStart);
 
     /*
      * Invoke
      */
-    DSWPArgs->funcToInvoke(DSWPArgs->env, DSWPArgs->localQueues);
+    DSWPArgs->funcToInvoke(DSWPArgs->env, DSWPArgs->localQueues, DSWPArgs->replicaID);
+    performanceCounters.accumulate(DSWPArgs->loopID, countersAtStart);
+
+    return ;
+  }
+
+  static void NOELLE_DSWPCooperativeStageEntry (void){
+
+    /*
+     * Fetch the stage to run.
+     */
+    auto stage = currentDSWPWorker->currentStage;
+
+    /*
+     * Invoke
+     */
+    stage->stage(stage->env, stage->localQueues, stage->replicaID);
+
+    /*
+     * The stage is over.
+     * Returning gives the control back to the scheduler of the worker (see uc_link).
+     */
+    stage->isOver = true;
+
+    return ;
+  }
+
+  static void NOELLE_DSWPCooperativeTrampoline (void *args){
+
+    /*
+     * Fetch the arguments.
+     */
+    auto worker = (NOELLE_DSWP_worker_t *) args;
+    currentDSWPWorker = worker;
+    uint64_t countersAtStart[NOELLE_PERF_EVENTS];
+    performanceCounters.read(countersAtStart);
+
+    /*
+     * Create the user-level context of each stage.
+     */
+    for (auto i = 0; i < worker->numberOfStages; ++i) {
+      auto stage = &worker->stages[i];
+      stage->isOver = false;
+      stage->pushesSinceLastYield = 0;
+      stage->stack = malloc(DSWP_COOPERATIVE_STAGE_STACK_SIZE);
+      if (stage->stack == nullptr){
+        fprintf(stderr, "NOELLE: DSWP: ERROR = not enough memory to allocate the stack of a cooperative stage (%d bytes)\n", DSWP_COOPERATIVE_STAGE_STACK_SIZE);
+        abort();
+      }
+      getcontext(&stage->context);
+      stage->context.uc_stack.ss_sp = stage->stack;
+      stage->context.uc_stack.ss_size = DSWP_COOPERATIVE_STAGE_STACK_SIZE;
+      stage->context.uc_link = &worker->schedulerContext;
+      makecontext(&stage->context, NOELLE_DSWPCooperativeStageEntry, 0);
+    }
+
+    /*
+     * Run the stages in round-robin until all of them are over.
+     * A stage runs until it waits for an empty queue, it pushed enough values, or it completes.
+     */
+    auto stagesLeft = worker->numberOfStages;
+    while (stagesLeft > 0){
+      for (auto i = 0; i < worker->numberOfStages; ++i) {
+        auto stage = &worker->stages[i];
+        if (stage->isOver){
+          continue ;
+        }
+        worker->currentStage = stage;
+        swapcontext(&worker->schedulerContext, &stage->context);
+        if (stage->isOver){
+          stagesLeft--;
+        }
+      }
+
+      /*
+       * The stages of this worker might be waiting for stages running on other workers.
+       */
+      if (stagesLeft > 0){
+        std::this_thread::yield();
+      }
+    }
+
+    /*
+     * Free the memory.
+     */
+    for (auto i = 0; i < worker->numberOfStages; ++i) {
+      free(worker->stages[i].stack);
+    }
+    currentDSWPWorker = nullptr;
+    performanceCounters.accumulate(worker->loopID, countersAtStart);
+
+    return ;
+  }
+
+  static void NOELLE_DSWPFreeQueues (
+    int64_t *queueSizes, 
+    void **localQueues,
+    int64_t numberOfQueues
+    ){
+    for (int i = 0; i < numberOfQueues; ++i) {
+      switch (queueSizes[i]) {
+        case 1:
+          delete (ThreadSafeLockFreeQueue<int8_t> *)(localQueues[i]);
+          break;
+        case 8:
+          delete (ThreadSafeLockFreeQueue<int8_t> *)(localQueues[i]);
+          break;
+        case 16:
+          delete (ThreadSafeLockFreeQueue<int16_t> *)(localQueues[i]);
+          break;
+        case 32:
+          delete (ThreadSafeLockFreeQueue<int32_t> *)(localQueues[i]);
+          break;
+        case 64:
+          delete (ThreadSafeLockFreeQueue<int64_t> *)(localQueues[i]);
+          break;
+      }
+    }
+
+    return ;
+  }
+
+  #ifdef DSWP_STATS
+  static void NOELLE_DSWPPrintStats (void){
+    std::cout << "DSWP: 1 Byte pushes = " << numberOfPushes8 << std::endl;
+    std::cout << "DSWP: 2 Bytes pushes = " << numberOfPushes16 << std::endl;
+    std::cout << "DSWP: 4 Bytes pushes = " << numberOfPushes32 << std::endl;
+    std::cout << "DSWP: 8 Bytes pushes = " << numberOfPushes64 << std::endl;
 
     return ;
   }
+  #endif
+
+  static DispatcherInfo NOELLE_DSWPCooperativeDispatcher (
+    void *env, 
+    int64_t *queueSizes, 
+    void **allStages, 
+    int64_t *replicaIDs, 
+    int64_t numberOfStages, 
+    int64_t numberOfQueues,
+    void **localQueues,
+    uint32_t numCores
+    ){
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Folding " << numberOfStages << " stages onto " << numCores << " workers" << std::endl;
+    #endif
+
+    /*
+     * Allocate the memory to store the stages and the workers.
+     */
+    auto allCooperativeStages = (NOELLE_DSWP_cooperativeStage_t *) malloc(sizeof(NOELLE_DSWP_cooperativeStage_t) * numberOfStages);
+    auto workers = (NOELLE_DSWP_worker_t *) malloc(sizeof(NOELLE_DSWP_worker_t) * numCores);
+
+    /*
+     * Assign consecutive stages to the same worker.
+     * This keeps most producer-consumer pairs of the pipeline within a worker, where a consumer that waits gives the control straight to its producer.
+     */
+    for (auto i = 0; i < numberOfStages; ++i) {
+      auto stage = &allCooperativeStages[i];
+      stage->stage = reinterpret_cast<stageFunctionPtr_t>(reinterpret_cast<long long>(allStages[i]));
+      stage->env = env;
+      stage->localQueues = (void *) localQueues;
+      stage->replicaID = replicaIDs[i];
+    }
+    uint32_t firstStage = 0;
+    for (auto w = 0; w < numCores; ++w) {
+      auto lastStage = ((w + 1) * numberOfStages) / numCores;
+      auto worker = &workers[w];
+      worker->stages = &allCooperativeStages[firstStage];
+      worker->numberOfStages = lastStage - firstStage;
+      worker->currentStage = nullptr;
+      worker->loopID = currentLoopID;
+      firstStage = lastStage;
+    }
+
+    /*
+     * Submit the workers.
+     */
+    std::vector<MARC::TaskFuture<void>> localFutures;
+    for (auto w = 0; w < numCores; ++w) {
+      localFutures.push_back(pool.submit(NOELLE_DSWPCooperativeTrampoline, (void *)&workers[w]));
+    }
+
+    /*
+     * Wait for the workers to complete.
+     */
+    for (auto& future : localFutures){
+      future.get();
+    }
+
+    /*
+     * Free the cores and memory.
+     */
+    runtime.releaseCores(numCores);
+    NOELLE_DSWPFreeQueues(queueSizes, localQueues, numberOfQueues);
+    free(workers);
+    free(allCooperativeStages);
+
+    #ifdef DSWP_STATS
+    NOELLE_DSWPPrintStats();
+    #endif
+
+    DispatcherInfo dispatcherInfo;
+    dispatcherInfo.numberOfThreadsUsed = numCores;
+    return dispatcherInfo;
+  }
 
+  /*
+   * Dispatch threads to run a DSWP loop.
+   * @stages includes one entry per instance of a stage: a stage replicated N times has N consecutive entries and the i-th of them runs with the replica ID stored in @replicaIDs[i].
+   */
   DispatcherInfo NOELLE_DSWPDispatcher (
     void *env, 
     int64_t *queueSizes, 
     void *stages, 
+    int64_t *replicaIDs, 
     int64_t numberOfStages, 
     int64_t numberOfQueues
     ){
@@ -744,6 +1654,7 @@ extern "C" {
      */
     auto numCores = runtime.reserveCores(numberOfStages);
     assert(numCores >= 1);
+    performanceCounters.countInvocation(currentLoopID);
 
     /*
      * Allocate the communication queues.
@@ -776,6 +1687,15 @@ extern "C" {
     std::cerr << "Made queues" << std::endl;
     #endif
 
+    /*
+     * Check if there are enough cores to run each stage in its own thread.
+     * If there are not, stages are folded onto as many workers as the cores we got and they run cooperatively.
+     */
+    auto allStages = (void **)stages;
+    if (numCores < numberOfStages){
+      return NOELLE_DSWPCooperativeDispatcher(env, queueSizes, allStages, replicaIDs, numberOfStages, numberOfQueues, localQueues, numCores);
+    }
+
     /*
      * Allocate the memory to store the arguments.
      */
@@ -785,7 +1705,6 @@ extern "C" {
      * Submit DSWP tasks
      */
     std::vector<MARC::TaskFuture<void>> localFutures;
-    auto allStages = (void **)stages;
     for (auto i = 0; i < numberOfStages; ++i) {
 
       /*
@@ -795,6 +1714,8 @@ extern "C" {
       argsPerCore->funcToInvoke = reinterpret_cast<stageFunctionPtr_t>(reinterpret_cast<long long>(allStages[i]));
       argsPerCore->env = env;
       argsPerCore->localQueues = (void *) localQueues;
+      argsPerCore->replicaID = replicaIDs[i];
+      argsPerCore->loopID = currentLoopID;
 
       /*
        * Submit
@@ -822,32 +1743,11 @@ extern "C" {
      * Free the cores and memory.
      */
     runtime.releaseCores(numCores);
-    for (int i = 0; i < numberOfQueues; ++i) {
-      switch (queueSizes[i]) {
-        case 1:
-          delete (ThreadSafeLockFreeQueue<int8_t> *)(localQueues[i]);
-          break;
-        case 8:
-          delete (ThreadSafeLockFreeQueue<int8_t> *)(localQueues[i]);
-          break;
-        case 16:
-          delete (ThreadSafeLockFreeQueue<int16_t> *)(localQueues[i]);
-          break;
-        case 32:
-          delete (ThreadSafeLockFreeQueue<int32_t> *)(localQueues[i]);
-          break;
-        case 64:
-          delete (ThreadSafeLockFreeQueue<int64_t> *)(localQueues[i]);
-          break;
-      }
-    }
+    NOELLE_DSWPFreeQueues(queueSizes, localQueues, numberOfQueues);
     free(argsForAllCores);
 
     #ifdef DSWP_STATS
-    std::cout << "DSWP: 1 Byte pushes = " << numberOfPushes8 << std::endl;
-    std::cout << "DSWP: 2 Bytes pushes = " << numberOfPushes16 << std::endl;
-    std::cout << "DSWP: 4 Bytes pushes = " << numberOfPushes32 << std::endl;
-    std::cout << "DSWP: 8 Bytes pushes = " << numberOfPushes64 << std::endl;
+    NOELLE_DSWPPrintStats();
     #endif
 
     DispatcherInfo dispatcherInfo;
@@ -983,3 +1883,378 @@ uint32_t NoelleRuntime::getMaximumNumberOfCores (void){
 
   return cores;
 }
+
+NoellePerformanceCounters::NoellePerformanceCounters()
+  : enabled{false}
+  , contentionEvent{-1}
+  {
+  pthread_spin_init(&this->lock, 0);
+
+  /*
+   * Check if the counters have been requested.
+   */
+  auto envVar = getenv("NOELLE_PERF_COUNTERS");
+  if (  false
+        || (envVar == nullptr)
+        || (strcmp(envVar, "0") == 0)
+    ){
+    return ;
+  }
+  this->enabled = true;
+
+  /*
+   * Fetch the model-specific event that counts the accesses to cache lines contended between cores.
+   */
+  auto contentionVar = getenv("NOELLE_PERF_CONTENTION_EVENT");
+  if (contentionVar != nullptr){
+    this->contentionEvent = strtoll(contentionVar, nullptr, 16);
+  }
+
+  return ;
+}
+
+NoellePerformanceCounters::~NoellePerformanceCounters(){
+  if (!this->enabled){
+    return ;
+  }
+
+  /*
+   * Print the summary.
+   */
+  pthread_spin_lock(&this->lock);
+  std::cerr << "NOELLE: Performance counters" << std::endl;
+  for (auto &loopCounters : this->loops){
+    auto &counters = loopCounters.second;
+    std::cerr << "NOELLE:   Loop " << loopCounters.first << ": invocations = " << counters.invocations;
+    for (auto i = 0; i < NOELLE_PERF_EVENTS; i++){
+      std::cerr << ", " << NOELLE_perfEventNames[i] << " = " << counters.values[i];
+    }
+    if (counters.values[0] > 0){
+      std::cerr << ", IPC = " << ((double)counters.values[1]) / ((double)counters.values[0]);
+    }
+    std::cerr << std::endl;
+  }
+  pthread_spin_unlock(&this->lock);
+
+  return ;
+}
+
+bool NoellePerformanceCounters::isEnabled (void) const {
+  return this->enabled;
+}
+
+void NoellePerformanceCounters::openCounters (void){
+  auto &worker = NoellePerformanceCounters::workerCounters;
+  worker.isOpened = true;
+  worker.leaderFD = -1;
+  for (auto i = 0; i < NOELLE_PERF_EVENTS; i++){
+    worker.indexes[i] = -1;
+  }
+
+  /*
+   * Describe the events.
+   */
+  uint32_t types[NOELLE_PERF_EVENTS] = {
+    PERF_TYPE_HARDWARE,
+    PERF_TYPE_HARDWARE,
+    PERF_TYPE_HARDWARE,
+    PERF_TYPE_HW_CACHE,
+    PERF_TYPE_RAW
+  };
+  uint64_t configs[NOELLE_PERF_EVENTS] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_CACHE_NODE | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    (uint64_t)this->contentionEvent
+  };
+
+  /*
+   * Open the group.
+   * The first event that can be opened becomes the leader of the group.
+   */
+  int32_t nextIndex = 0;
+  for (auto i = 0; i < NOELLE_PERF_EVENTS; i++){
+    if (  true
+          && (types[i] == PERF_TYPE_RAW)
+          && (this->contentionEvent < 0)
+      ){
+      continue ;
+    }
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = types[i];
+    attr.config = configs[i];
+    attr.disabled = (worker.leaderFD == -1) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    auto fd = syscall(__NR_perf_event_open, &attr, 0, -1, worker.leaderFD, 0);
+    if (fd < 0){
+      continue ;
+    }
+    if (worker.leaderFD == -1){
+      worker.leaderFD = fd;
+    }
+    worker.indexes[i] = nextIndex++;
+  }
+  if (worker.leaderFD == -1){
+    std::cerr << "NOELLE: WARNING: performance counters are not available to this thread (see /proc/sys/kernel/perf_event_paranoid)" << std::endl;
+    return ;
+  }
+
+  /*
+   * Start counting.
+   */
+  ioctl(worker.leaderFD, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(worker.leaderFD, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+  return ;
+}
+
+void NoellePerformanceCounters::read (uint64_t *values){
+  for (auto i = 0; i < NOELLE_PERF_EVENTS; i++){
+    values[i] = 0;
+  }
+  if (!this->enabled){
+    return ;
+  }
+
+  /*
+   * Open the counters of the current thread the first time they are needed.
+   */
+  auto &worker = NoellePerformanceCounters::workerCounters;
+  if (!worker.isOpened){
+    this->openCounters();
+  }
+  if (worker.leaderFD == -1){
+    return ;
+  }
+
+  /*
+   * Read the group.
+   */
+  uint64_t buffer[3 + NOELLE_PERF_EVENTS];
+  if (::read(worker.leaderFD, buffer, sizeof(buffer)) <= 0){
+    return ;
+  }
+  auto numberOfEvents = buffer[0];
+  auto timeEnabled = buffer[1];
+  auto timeRunning = buffer[2];
+
+  /*
+   * Scale the values if the group has not been always scheduled on the hardware counters (multiplexing).
+   */
+  auto scale = ((timeRunning > 0) && (timeRunning < timeEnabled)) ? (((double)timeEnabled) / ((double)timeRunning)) : 1;
+  for (auto i = 0; i < NOELLE_PERF_EVENTS; i++){
+    auto index = worker.indexes[i];
+    if (  false
+          || (index < 0)
+          || (index >= numberOfEvents)
+      ){
+      continue ;
+    }
+    values[i] = (uint64_t)(buffer[3 + index] * scale);
+  }
+
+  return ;
+}
+
+void NoellePerformanceCounters::accumulate (uint64_t loopID, uint64_t *startValues){
+  if (!this->enabled){
+    return ;
+  }
+
+  /*
+   * Read the counters at the end of the task.
+   */
+  uint64_t endValues[NOELLE_PERF_EVENTS];
+  this->read(endValues);
+
+  /*
+   * Aggregate.
+   */
+  pthread_spin_lock(&this->lock);
+  auto &counters = this->loops[loopID];
+  for (auto i = 0; i < NOELLE_PERF_EVENTS; i++){
+    if (endValues[i] > startValues[i]){
+      counters.values[i] += endValues[i] - startValues[i];
+    }
+  }
+  pthread_spin_unlock(&this->lock);
+
+  return ;
+}
+
+void NoellePerformanceCounters::countInvocation (uint64_t loopID){
+  if (!this->enabled){
+    return ;
+  }
+
+  pthread_spin_lock(&this->lock);
+  this->loops[loopID].invocations++;
+  pthread_spin_unlock(&this->lock);
+
+  return ;
+}
+
+NoelleLoopFeedback::NoelleLoopFeedback()
+  : fileName{nullptr}
+  {
+  pthread_spin_init(&this->lock, 0);
+
+  /*
+   * Check if the feedback has been requested.
+   */
+  this->fileName = getenv("NOELLE_FEEDBACK_FILE");
+
+  return ;
+}
+
+NoelleLoopFeedback::~NoelleLoopFeedback(){
+  if (!this->isEnabled()){
+    return ;
+  }
+
+  /*
+   * Fetch the feedback of the loops that have not been executed by this run.
+   */
+  std::map<uint64_t, std::string> otherLoops;
+  std::ifstream oldFile(this->fileName);
+  std::string line;
+  while (std::getline(oldFile, line)){
+    if (  false
+          || (line.size() == 0)
+          || (line[0] == '#')
+      ){
+      continue ;
+    }
+    auto loopID = strtoull(line.c_str(), nullptr, 10);
+    if (this->loops.find(loopID) == this->loops.end()){
+      otherLoops[loopID] = line;
+    }
+  }
+  oldFile.close();
+
+  /*
+   * Write the feedback.
+   */
+  std::ofstream newFile(this->fileName);
+  if (!newFile.is_open()){
+    std::cerr << "NOELLE: WARNING: the feedback file " << this->fileName << " cannot be written" << std::endl;
+    return ;
+  }
+  newFile << "# loopID cores chunkSize invocations imbalance speedup" << std::endl;
+  for (auto &loop : this->loops){
+    auto &feedback = loop.second;
+    auto imbalance = (feedback.averageTasksTime > 0) ? (feedback.slowestTasksTime / feedback.averageTasksTime) : 1;
+    auto speedup = (feedback.dispatcherTime > 0) ? (feedback.tasksTime / feedback.dispatcherTime) : 1;
+    newFile << loop.first << " " << feedback.cores << " " << feedback.chunkSize << " " << feedback.invocations << " " << imbalance << " " << speedup << std::endl;
+  }
+  for (auto &loop : otherLoops){
+    newFile << loop.second << std::endl;
+  }
+
+  return ;
+}
+
+bool NoelleLoopFeedback::isEnabled (void) const {
+  return this->fileName != nullptr;
+}
+
+uint64_t NoelleLoopFeedback::getCurrentTime (void){
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+void NoelleLoopFeedback::recordDOALLInvocation (
+  DOALL_args_t *argsForAllCores,
+  uint32_t numCores,
+  uint64_t endTime
+  ){
+
+  /*
+   * Compute the time of the tasks.
+   */
+  uint64_t slowestTask = 0;
+  uint64_t tasksTime = 0;
+  for (auto i = 0; i < numCores; i++){
+    auto taskTime = argsForAllCores[i].taskTime;
+    tasksTime += taskTime;
+    if (taskTime > slowestTask){
+      slowestTask = taskTime;
+    }
+  }
+
+  /*
+   * Aggregate.
+   */
+  auto loopID = argsForAllCores[0].loopID;
+  pthread_spin_lock(&this->lock);
+  auto &feedback = this->loops[loopID];
+  feedback.cores = numCores;
+  feedback.chunkSize = argsForAllCores[0].chunkSize;
+  feedback.invocations++;
+  feedback.slowestTasksTime += slowestTask;
+  feedback.averageTasksTime += ((double)tasksTime) / numCores;
+  feedback.tasksTime += tasksTime;
+  feedback.dispatcherTime += endTime - argsForAllCores[0].submissionTime;
+  pthread_spin_unlock(&this->lock);
+
+  return ;
+}
+
+NoellePrivateBufferPool::~NoellePrivateBufferPool(){
+  for (auto buffer : this->freeBuffers){
+    free(((char *) buffer) - CACHE_LINE_SIZE);
+  }
+
+  return ;
+}
+
+void * NoellePrivateBufferPool::acquire (int64_t sizeInBytes){
+
+  /*
+   * Reuse the first free buffer that is large enough.
+   */
+  for (auto it = this->freeBuffers.begin(); it != this->freeBuffers.end(); it++){
+    auto buffer = *it;
+    auto capacity = *((int64_t *)(((char *) buffer) - CACHE_LINE_SIZE));
+    if (capacity >= sizeInBytes){
+      this->freeBuffers.erase(it);
+      return buffer;
+    }
+  }
+
+  /*
+   * Allocate a new buffer.
+   */
+  void *memory = nullptr;
+  if (posix_memalign(&memory, CACHE_LINE_SIZE, CACHE_LINE_SIZE + sizeInBytes) != 0){
+    fprintf(stderr, "NOELLE: private buffers: ERROR = not enough memory to allocate %ld bytes\n", sizeInBytes);
+    abort();
+  }
+  *((int64_t *) memory) = sizeInBytes;
+
+  return ((char *) memory) + CACHE_LINE_SIZE;
+}
+
+void NoellePrivateBufferPool::release (void *buffer){
+
+  /*
+   * Keep the buffer for the next acquisitions.
+   */
+  if (this->freeBuffers.size() < NoellePrivateBufferPool::maximumNumberOfFreeBuffers){
+    this->freeBuffers.push_back(buffer);
+    return ;
+  }
+
+  /*
+   * There are enough free buffers already.
+   */
+  free(((char *) buffer) - CACHE_LINE_SIZE);
+
+  return ;
+}
@@ -40,9 +40,12 @@ patchInstallDir "noelle-meta-pdg-embed" ;
 patchInstallDir "noelle-meta-prof-embed" ;
 patchInstallDir "noelle-pdg-stats" ;
 patchInstallDir "noelle-loop-stats" ;
+patchInstallDir "noelle-predict-speedups" ;
 patchInstallDir "noelle-enable" ;
 patchInstallDir "noelle-deadcode" ;
 patchInstallDir "noelle-prof-coverage" ;
+patchInstallDir "noelle-prof-loops" ;
+patchInstallDir "noelle-meta-loop-prof-embed" ;
 patchInstallDir "noelle-config" ;
 patchInstallDir "noelle-simplification" ;
 patchInstallDir "noelle-codesize" ;
@@ -26,9 +26,10 @@ namespace llvm::noelle {
     LOOP_WHILIFIER_ID,
     SCEV_SIMPLIFICATION_ID,
     DEVIRTUALIZER_ID,
+    LOOP_ALIAS_VERSIONING_ID,
 
     First=DOALL_ID,
-    Last=DEVIRTUALIZER_ID
+    Last=LOOP_ALIAS_VERSIONING_ID
   };
 
   enum LoopDependenceInfoOptimization {
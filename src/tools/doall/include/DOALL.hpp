@@ -47,9 +47,37 @@ namespace llvm::noelle {
         Heuristics *h
       ) const override ;
 
+      /*
+       * Reduce floating point variables in an order that does not depend on the number of cores that execute the loop.
+       * Partial results are computed per chunk and they are combined in a fixed pairwise order.
+       */
+      void setDeterministicReductions (bool deterministicReductions) ;
+
+      /*
+       * Return the invocation of the NOELLE dispatcher emitted by the last loop parallelized.
+       * Return nullptr if the loop is dispatched by another runtime (e.g., OpenMP).
+       */
+      CallInst * getDispatcherCall (void) const ;
+
 
     protected:
       Function *taskDispatcher;
+      CallInst *dispatcherCall;
+      Function *allocatePrivateCopies;
+      Function *initializePrivateCopy;
+      Function *reducePrivateCopies;
+      Function *allocateChunkPartials;
+      Function *reduceChunkPartials;
+      bool deterministicReductions;
+      std::unordered_map<const ReducibleMemoryLocation *, Value *> privateCopiesOfMemoryLocations;
+      std::unordered_map<int, Value *> chunkPartialsOfLiveOutVariables;
+      std::unordered_map<int, Value *> chunkPartialsOfLiveOutVariablesInTask;
+      Value *numberOfChunkPartials;
+      Value *firstEarlyExitIteration;
+      Value *earlyExitRecords;
+      Value *firstEarlyExitIterationInTask;
+      Value *earlyExitRecordsInTask;
+      std::vector<int> liveOutVariablesOfEarlyExits;
 
       /*
        * DOALL specific generation
@@ -62,11 +90,126 @@ namespace llvm::noelle {
         Function *loopFunction,
         Noelle &par
       );
+      Value * invokeTaskWithOpenMP (
+        IRBuilder<> &builder,
+        Value *envPtr,
+        Value *numCores,
+        Value *chunkSize,
+        Noelle &par
+      );
+
+      /*
+       * Chunking
+       */
+      Value * generateCodeToComputeChunkSize (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        IRBuilder<> &builder
+      );
+      uint64_t computeChunkSizeAlignment (
+        LoopDependenceInfo *LDI
+      ) const ;
+      uint64_t computeMinimumChunkSize (
+        LoopDependenceInfo *LDI,
+        Noelle &par
+      ) const ;
+
+      /*
+       * Reduction of memory objects (e.g., histograms) through private copies
+       */
+      std::unordered_set<const ReducibleMemoryLocation *> fetchMemoryLocationsToReduce (
+        LoopDependenceInfo *LDI
+      ) const ;
+      void privatizeMemoryLocationsToReduce (
+        LoopDependenceInfo *LDI,
+        Noelle &par
+      );
+      void generateCodeToReduceMemoryLocations (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> &builder,
+        Value *numThreadsUsed,
+        Value *numCores
+      );
+      Function * createPrivateCopyInitializer (
+        const ReducibleMemoryLocation *location,
+        AccumulatorOpInfo &opInfo
+      );
+      Function * createPrivateCopyReducer (
+        const ReducibleMemoryLocation *location,
+        AccumulatorOpInfo &opInfo
+      );
+
+      /*
+       * Deterministic reduction of floating point variables through partial results per chunk
+       */
+      std::set<int> fetchLiveOutVariablesToReduceDeterministically (
+        LoopDependenceInfo *LDI
+      ) const ;
+      uint64_t computeDeterministicChunkSize (
+        LoopDependenceInfo *LDI
+      ) const ;
+      void allocateChunkPartialsOfLiveOutVariables (
+        LoopDependenceInfo *LDI,
+        Noelle &par
+      );
+      PHINode * rewireLiveOutVariablesToStoreChunkPartials (
+        LoopDependenceInfo *LDI,
+        PHINode *chunkPHI,
+        IRBuilder<> &entryBuilder
+      );
+      std::unordered_map<int, Value *> generateCodeToReduceChunkPartials (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> &builder
+      );
+      Function * createChunkPartialReducer (
+        Instruction *accumulator,
+        Type *partialType,
+        AccumulatorOpInfo &opInfo
+      );
+
+      /*
+       * Early exits taken cooperatively by the tasks
+       */
+      BasicBlock * fetchGoverningExitBlock (
+        LoopDependenceInfo *LDI
+      ) const ;
+      bool canEarlyExitsBeTakenCooperatively (
+        LoopDependenceInfo *LDI
+      ) const ;
+      bool isLoadDereferenceableInEveryIteration (
+        LoopDependenceInfo *LDI,
+        LoadInst *load
+      ) const ;
+      std::set<int> fetchLiveOutVariablesOfEarlyExits (
+        LoopDependenceInfo *LDI
+      ) const ;
+      void allocateEarlyExitRecords (
+        LoopDependenceInfo *LDI,
+        Noelle &par
+      );
+      PHINode * rewireEarlyExitsToRecordTheirIteration (
+        LoopDependenceInfo *LDI,
+        PHINode *chunkPHI,
+        IRBuilder<> &entryBuilder
+      );
+      void pollEarlyExitsAtChunkBoundaries (
+        LoopDependenceInfo *LDI,
+        PHINode *chunkPHI,
+        PHINode *iterationPHI
+      );
+      void generateCodeToSelectFirstEarlyExit (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> &builder
+      );
 
       /*
        * Helpers
        */
       Value *fetchClone(Value *original) const ;
+      bool areLoopCarriedDependencesBetweenDisjointMemoryAccesses (
+        LoopDependenceInfo *LDI,
+        SCC *scc
+      ) const ;
   };
 
 }
@@ -100,6 +100,16 @@ void DOALL::rewireLoopToIterateChunks (
     IVUtility::chunkInductionVariablePHI(preheaderClone, ivPHI, chunkPHI, chunkStepSize);
   }
 
+  /*
+   * Store the partial result per chunk of variables reduced deterministically
+   */
+  auto chunkIDPHI = this->rewireLiveOutVariablesToStoreChunkPartials(LDI, chunkPHI, entryBuilder);
+
+  /*
+   * Record the iteration of the early exits taken by the task
+   */
+  auto iterationPHI = this->rewireEarlyExitsToRecordTheirIteration(LDI, chunkPHI, entryBuilder);
+
   /*
    * The exit condition needs to be made non-strict to catch iterating past it
    */
@@ -107,7 +117,8 @@ void DOALL::rewireLoopToIterateChunks (
   LoopGoverningIVUtility ivUtility(loopGoverningIVAttr->getInductionVariable(), *loopGoverningIVAttr);
   auto cmpInst = cast<CmpInst>(task->getCloneOfOriginalInstruction(loopGoverningIVAttr->getHeaderCmpInst()));
   auto brInst = cast<BranchInst>(task->getCloneOfOriginalInstruction(loopGoverningIVAttr->getHeaderBrInst()));
-  ivUtility.updateConditionAndBranchToCatchIteratingPastExitValue(cmpInst, brInst, task->getLastBlock(0));
+  auto governingExitBlockClone = task->getCloneOfOriginalBasicBlock(this->fetchGoverningExitBlock(LDI));
+  ivUtility.updateConditionAndBranchToCatchIteratingPastExitValue(cmpInst, brInst, governingExitBlockClone);
   auto updatedCmpInst = cmpInst;
 
   /*
@@ -163,7 +174,7 @@ void DOALL::rewireLoopToIterateChunks (
   /*
 	 * Identify any instructions in the header that are NOT sensitive to the number of times they execute:
 	 * 1) IV instructions, including the comparison and branch of the loop governing IV
-	 * 2) The PHI used to chunk iterations 
+	 * 2) The PHIs used to chunk iterations 
 	 * 3) Any PHIs of reducible variables
 	 * 4) Any loop invariant instructions that belong to independent-execution SCCs
    */
@@ -186,6 +197,12 @@ void DOALL::rewireLoopToIterateChunks (
 	 * Collect (2)
 	 */
   repeatableInstructions.insert(chunkPHI);
+  if (chunkIDPHI != nullptr) {
+    repeatableInstructions.insert(chunkIDPHI);
+  }
+  if (iterationPHI != nullptr) {
+    repeatableInstructions.insert(iterationPHI);
+  }
 
 	/*
 	 * Collect (3) by identifying all reducible SCCs
@@ -251,7 +268,7 @@ void DOALL::rewireLoopToIterateChunks (
       auto clonedCmpInst = updatedCmpInst->clone();
       clonedCmpInst->replaceUsesOfWith(loopGoverningPHI, prevIterationValue);
       latchBuilder.Insert(clonedCmpInst);
-      latchBuilder.CreateCondBr(clonedCmpInst, task->getLastBlock(0), headerClone);
+      latchBuilder.CreateCondBr(clonedCmpInst, governingExitBlockClone, headerClone);
     }
 
     /*
@@ -277,4 +294,11 @@ void DOALL::rewireLoopToIterateChunks (
       headerClone
     );
   }
+
+  /*
+   * Stop executing chunks when another task exited the loop at an earlier iteration
+   */
+  this->pollEarlyExitsAtChunkBoundaries(LDI, chunkPHI, iterationPHI);
+
+  return ;
 }
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+uint64_t DOALL::computeChunkSizeAlignment (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * Fetch the loop.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
+  auto &DL = this->module.getDataLayout();
+  auto cacheLineBytes = (uint64_t)Architecture::getCacheLineBytes();
+
+  /*
+   * Consecutive chunks run on different cores.
+   * Hence, a chunk must write whole cache lines for every store that walks through memory with the iterations of the loop.
+   * Otherwise, the cores write the same cache lines at the boundaries of the chunks (false sharing).
+   */
+  uint64_t alignment = 1;
+  for (auto inst : loopStructure->getInstructions()){
+    auto store = dyn_cast<StoreInst>(inst);
+    if (store == nullptr){
+      continue ;
+    }
+
+    /*
+     * Fetch the number of bytes between the locations written by consecutive iterations.
+     */
+    auto stride = domainSpaceAnalysis->getStrideOfMemoryAccessBetweenIterations(store);
+    if (stride == 0){
+      continue ;
+    }
+    auto absStride = (uint64_t)std::abs(stride);
+    auto storeBytes = DL.getTypeStoreSize(store->getValueOperand()->getType());
+    if (absStride < storeBytes){
+      continue ;
+    }
+
+    /*
+     * Compute the number of iterations that write a whole number of cache lines.
+     */
+    auto iterationsPerLines = cacheLineBytes / std::gcd(cacheLineBytes, absStride);
+    alignment = std::lcm(alignment, iterationsPerLines);
+  }
+
+  return alignment;
+}
+
+uint64_t DOALL::computeMinimumChunkSize (
+  LoopDependenceInfo *LDI,
+  Noelle &par
+) const {
+
+  /*
+   * Fetch the loop.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto profiles = par.getProfiles();
+
+  /*
+   * Estimate the cost of a single iteration.
+   *
+   * When profiles are available, we use the average number of instructions executed per iteration (callees included).
+   * Otherwise, we fall back to the static number of instructions of the loop body.
+   */
+  double instsPerIteration = 0;
+  if (profiles->isAvailable()){
+    instsPerIteration = profiles->getAverageTotalInstructionsPerIteration(loopStructure);
+  }
+  if (  false
+        || (instsPerIteration < 1)
+        || std::isinf(instsPerIteration)
+    ){
+    instsPerIteration = (double)profiles->getStaticInstructions(loopStructure);
+  }
+  if (instsPerIteration < 1){
+    instsPerIteration = 1;
+  }
+
+  /*
+   * A chunk must execute enough instructions to amortize the jump to the next chunk of the task.
+   */
+  double minimumInstructionsPerChunk = 100;
+  auto minimumChunkSize = (uint64_t)std::ceil(minimumInstructionsPerChunk / instsPerIteration);
+
+  return std::max(minimumChunkSize, (uint64_t)1);
+}
+
+Value * DOALL::generateCodeToComputeChunkSize (
+  LoopDependenceInfo *LDI,
+  Noelle &par,
+  IRBuilder<> &builder
+) {
+
+  /*
+   * Check if floating point variables are reduced deterministically.
+   * In this case, the chunk size cannot be tuned as the partial results depend on it.
+   */
+  if (this->chunkPartialsOfLiveOutVariables.size() > 0){
+    auto chunkSize = this->computeDeterministicChunkSize(LDI);
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   Chunk size = " << chunkSize << " (fixed for deterministic reductions)\n";
+    }
+    return ConstantInt::get(par.int64, chunkSize);
+  }
+
+  /*
+   * Check if the chunk size has been chosen by the user (e.g., INDEX_FILE).
+   */
+  if (LDI->hasUserDefinedDOALLChunkSize){
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   Chunk size = " << LDI->DOALLChunkSize << "\n";
+    }
+    return ConstantInt::get(par.int64, LDI->DOALLChunkSize);
+  }
+
+  /*
+   * Fetch the loop.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto profiles = par.getProfiles();
+  auto cores = LDI->getMaximumNumberOfCores();
+
+  /*
+   * Compute the bounds of the chunk size.
+   */
+  auto alignment = this->computeChunkSizeAlignment(LDI);
+  auto minimumChunkSize = this->computeMinimumChunkSize(LDI, par);
+  auto alignUp = [alignment](uint64_t chunkSize) -> uint64_t {
+    return ((chunkSize + alignment - 1) / alignment) * alignment;
+  };
+
+  /*
+   * Every core should execute several chunks per invocation to balance the load between the cores.
+   */
+  uint64_t chunksPerCore = 4;
+
+  /*
+   * Check if the number of iterations per invocation is stable across invocations.
+   * In this case, the chunk size can be computed at compile time.
+   */
+  auto isTripCountStable = false;
+  double iterationsPerInvocation = 0;
+  if (  true
+        && profiles->isAvailable()
+        && (profiles->getInvocations(loopStructure) > 0)
+    ){
+    iterationsPerInvocation = profiles->getAverageLoopIterationsPerInvocation(loopStructure);
+    isTripCountStable = true;
+    if (profiles->hasLoopIterationsDistribution(loopStructure)){
+      auto lowTripCount = profiles->getLoopIterationsPercentile(loopStructure, 10);
+      auto highTripCount = profiles->getLoopIterationsPercentile(loopStructure, 90);
+      isTripCountStable = highTripCount <= (2 * lowTripCount);
+    }
+  }
+  if (isTripCountStable){
+    auto balancedChunkSize = (uint64_t)(iterationsPerInvocation / (cores * chunksPerCore));
+    auto chunkSize = alignUp(std::max(balancedChunkSize, minimumChunkSize));
+    LDI->DOALLChunkSize = chunkSize;
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   Chunk size = " << chunkSize << " (" << iterationsPerInvocation << " iterations per invocation, chunks aligned to " << alignment << " iterations)\n";
+    }
+    return ConstantInt::get(par.int64, chunkSize);
+  }
+
+  /*
+   * The trip count changes across invocations.
+   * Compute the chunk size at run time from the trip count of the current invocation.
+   */
+  auto tripCount = IVUtility::generateCodeToComputeTripCount(loopStructure, LDI->getLoopGoverningIVAttribution(), builder);
+  if (tripCount == nullptr){
+    auto chunkSize = alignUp(std::max((uint64_t)LDI->DOALLChunkSize, minimumChunkSize));
+    LDI->DOALLChunkSize = chunkSize;
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   Chunk size = " << chunkSize << " (chunks aligned to " << alignment << " iterations)\n";
+    }
+    return ConstantInt::get(par.int64, chunkSize);
+  }
+  auto balancedChunkSize = builder.CreateUDiv(tripCount, ConstantInt::get(par.int64, cores * chunksPerCore));
+  auto minimumChunkSizeValue = ConstantInt::get(par.int64, minimumChunkSize);
+  auto isTooSmall = builder.CreateICmpULT(balancedChunkSize, minimumChunkSizeValue);
+  Value *chunkSize = builder.CreateSelect(isTooSmall, minimumChunkSizeValue, balancedChunkSize);
+  if (alignment > 1){
+    auto alignmentValue = ConstantInt::get(par.int64, alignment);
+    auto roundedChunkSize = builder.CreateAdd(chunkSize, ConstantInt::get(par.int64, alignment - 1));
+    chunkSize = builder.CreateMul(builder.CreateUDiv(roundedChunkSize, alignmentValue), alignmentValue);
+  }
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << "DOALL:   Chunk size = trip count / " << (cores * chunksPerCore) << " (at least " << minimumChunkSize << ", aligned to " << alignment << " iterations)\n";
+  }
+
+  return chunkSize;
+}
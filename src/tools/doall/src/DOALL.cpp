@@ -31,6 +31,27 @@ DOALL::DOALL (
     abort();
   }
 
+  /*
+   * Fetch the runtime functions used to reduce private copies of memory objects.
+   * Memory objects are not reduced if the runtime does not provide them.
+   */
+  this->allocatePrivateCopies = this->module.getFunction("NOELLE_allocatePrivateCopies");
+  this->initializePrivateCopy = this->module.getFunction("NOELLE_initializePrivateCopy");
+  this->reducePrivateCopies = this->module.getFunction("NOELLE_reducePrivateCopies");
+
+  /*
+   * Fetch the runtime functions used to reduce floating point variables deterministically.
+   */
+  this->allocateChunkPartials = this->module.getFunction("NOELLE_allocateChunkPartials");
+  this->reduceChunkPartials = this->module.getFunction("NOELLE_reduceChunkPartials");
+  this->deterministicReductions = false;
+  this->numberOfChunkPartials = nullptr;
+  this->firstEarlyExitIteration = nullptr;
+  this->earlyExitRecords = nullptr;
+  this->firstEarlyExitIterationInTask = nullptr;
+  this->earlyExitRecordsInTask = nullptr;
+  this->dispatcherCall = nullptr;
+
   /*
    * Define the signature of the task, which will be invoked by the DOALL dispatcher.
    */
@@ -63,9 +84,13 @@ bool DOALL::canBeAppliedToLoop (
   auto loopStructure = LDI->getLoopStructure();
 
   /*
-   * The loop must have one single exit path.
+   * The loop must have one single exit path, or the tasks must be able to take its other exits cooperatively.
    */
-  if (loopStructure->numberOfExitBasicBlocks() > 1){ 
+  auto hasEarlyExits = loopStructure->numberOfExitBasicBlocks() > 1;
+  if (  true
+        && hasEarlyExits
+        && (!this->canEarlyExitsBeTakenCooperatively(LDI))
+    ){ 
     if (this->verbose != Verbosity::Disabled) {
       errs() << "DOALL:   More than 1 loop exit blocks\n";
     }
@@ -74,9 +99,13 @@ bool DOALL::canBeAppliedToLoop (
 
   /*
    * The loop must have all live-out variables to be reducable.
+   * The live-out variables of loops with early exits have been checked already.
    */
   auto sccManager = LDI->getSCCManager();
-  if (!sccManager->areAllLiveOutValuesReducable(LDI->environment)) {
+  if (  true
+        && (!hasEarlyExits)
+        && (!sccManager->areAllLiveOutValuesReducable(LDI->environment))
+    ){
     if (this->verbose != Verbosity::Disabled) {
       errs() << "DOALL:   Some post environment value is not reducable\n";
     }
@@ -162,31 +191,39 @@ bool DOALL::canBeAppliedToLoop (
      * If all loop carried data dependencies within the SCC do not overlap between
      * iterations, then DOALL can ignore them
      */
-    auto areAllDataLCDsFromDisjointMemoryAccesses = true;
-    auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
-    sccManager->iterateOverLoopCarriedDataDependences(scc, [
-      &areAllDataLCDsFromDisjointMemoryAccesses, domainSpaceAnalysis
-    ](DGEdge<Value> *dep) -> bool {
-      if (dep->isControlDependence()) return false;
-
-      if (!dep->isMemoryDependence()) {
-        areAllDataLCDsFromDisjointMemoryAccesses = false;
-        return true;
-      }
-
-      auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
-      auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
-      areAllDataLCDsFromDisjointMemoryAccesses &= fromInst && toInst && domainSpaceAnalysis->
-        areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst);
-      return !areAllDataLCDsFromDisjointMemoryAccesses;
-    });
-    if (areAllDataLCDsFromDisjointMemoryAccesses) {
+    if (this->areLoopCarriedDependencesBetweenDisjointMemoryAccesses(LDI, scc)) {
       // if (this->verbose >= Verbosity::Maximal) {
       //   scc->printMinimal(errs() << "SCC has memory LCDs that are disjoint between iterations!\n"); errs() << "\n";
       // }
       continue;
     }
 
+    /*
+     * If the SCC can be removed by reducing private copies of memory objects (e.g., histograms), then we can ignore it.
+     * Private copies are merged in the order of the cores that computed them.
+     * Hence, floating point objects cannot be reduced this way when the reductions must be deterministic.
+     */
+    auto areFloatingPointObjectsReduced = false;
+    if (sccInfo->canBeReducedUsingPrivateMemoryLocations()){
+      for (auto location : sccInfo->getMemoryLocationsToReduce()){
+        if (location->getElementType()->isFloatingPointTy()){
+          areFloatingPointObjectsReduced = true;
+        }
+      }
+    }
+    if (  true
+          && sccInfo->canBeReducedUsingPrivateMemoryLocations()
+          && (this->allocatePrivateCopies != nullptr)
+          && (this->initializePrivateCopy != nullptr)
+          && (this->reducePrivateCopies != nullptr)
+          && (!this->deterministicReductions || !areFloatingPointObjectsReduced)
+      ){
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL:   Memory objects of an SCC will be reduced through private copies\n";
+      }
+      continue ;
+    }
+
     if (this->verbose != Verbosity::Disabled) {
       errs() << "DOALL:   We found an SCC of type " << sccInfo->getType() << " of the loop that is non clonable and non commutative\n" ;
       if (this->verbose >= Verbosity::Maximal) {
@@ -209,6 +246,23 @@ bool DOALL::canBeAppliedToLoop (
     return false;
   }
 
+  /*
+   * Floating point variables reduced deterministically need the number of chunks of an invocation before dispatching it.
+   */
+  auto deterministicVariables = this->fetchLiveOutVariablesToReduceDeterministically(LDI);
+  if (deterministicVariables.size() > 0){
+    if (  false
+          || (this->allocateChunkPartials == nullptr)
+          || (this->reduceChunkPartials == nullptr)
+          || (!IVUtility::canComputeTripCount(loopStructure, loopGoverningIVAttr))
+      ){
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL:   Floating point variables cannot be reduced deterministically\n";
+      }
+      return false;
+    }
+  }
+
   /*
    * The loop is a DOALL one.
    */
@@ -244,10 +298,10 @@ bool DOALL::apply (
   /*
    * Print the parallelization request.
    */
+  this->privateCopiesOfMemoryLocations.clear();
   if (this->verbose != Verbosity::Disabled) {
     errs() << "DOALL: Start the parallelization\n";
     errs() << "DOALL:   Number of threads to extract = " << LDI->getMaximumNumberOfCores() << "\n";
-    errs() << "DOALL:   Chunk size = " << LDI->DOALLChunkSize << "\n";
   }
 
   /*
@@ -259,11 +313,24 @@ bool DOALL::apply (
 
   /*
    * Allocate memory for all environment variables
+   *
+   * Live-out variables of early exits are not reduced: the value of the task that takes the first exit is the one propagated.
    */
   auto preEnvRange = loopEnvironment->getEnvIndicesOfLiveInVars();
   auto postEnvRange = loopEnvironment->getEnvIndicesOfLiveOutVars();
+  auto earlyExitVars = this->fetchLiveOutVariablesOfEarlyExits(LDI);
   std::set<int> nonReducableVars(preEnvRange.begin(), preEnvRange.end());
-  std::set<int> reducableVars(postEnvRange.begin(), postEnvRange.end());
+  std::set<int> reducableVars;
+  for (auto envIndex : postEnvRange){
+    if (earlyExitVars.find(envIndex) != earlyExitVars.end()){
+      nonReducableVars.insert(envIndex);
+    } else {
+      reducableVars.insert(envIndex);
+    }
+  }
+  if (loopStructure->numberOfExitBasicBlocks() > 1) {
+    nonReducableVars.insert(loopEnvironment->indexOfExitBlockTaken());
+  }
   this->initializeEnvironmentBuilder(LDI, nonReducableVars, reducableVars);
 
   /*
@@ -282,6 +349,9 @@ bool DOALL::apply (
     envUser->addLiveInIndex(envIndex);
   }
   for (auto envIndex : loopEnvironment->getEnvIndicesOfLiveOutVars()) {
+    if (earlyExitVars.find(envIndex) != earlyExitVars.end()){
+      continue ;
+    }
     envUser->addLiveOutIndex(envIndex);
   }
   this->generateCodeToLoadLiveInVariables(LDI, 0);
@@ -294,6 +364,22 @@ bool DOALL::apply (
     this->cloneMemoryLocationsLocallyAndRewireLoop(LDI, 0);
   }
 
+  /*
+   * Redirect the updates of memory objects that are reduced to the private copy of the task.
+   * Like the cloning of memory locations, this overrides the live-in mapping.
+   */
+  this->privatizeMemoryLocationsToReduce(LDI, par);
+
+  /*
+   * Allocate the partial results per chunk of floating point variables that are reduced deterministically.
+   */
+  this->allocateChunkPartialsOfLiveOutVariables(LDI, par);
+
+  /*
+   * Allocate the records of the early exits taken by the tasks.
+   */
+  this->allocateEarlyExitRecords(LDI, par);
+
   /*
    * Fix the data flow within the parallelized loop by redirecting operands of
    * cloned instructions to refer to the other cloned instructions. Currently,
@@ -349,6 +435,10 @@ bool DOALL::apply (
   return true;
 }
 
+CallInst * DOALL::getDispatcherCall (void) const {
+  return this->dispatcherCall;
+}
+
 void DOALL::addChunkFunctionExecutionAsideOriginalLoop (
   LoopDependenceInfo *LDI,
   Function *loopFunction,
@@ -372,26 +462,48 @@ void DOALL::addChunkFunctionExecutionAsideOriginalLoop (
   auto numCores = ConstantInt::get(par.int64, LDI->getMaximumNumberOfCores());
 
   /*
-   * Fetch the chunk size.
+   * Compute the chunk size.
    */
-  auto chunkSize = ConstantInt::get(par.int64, LDI->DOALLChunkSize);
+  IRBuilder<> doallBuilder(this->entryPointOfParallelizedLoop);
+  auto chunkSize = this->generateCodeToComputeChunkSize(LDI, par, doallBuilder);
 
   /*
    * Call the function that incudes the parallelized loop.
    */
-  IRBuilder<> doallBuilder(this->entryPointOfParallelizedLoop);
-  auto doallCallInst = doallBuilder.CreateCall(this->taskDispatcher, ArrayRef<Value *>({
-    tasks[0]->getTaskBody(),
-    envPtr,
-    numCores,
-    chunkSize
-  }));
-  auto numThreadsUsed = doallBuilder.CreateExtractValue(doallCallInst, (uint64_t)0);
+  Value *numThreadsUsed = nullptr;
+  this->dispatcherCall = nullptr;
+  if (this->getParallelizationRuntime() == ParallelizationRuntime::OPENMP){
+    numThreadsUsed = this->invokeTaskWithOpenMP(doallBuilder, envPtr, numCores, chunkSize, par);
+
+  } else {
+    this->dispatcherCall = doallBuilder.CreateCall(this->taskDispatcher, ArrayRef<Value *>({
+      tasks[0]->getTaskBody(),
+      envPtr,
+      numCores,
+      chunkSize
+    }));
+    numThreadsUsed = doallBuilder.CreateExtractValue(this->dispatcherCall, (uint64_t)0);
+  }
+
+  /*
+   * Select the exit of the first iteration that exited the loop.
+   */
+  this->generateCodeToSelectFirstEarlyExit(LDI, doallBuilder);
+
+  /*
+   * Merge the private copies of the memory objects reduced into the original ones.
+   */
+  this->generateCodeToReduceMemoryLocations(LDI, doallBuilder, numThreadsUsed, numCores);
+
+  /*
+   * Combine the partial results per chunk of the variables reduced deterministically.
+   */
+  auto reducedLiveOutVariables = this->generateCodeToReduceChunkPartials(LDI, doallBuilder);
 
   /*
    * Propagate the last value of live-out variables to the code outside the parallelized loop.
    */
-  auto latestBBAfterDOALLCall = this->propagateLiveOutEnvironment(LDI, numThreadsUsed);
+  auto latestBBAfterDOALLCall = this->propagateLiveOutEnvironment(LDI, numThreadsUsed, reducedLiveOutVariables);
 
   /*
    * Jump to the unique successor of the loop.
@@ -415,3 +527,30 @@ Value * DOALL::fetchClone (Value *original) const {
   assert(iClone != nullptr);
   return iClone;
 }
+
+bool DOALL::areLoopCarriedDependencesBetweenDisjointMemoryAccesses (
+  LoopDependenceInfo *LDI,
+  SCC *scc
+) const {
+  auto sccManager = LDI->getSCCManager();
+  auto areAllDataLCDsFromDisjointMemoryAccesses = true;
+  auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
+  sccManager->iterateOverLoopCarriedDataDependences(scc, [
+    &areAllDataLCDsFromDisjointMemoryAccesses, domainSpaceAnalysis
+  ](DGEdge<Value> *dep) -> bool {
+    if (dep->isControlDependence()) return false;
+
+    if (!dep->isMemoryDependence()) {
+      areAllDataLCDsFromDisjointMemoryAccesses = false;
+      return true;
+    }
+
+    auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
+    auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
+    areAllDataLCDsFromDisjointMemoryAccesses &= fromInst && toInst && domainSpaceAnalysis->
+      areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst);
+    return !areAllDataLCDsFromDisjointMemoryAccesses;
+  });
+
+  return areAllDataLCDsFromDisjointMemoryAccesses;
+}
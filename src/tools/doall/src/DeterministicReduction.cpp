@@ -0,0 +1,375 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+#include "DOALLTask.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+void DOALL::setDeterministicReductions (bool deterministicReductions) {
+  this->deterministicReductions = deterministicReductions;
+
+  return ;
+}
+
+std::set<int> DOALL::fetchLiveOutVariablesToReduceDeterministically (
+  LoopDependenceInfo *LDI
+) const {
+  std::set<int> variables;
+
+  /*
+   * Check if the deterministic reduction has been requested.
+   */
+  if (!this->deterministicReductions){
+    return variables;
+  }
+
+  /*
+   * Check every live-out variable.
+   */
+  auto sccManager = LDI->getSCCManager();
+  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveOutVars()){
+    auto producer = LDI->environment->producerAt(envIndex);
+    if (!producer->getType()->isFloatingPointTy()){
+      continue ;
+    }
+    auto producerSCC = sccManager->getSCCDAG()->sccOfValue(producer);
+    auto sccInfo = sccManager->getSCCAttrs(producerSCC);
+    if (!sccInfo->canExecuteReducibly()){
+      continue ;
+    }
+
+    /*
+     * Only sums and products depend on the order their partial results are combined.
+     * The minimum and the maximum of floating point values are the same in any order.
+     */
+    auto isReassociated = false;
+    for (auto accumulator : sccInfo->getAccumulators()){
+      auto opcode = accumulator->getOpcode();
+      if (  false
+            || (opcode == Instruction::FAdd)
+            || (opcode == Instruction::FSub)
+            || (opcode == Instruction::FMul)
+        ){
+        isReassociated = true;
+      }
+    }
+    if (!isReassociated){
+      continue ;
+    }
+
+    variables.insert(envIndex);
+  }
+
+  return variables;
+}
+
+uint64_t DOALL::computeDeterministicChunkSize (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * The partial results depend on the iterations that compose a chunk.
+   * Hence, the chunk size cannot depend on the number of cores, on the trip count, or on the profiles.
+   * Only the alignment, which depends on the code of the loop, is applied to avoid false sharing.
+   */
+  uint64_t chunkSize = 256;
+  auto alignment = this->computeChunkSizeAlignment(LDI);
+  chunkSize = ((chunkSize + alignment - 1) / alignment) * alignment;
+
+  return chunkSize;
+}
+
+void DOALL::allocateChunkPartialsOfLiveOutVariables (
+  LoopDependenceInfo *LDI,
+  Noelle &par
+) {
+  this->chunkPartialsOfLiveOutVariables.clear();
+  this->chunkPartialsOfLiveOutVariablesInTask.clear();
+  this->numberOfChunkPartials = nullptr;
+
+  /*
+   * Fetch the variables to reduce deterministically.
+   */
+  auto variables = this->fetchLiveOutVariablesToReduceDeterministically(LDI);
+  if (variables.size() == 0){
+    return ;
+  }
+
+  /*
+   * Fetch the task and the user of the environment attached to it.
+   */
+  auto task = (DOALLTask *)this->tasks[0];
+  auto envUser = this->envBuilder->getUser(0);
+  auto &DL = this->module.getDataLayout();
+  auto sccManager = LDI->getSCCManager();
+  auto loopFunction = LDI->getLoopStructure()->getFunction();
+  auto int8Ptr = this->allocateChunkPartials->getFunctionType()->getParamType(2);
+
+  /*
+   * Compute the number of chunks of the current invocation of the loop just before dispatching it.
+   * The trip count is computed from the same exit condition that drives the loop of the task.
+   * The rounding up is computed without adding to the trip count, which could overflow.
+   */
+  IRBuilder<> dispatcherBuilder(this->entryPointOfParallelizedLoop);
+  IRBuilder<> entryBuilder(task->getEntry());
+  IRBuilder<> allocaBuilder(&*loopFunction->getEntryBlock().getFirstInsertionPt());
+  auto tripCount = IVUtility::generateCodeToComputeTripCount(LDI->getLoopStructure(), LDI->getLoopGoverningIVAttribution(), dispatcherBuilder);
+  assert(tripCount != nullptr);
+  auto chunkSize = ConstantInt::get(par.int64, this->computeDeterministicChunkSize(LDI));
+  auto numberOfChunks = dispatcherBuilder.CreateAdd(
+    dispatcherBuilder.CreateUDiv(tripCount, chunkSize),
+    dispatcherBuilder.CreateZExt(
+      dispatcherBuilder.CreateICmpNE(dispatcherBuilder.CreateURem(tripCount, chunkSize), ConstantInt::get(par.int64, 0)),
+      par.int64
+    )
+  );
+
+  /*
+   * Every task writes the partial result of its last chunk to the slot that follows its last completed chunk.
+   * Hence, a task can write up to numCores slots after the last chunk.
+   * All of them are allocated and reduced; the ones that do not belong to a chunk hold the identity of the reduction.
+   */
+  auto numCores = ConstantInt::get(par.int64, LDI->getMaximumNumberOfCores());
+  this->numberOfChunkPartials = dispatcherBuilder.CreateAdd(numberOfChunks, numCores);
+
+  /*
+   * Allocate the partial results of every variable.
+   */
+  for (auto envIndex : variables){
+    auto producer = LDI->environment->producerAt(envIndex);
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   Reduce " << *producer << " deterministically through partial results per chunk\n";
+    }
+
+    /*
+     * Fetch the identity of the reduction.
+     */
+    auto producerSCC = sccManager->getSCCDAG()->sccOfValue(producer);
+    auto accumulator = *(sccManager->getSCCAttrs(producerSCC)->getAccumulators().begin());
+    auto identity = allocaBuilder.CreateAlloca(producer->getType());
+    dispatcherBuilder.CreateStore(sccManager->accumOpInfo.generateIdentityFor(accumulator, producer->getType()), identity);
+
+    /*
+     * Allocate the slots.
+     */
+    auto partialSize = ConstantInt::get(par.int64, DL.getTypeAllocSize(producer->getType()));
+    auto partials = dispatcherBuilder.CreateCall(this->allocateChunkPartials, ArrayRef<Value *>({
+      this->numberOfChunkPartials,
+      partialSize,
+      dispatcherBuilder.CreateBitCast(identity, int8Ptr)
+    }));
+    this->chunkPartialsOfLiveOutVariables[envIndex] = partials;
+
+    /*
+     * The partial results become a new live-in of the task.
+     */
+    auto partialsEnvIndex = LDI->environment->addLiveInValue(partials, {});
+    this->envBuilder->addVariableToEnvironment(partialsEnvIndex, partials->getType());
+    envUser->addLiveInIndex(partialsEnvIndex);
+    envUser->createEnvPtr(entryBuilder, partialsEnvIndex, partials->getType());
+    auto partialsInTask = entryBuilder.CreateLoad(envUser->getEnvPtr(partialsEnvIndex));
+    this->chunkPartialsOfLiveOutVariablesInTask[envIndex] = entryBuilder.CreateBitCast(partialsInTask, PointerType::getUnqual(producer->getType()));
+  }
+
+  return ;
+}
+
+PHINode * DOALL::rewireLiveOutVariablesToStoreChunkPartials (
+  LoopDependenceInfo *LDI,
+  PHINode *chunkPHI,
+  IRBuilder<> &entryBuilder
+) {
+  if (this->chunkPartialsOfLiveOutVariablesInTask.size() == 0){
+    return nullptr;
+  }
+
+  /*
+   * Fetch the task.
+   */
+  auto task = (DOALLTask *)this->tasks[0];
+  auto loopStructure = LDI->getLoopStructure();
+  auto preheaderClone = task->getCloneOfOriginalBasicBlock(loopStructure->getPreHeader());
+
+  /*
+   * Track the ID of the chunk executed by the task.
+   * The task executes the chunks coreID, coreID + numCores, coreID + 2 * numCores, ...
+   *
+   * The latest ID is also kept in memory for the exit of the task, which is not dominated by the header of the loop.
+   */
+  auto chunkIDType = task->coreArg->getType();
+  auto currentChunkID = entryBuilder.CreateAlloca(chunkIDType);
+  entryBuilder.CreateStore(task->coreArg, currentChunkID);
+  IRBuilder<> headerBuilder(chunkPHI);
+  auto chunkIDPHI = headerBuilder.CreatePHI(chunkIDType, chunkPHI->getNumIncomingValues(), "chunkID");
+  for (auto i = 0; i < chunkPHI->getNumIncomingValues(); ++i) {
+    auto B = chunkPHI->getIncomingBlock(i);
+    if (B == preheaderClone) {
+      chunkIDPHI->addIncoming(task->coreArg, B);
+      continue ;
+    }
+    IRBuilder<> latchBuilder(B->getTerminator());
+    auto isChunkCompleted = cast<SelectInst>(chunkPHI->getIncomingValue(i))->getCondition();
+    auto nextChunkID = latchBuilder.CreateSelect(
+      isChunkCompleted,
+      latchBuilder.CreateAdd(chunkIDPHI, task->numCoresArg),
+      chunkIDPHI,
+      "nextChunkID"
+    );
+    chunkIDPHI->addIncoming(nextChunkID, B);
+    latchBuilder.CreateStore(nextChunkID, currentChunkID);
+  }
+
+  /*
+   * Store the partial result of every chunk to its slot.
+   */
+  IRBuilder<> exitBuilder(task->getExit());
+  auto exitChunkID = exitBuilder.CreateLoad(currentChunkID);
+  for (auto &variable : this->chunkPartialsOfLiveOutVariablesInTask){
+    auto envIndex = variable.first;
+    auto partials = variable.second;
+
+    /*
+     * Fetch the PHI of the header that accumulates the variable.
+     * Its value from the preheader is the identity of the reduction already.
+     */
+    auto producer = LDI->environment->producerAt(envIndex);
+    auto loopEntryProducerPHI = this->fetchLoopEntryPHIOfProducer(LDI, producer);
+    auto accumulatorPHI = cast<PHINode>(task->getCloneOfOriginalInstruction(loopEntryProducerPHI));
+    auto identity = accumulatorPHI->getIncomingValueForBlock(preheaderClone);
+
+    /*
+     * The partial result of the chunk that is executing is kept in a private slot.
+     */
+    auto partialOfCurrentChunk = entryBuilder.CreateAlloca(accumulatorPHI->getType());
+    entryBuilder.CreateStore(identity, partialOfCurrentChunk);
+
+    /*
+     * At the end of every iteration, the partial result goes to the slot of the chunk if the chunk is completed.
+     * In this case, the accumulation restarts from the identity for the next chunk.
+     */
+    for (auto i = 0; i < accumulatorPHI->getNumIncomingValues(); ++i) {
+      auto B = accumulatorPHI->getIncomingBlock(i);
+      if (B == preheaderClone) {
+        continue ;
+      }
+      IRBuilder<> latchBuilder(B->getTerminator());
+      auto isChunkCompleted = cast<SelectInst>(chunkPHI->getIncomingValueForBlock(B))->getCondition();
+      auto partial = accumulatorPHI->getIncomingValue(i);
+      auto slotOfChunk = latchBuilder.CreateInBoundsGEP(partials, chunkIDPHI);
+      auto slot = latchBuilder.CreateSelect(isChunkCompleted, slotOfChunk, partialOfCurrentChunk);
+      latchBuilder.CreateStore(partial, slot);
+      auto nextPartial = latchBuilder.CreateSelect(isChunkCompleted, identity, partial);
+      latchBuilder.CreateStore(nextPartial, partialOfCurrentChunk);
+      accumulatorPHI->setIncomingValue(i, nextPartial);
+    }
+
+    /*
+     * The last chunk executed by the task might not be completed.
+     * Its partial result is stored when the task exits.
+     * If the last chunk was completed instead, then the ID is the one of a spare slot and the partial result is the identity.
+     */
+    auto partialOfLastChunk = exitBuilder.CreateLoad(partialOfCurrentChunk);
+    exitBuilder.CreateStore(partialOfLastChunk, exitBuilder.CreateInBoundsGEP(partials, exitChunkID));
+  }
+
+  return chunkIDPHI;
+}
+
+std::unordered_map<int, Value *> DOALL::generateCodeToReduceChunkPartials (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> &builder
+) {
+  std::unordered_map<int, Value *> reducedVariables;
+
+  /*
+   * Fetch the loop.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopPreHeader = loopStructure->getPreHeader();
+  auto loopFunction = loopStructure->getFunction();
+  auto sccManager = LDI->getSCCManager();
+  auto &DL = this->module.getDataLayout();
+  auto int64 = IntegerType::get(this->module.getContext(), 64);
+  auto reducerType = this->reduceChunkPartials->getFunctionType()->getParamType(3);
+  auto int8Ptr = this->reduceChunkPartials->getFunctionType()->getParamType(4);
+
+  /*
+   * Reduce every variable.
+   */
+  IRBuilder<> allocaBuilder(&*loopFunction->getEntryBlock().getFirstInsertionPt());
+  for (auto &variable : this->chunkPartialsOfLiveOutVariables){
+    auto envIndex = variable.first;
+    auto partials = variable.second;
+
+    /*
+     * Fetch the accumulator and the initial value of the variable.
+     */
+    auto producer = LDI->environment->producerAt(envIndex);
+    auto producerSCC = sccManager->getSCCDAG()->sccOfValue(producer);
+    auto producerSCCAttributes = sccManager->getSCCAttrs(producerSCC);
+    auto accumulator = *(producerSCCAttributes->getAccumulators().begin());
+    auto loopEntryProducerPHI = this->fetchLoopEntryPHIOfProducer(LDI, producer);
+    auto initialValue = loopEntryProducerPHI->getIncomingValueForBlock(loopPreHeader);
+    auto partialType = producer->getType();
+
+    /*
+     * The partial results are accumulated to the initial value of the variable.
+     */
+    auto result = allocaBuilder.CreateAlloca(partialType);
+    builder.CreateStore(this->castToCorrectReducibleType(builder, initialValue, partialType), result);
+    auto reducer = this->createChunkPartialReducer(accumulator, partialType, sccManager->accumOpInfo);
+    builder.CreateCall(this->reduceChunkPartials, ArrayRef<Value *>({
+      partials,
+      this->numberOfChunkPartials,
+      ConstantInt::get(int64, DL.getTypeAllocSize(partialType)),
+      builder.CreateBitCast(reducer, reducerType),
+      builder.CreateBitCast(result, int8Ptr)
+    }));
+    reducedVariables[envIndex] = builder.CreateLoad(result);
+  }
+
+  return reducedVariables;
+}
+
+Function * DOALL::createChunkPartialReducer (
+  Instruction *accumulator,
+  Type *partialType,
+  AccumulatorOpInfo &opInfo
+) {
+
+  /*
+   * Create the function: void (i8 *destination, i8 *source, i64 sizeInBytes)
+   */
+  auto &cxt = this->module.getContext();
+  auto int8Ptr = PointerType::getUnqual(IntegerType::get(cxt, 8));
+  auto int64 = IntegerType::get(cxt, 64);
+  auto signature = FunctionType::get(Type::getVoidTy(cxt), ArrayRef<Type *>({ int8Ptr, int8Ptr, int64 }), false);
+  auto reducer = Function::Create(signature, GlobalValue::InternalLinkage, ".noelle.reduction_combine", this->module);
+  auto args = reducer->arg_begin();
+  auto destination = &*(args++);
+  auto source = &*(args++);
+
+  /*
+   * Accumulate the source partial into the destination one.
+   */
+  auto entryBB = BasicBlock::Create(cxt, "", reducer);
+  IRBuilder<> builder(entryBB);
+  auto partialPtrType = PointerType::getUnqual(partialType);
+  auto destinationPtr = builder.CreateBitCast(destination, partialPtrType);
+  auto accumulatedValue = builder.CreateLoad(destinationPtr);
+  auto partial = builder.CreateLoad(builder.CreateBitCast(source, partialPtrType));
+  auto newValue = opInfo.generateAccumulation(builder, accumulator, accumulatedValue, partial);
+  builder.CreateStore(newValue, destinationPtr);
+  builder.CreateRetVoid();
+
+  return reducer;
+}
@@ -0,0 +1,738 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+#include "DOALLTask.hpp"
+#include "llvm/Analysis/ValueTracking.h"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+BasicBlock * DOALL::fetchGoverningExitBlock (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * The exit governed by the induction variable is the successor of the branch of the header that is outside the loop.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopGoverningIVAttr = LDI->getLoopGoverningIVAttribution();
+  if (loopGoverningIVAttr == nullptr){
+    return nullptr;
+  }
+  auto headerBr = loopGoverningIVAttr->getHeaderBrInst();
+  for (auto succBB : successors(headerBr)){
+    if (!loopStructure->isIncluded(succBB)){
+      return succBB;
+    }
+  }
+
+  return nullptr;
+}
+
+bool DOALL::canEarlyExitsBeTakenCooperatively (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * Fetch the exits of the loop.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto exitBlocks = loopStructure->getLoopExitBasicBlocks();
+  auto governingExitBlock = this->fetchGoverningExitBlock(LDI);
+  if (std::find(exitBlocks.begin(), exitBlocks.end(), governingExitBlock) == exitBlocks.end()){
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   The loop does not have an exit governed by an induction variable\n";
+    }
+    return false;
+  }
+  std::unordered_set<BasicBlock *> earlyExitBlocks(exitBlocks.begin(), exitBlocks.end());
+  earlyExitBlocks.erase(governingExitBlock);
+
+  /*
+   * Tasks keep executing the iterations that follow the first exit taken until they notice it.
+   * Hence, these iterations must not modify memory and they must not trap (e.g., by dividing by zero or by loading from beyond the end of an array).
+   */
+  auto loopHeader = loopStructure->getHeader();
+  for (auto bb : loopStructure->getBasicBlocks()){
+    for (auto &I : *bb){
+      if (I.mayWriteToMemory()){
+        if (this->verbose != Verbosity::Disabled) {
+          errs() << "DOALL:   Early exits of loops that modify memory cannot be taken cooperatively\n";
+        }
+        return false;
+      }
+      if (  false
+            || isa<PHINode>(&I)
+            || I.isTerminator()
+            || isSafeToSpeculativelyExecute(&I)
+        ){
+        continue ;
+      }
+
+      /*
+       * Loads outside the header can be proven to access valid memory for every value of the loop-governing induction variable.
+       */
+      auto load = dyn_cast<LoadInst>(&I);
+      if (  true
+            && (load != nullptr)
+            && (bb != loopHeader)
+            && this->isLoadDereferenceableInEveryIteration(LDI, load)
+        ){
+        continue ;
+      }
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL:   The iterations after an early exit could trap at " << I << "\n";
+      }
+      return false;
+    }
+  }
+
+  /*
+   * The latches are rewritten when the loop is chunked.
+   * Hence, they cannot exit the loop.
+   */
+  for (auto latch : loopStructure->getLatches()){
+    for (auto succBB : successors(latch)){
+      if (!loopStructure->isIncluded(succBB)){
+        if (this->verbose != Verbosity::Disabled) {
+          errs() << "DOALL:   A latch of the loop exits it\n";
+        }
+        return false;
+      }
+    }
+  }
+
+  /*
+   * Every early exit must be reached from a single block of the loop.
+   */
+  for (auto exitBB : earlyExitBlocks){
+    if (exitBB->getSinglePredecessor() == nullptr){
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL:   An early exit of the loop has more than one predecessor\n";
+      }
+      return false;
+    }
+  }
+
+  /*
+   * Live-out variables consumed at early exits are recorded by the task that takes the exit.
+   * Hence, their value must be the one of the iteration that exits, which is the case for induction variables and values computed within an iteration.
+   * The other live-out variables must be reducible as for loops with a single exit.
+   */
+  auto sccManager = LDI->getSCCManager();
+  DominatorTree DT(*loopStructure->getFunction());
+  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveOutVars()){
+    auto producer = cast<Instruction>(LDI->environment->producerAt(envIndex));
+    auto producerSCC = sccManager->getSCCDAG()->sccOfValue(producer);
+    auto sccInfo = sccManager->getSCCAttrs(producerSCC);
+
+    /*
+     * Check where the variable is consumed.
+     */
+    auto isConsumedAtEarlyExits = false;
+    auto isConsumedElsewhere = false;
+    for (auto consumer : LDI->environment->consumersOf(producer)){
+      auto consumerInst = dyn_cast<Instruction>(consumer);
+      if (  true
+            && (consumerInst != nullptr)
+            && (earlyExitBlocks.find(consumerInst->getParent()) != earlyExitBlocks.end())
+        ){
+        isConsumedAtEarlyExits = true;
+
+        /*
+         * The value of the iteration that exits must be available when the exit is taken.
+         */
+        auto exitingBB = consumerInst->getParent()->getSinglePredecessor();
+        if (!DT.dominates(producer->getParent(), exitingBB)){
+          isConsumedElsewhere = true;
+        }
+        continue ;
+      }
+      isConsumedElsewhere = true;
+    }
+
+    /*
+     * Check the live-out variable.
+     */
+    if (!isConsumedAtEarlyExits){
+      if (  true
+            && (!sccInfo->canExecuteIndependently())
+            && (!sccInfo->canExecuteReducibly())
+        ){
+        if (this->verbose != Verbosity::Disabled) {
+          errs() << "DOALL:   Some post environment value is not reducable\n";
+        }
+        return false;
+      }
+      continue ;
+    }
+    if (  false
+          || isConsumedElsewhere
+          || (  true
+                && (!sccInfo->canExecuteIndependently())
+                && (!sccInfo->isInductionVariableSCC())
+             )
+      ){
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL:   The live-out value " << *producer << " of an early exit cannot be recorded by the task that takes it\n";
+      }
+      return false;
+    }
+  }
+
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << "DOALL:   The " << earlyExitBlocks.size() << " early exits of the loop will be taken cooperatively\n";
+  }
+  return true;
+}
+
+bool DOALL::isLoadDereferenceableInEveryIteration (
+  LoopDependenceInfo *LDI,
+  LoadInst *load
+) const {
+  if (!load->isSimple()){
+    return false;
+  }
+
+  /*
+   * The load must access an element of a loop-invariant object that is indexed by the loop-governing induction variable and by constants only.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopGoverningIVAttr = LDI->getLoopGoverningIVAttribution();
+  auto &loopGoverningIV = loopGoverningIVAttr->getInductionVariable();
+  auto gep = dyn_cast<GetElementPtrInst>(load->getPointerOperand());
+  if (gep == nullptr){
+    return false;
+  }
+  auto base = gep->getPointerOperand();
+  if (auto baseInst = dyn_cast<Instruction>(base)){
+    if (loopStructure->isIncluded(baseInst)){
+      return false;
+    }
+  }
+  auto ivPHI = loopGoverningIV.getLoopEntryPHI();
+  Use *ivIndex = nullptr;
+  auto isIVZeroExtended = false;
+  for (auto &index : gep->indices()){
+    if (isa<ConstantInt>(index)){
+      continue ;
+    }
+    auto indexValue = index.get();
+    if (auto indexCast = dyn_cast<CastInst>(indexValue)){
+      if (  false
+            || isa<SExtInst>(indexCast)
+            || isa<ZExtInst>(indexCast)
+        ){
+        isIVZeroExtended = isa<ZExtInst>(indexCast);
+        indexValue = indexCast->getOperand(0);
+      }
+    }
+    if (  false
+          || (indexValue != ivPHI)
+          || (ivIndex != nullptr)
+      ){
+      return false;
+    }
+    ivIndex = &index;
+  }
+  if (ivIndex == nullptr){
+    return false;
+  }
+
+  /*
+   * Fetch the range of values of the loop-governing induction variable in the body of the loop.
+   */
+  auto start = dyn_cast<ConstantInt>(loopGoverningIV.getStartValue());
+  auto exit = dyn_cast<ConstantInt>(loopGoverningIVAttr->getHeaderCmpInstConditionValue());
+  auto step = dyn_cast_or_null<ConstantInt>(loopGoverningIV.getSingleComputedStepValue());
+  if (  false
+        || (step == nullptr)
+        || step->isZero()
+    ){
+    return false;
+  }
+  if (  false
+        || (start == nullptr)
+        || (exit == nullptr)
+    ){
+
+    /*
+     * The range is known only at run time.
+     * Tasks check the loop-governing condition before every iteration, so the iterations that follow an early exit belong to the iterations of the current invocation (i.e., [start, start + tripCount * step)).
+     * The loop would have loaded the same elements had it not taken the early exit.
+     * Hence, the load is valid as long as the bounds of the loop are the bounds of the object it indexes, which is the contract of loops that search an object (e.g., a pointer and its length).
+     */
+    return IVUtility::canComputeTripCount(loopStructure, loopGoverningIVAttr);
+  }
+  if (start->getBitWidth() > 64){
+    return false;
+  }
+  auto predicate = IVUtility::fetchPredicateToContinue(loopGoverningIVAttr);
+  if (  true
+        && CmpInst::isUnsigned(predicate)
+        && (start->isNegative() || exit->isNegative())
+    ){
+    return false;
+  }
+  auto isStepPositive = !step->isNegative();
+  auto startValue = start->getSExtValue();
+  auto exitValue = exit->getSExtValue();
+  auto stepValue = step->getSExtValue();
+  int64_t lastValue;
+  switch (predicate){
+    case CmpInst::Predicate::ICMP_SLT:
+    case CmpInst::Predicate::ICMP_ULT:
+      if (!isStepPositive){
+        return false;
+      }
+      lastValue = exitValue - 1;
+      break ;
+
+    case CmpInst::Predicate::ICMP_SLE:
+    case CmpInst::Predicate::ICMP_ULE:
+      if (!isStepPositive){
+        return false;
+      }
+      lastValue = exitValue;
+      break ;
+
+    case CmpInst::Predicate::ICMP_SGT:
+    case CmpInst::Predicate::ICMP_UGT:
+      if (isStepPositive){
+        return false;
+      }
+      lastValue = exitValue + 1;
+      break ;
+
+    case CmpInst::Predicate::ICMP_SGE:
+    case CmpInst::Predicate::ICMP_UGE:
+      if (isStepPositive){
+        return false;
+      }
+      lastValue = exitValue;
+      break ;
+
+    case CmpInst::Predicate::ICMP_NE:
+      if (((exitValue - startValue) % stepValue) != 0){
+        return false;
+      }
+      lastValue = exitValue - stepValue;
+      break ;
+
+    default:
+      return false;
+  }
+
+  /*
+   * Check if the body of the loop is never executed.
+   */
+  if (isStepPositive ? (lastValue < startValue) : (lastValue > startValue)){
+    return true;
+  }
+
+  if (  true
+        && isIVZeroExtended
+        && ((startValue < 0) || (lastValue < 0))
+    ){
+    return false;
+  }
+
+  /*
+   * Fetch the number of bytes that can be accessed from the base of the object.
+   */
+  auto &DL = this->module.getDataLayout();
+  uint64_t dereferenceableBytes = 0;
+  if (auto baseAlloca = dyn_cast<AllocaInst>(base)){
+    auto arraySize = dyn_cast<ConstantInt>(baseAlloca->getArraySize());
+    if (arraySize != nullptr){
+      dereferenceableBytes = DL.getTypeAllocSize(baseAlloca->getAllocatedType()) * arraySize->getZExtValue();
+    }
+
+  } else if (auto baseGlobal = dyn_cast<GlobalVariable>(base)){
+    if (  true
+          && baseGlobal->getValueType()->isSized()
+          && !baseGlobal->hasExternalWeakLinkage()
+      ){
+      dereferenceableBytes = DL.getTypeAllocSize(baseGlobal->getValueType());
+    }
+
+  } else {
+    auto canBeNull = true;
+    dereferenceableBytes = base->getPointerDereferenceableBytes(DL, canBeNull);
+    if (canBeNull){
+      return false;
+    }
+  }
+
+  /*
+   * The offset of the element accessed is monotonic with the induction variable.
+   * Hence, the elements accessed by the first and the last iterations bound all the others.
+   */
+  auto loadSize = (int64_t)DL.getTypeStoreSize(load->getType());
+  for (auto ivValue : { startValue, lastValue }){
+    std::vector<Value *> indices;
+    for (auto &index : gep->indices()){
+      if (&index == ivIndex){
+        indices.push_back(ConstantInt::get(index->getType(), ivValue, true));
+        continue ;
+      }
+      indices.push_back(index.get());
+    }
+    auto offset = DL.getIndexedOffsetInType(gep->getSourceElementType(), indices);
+    if (  false
+          || (offset < 0)
+          || ((uint64_t)(offset + loadSize) > dereferenceableBytes)
+      ){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::set<int> DOALL::fetchLiveOutVariablesOfEarlyExits (
+  LoopDependenceInfo *LDI
+) const {
+  std::set<int> variables;
+
+  /*
+   * Fetch the early exits of the loop.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  if (loopStructure->numberOfExitBasicBlocks() <= 1){
+    return variables;
+  }
+  auto exitBlocks = loopStructure->getLoopExitBasicBlocks();
+  std::unordered_set<BasicBlock *> earlyExitBlocks(exitBlocks.begin(), exitBlocks.end());
+  earlyExitBlocks.erase(this->fetchGoverningExitBlock(LDI));
+
+  /*
+   * Collect the live-out variables consumed at early exits.
+   */
+  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveOutVars()){
+    auto producer = LDI->environment->producerAt(envIndex);
+    for (auto consumer : LDI->environment->consumersOf(producer)){
+      auto consumerInst = dyn_cast<Instruction>(consumer);
+      if (  true
+            && (consumerInst != nullptr)
+            && (earlyExitBlocks.find(consumerInst->getParent()) != earlyExitBlocks.end())
+        ){
+        variables.insert(envIndex);
+      }
+    }
+  }
+
+  return variables;
+}
+
+void DOALL::allocateEarlyExitRecords (
+  LoopDependenceInfo *LDI,
+  Noelle &par
+) {
+  this->firstEarlyExitIteration = nullptr;
+  this->earlyExitRecords = nullptr;
+  this->firstEarlyExitIterationInTask = nullptr;
+  this->earlyExitRecordsInTask = nullptr;
+  this->liveOutVariablesOfEarlyExits.clear();
+
+  /*
+   * Check if the loop has early exits.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  if (loopStructure->numberOfExitBasicBlocks() <= 1){
+    return ;
+  }
+  auto loopFunction = loopStructure->getFunction();
+  auto variables = this->fetchLiveOutVariablesOfEarlyExits(LDI);
+  this->liveOutVariablesOfEarlyExits.assign(variables.begin(), variables.end());
+
+  /*
+   * Every task records the first early exit it takes: its iteration, the ID of the exit, and the live-out values of the exit.
+   */
+  std::vector<Type *> recordFields{ par.int64, par.int32 };
+  for (auto envIndex : this->liveOutVariablesOfEarlyExits){
+    recordFields.push_back(LDI->environment->producerAt(envIndex)->getType());
+  }
+  auto recordType = StructType::get(this->module.getContext(), recordFields);
+  auto numCores = LDI->getMaximumNumberOfCores();
+  IRBuilder<> allocaBuilder(&*loopFunction->getEntryBlock().getFirstInsertionPt());
+  this->firstEarlyExitIteration = allocaBuilder.CreateAlloca(par.int64);
+  this->earlyExitRecords = allocaBuilder.CreateAlloca(ArrayType::get(recordType, numCores));
+
+  /*
+   * No exit has been taken before dispatching the loop.
+   */
+  IRBuilder<> dispatcherBuilder(this->entryPointOfParallelizedLoop);
+  auto noIteration = ConstantInt::getAllOnesValue(par.int64);
+  dispatcherBuilder.CreateStore(noIteration, this->firstEarlyExitIteration);
+  for (auto core = 0; core < numCores; core++){
+    auto record = dispatcherBuilder.CreateInBoundsGEP(this->earlyExitRecords, ArrayRef<Value *>({
+      ConstantInt::get(par.int64, 0),
+      ConstantInt::get(par.int64, core)
+    }));
+    dispatcherBuilder.CreateStore(noIteration, dispatcherBuilder.CreateStructGEP(record, 0));
+  }
+
+  /*
+   * The first iteration that took an exit and the records become new live-ins of the task.
+   */
+  auto task = (DOALLTask *)this->tasks[0];
+  auto envUser = this->envBuilder->getUser(0);
+  IRBuilder<> entryBuilder(task->getEntry());
+  auto addLiveIn = [this, LDI, envUser, &entryBuilder](Value *liveIn) -> Value * {
+    auto envIndex = LDI->environment->addLiveInValue(liveIn, {});
+    this->envBuilder->addVariableToEnvironment(envIndex, liveIn->getType());
+    envUser->addLiveInIndex(envIndex);
+    envUser->createEnvPtr(entryBuilder, envIndex, liveIn->getType());
+    return entryBuilder.CreateLoad(envUser->getEnvPtr(envIndex));
+  };
+  this->firstEarlyExitIterationInTask = addLiveIn(this->firstEarlyExitIteration);
+  this->earlyExitRecordsInTask = addLiveIn(this->earlyExitRecords);
+
+  return ;
+}
+
+PHINode * DOALL::rewireEarlyExitsToRecordTheirIteration (
+  LoopDependenceInfo *LDI,
+  PHINode *chunkPHI,
+  IRBuilder<> &entryBuilder
+) {
+  if (this->earlyExitRecordsInTask == nullptr){
+    return nullptr;
+  }
+
+  /*
+   * Fetch the task.
+   */
+  auto task = (DOALLTask *)this->tasks[0];
+  auto loopStructure = LDI->getLoopStructure();
+  auto preheaderClone = task->getCloneOfOriginalBasicBlock(loopStructure->getPreHeader());
+  auto int32 = IntegerType::get(this->module.getContext(), 32);
+
+  /*
+   * Track the iteration executed by the task.
+   * The task executes the iterations [coreID * chunkSize, (coreID + 1) * chunkSize), then it skips the chunks of the other cores.
+   */
+  auto iterationType = task->coreArg->getType();
+  auto firstIteration = entryBuilder.CreateMul(task->coreArg, task->chunkSizeArg, "firstIteration");
+  auto iterationsToNextChunk = entryBuilder.CreateMul(
+    entryBuilder.CreateSub(task->numCoresArg, ConstantInt::get(iterationType, 1)),
+    task->chunkSizeArg,
+    "iterationsToNextChunk"
+  );
+  IRBuilder<> headerBuilder(chunkPHI);
+  auto iterationPHI = headerBuilder.CreatePHI(iterationType, chunkPHI->getNumIncomingValues(), "iteration");
+  for (auto i = 0; i < chunkPHI->getNumIncomingValues(); ++i) {
+    auto B = chunkPHI->getIncomingBlock(i);
+    if (B == preheaderClone) {
+      iterationPHI->addIncoming(firstIteration, B);
+      continue ;
+    }
+    IRBuilder<> latchBuilder(B->getTerminator());
+    auto isChunkCompleted = cast<SelectInst>(chunkPHI->getIncomingValue(i))->getCondition();
+    auto nextIteration = latchBuilder.CreateAdd(iterationPHI, ConstantInt::get(iterationType, 1));
+    iterationPHI->addIncoming(latchBuilder.CreateSelect(
+      isChunkCompleted,
+      latchBuilder.CreateAdd(nextIteration, iterationsToNextChunk),
+      nextIteration,
+      "nextIteration"
+    ), B);
+  }
+
+  /*
+   * When an early exit is taken, the task publishes its iteration to the other tasks and it records the exit.
+   * Only the first exit taken by a task is recorded because the task stops executing iterations afterwards.
+   */
+  auto recordOfTask = entryBuilder.CreateInBoundsGEP(this->earlyExitRecordsInTask, ArrayRef<Value *>({
+    ConstantInt::get(iterationType, 0),
+    task->coreArg
+  }));
+  auto exitBlocks = loopStructure->getLoopExitBasicBlocks();
+  auto governingExitBlock = this->fetchGoverningExitBlock(LDI);
+  for (auto exitID = 0; exitID < exitBlocks.size(); exitID++){
+    auto exitBB = exitBlocks[exitID];
+    if (exitBB == governingExitBlock){
+      continue ;
+    }
+    auto exitClone = task->getCloneOfOriginalBasicBlock(exitBB);
+    IRBuilder<> exitBuilder(exitClone->getTerminator());
+    exitBuilder.CreateAtomicRMW(AtomicRMWInst::UMin, this->firstEarlyExitIterationInTask, iterationPHI, AtomicOrdering::Monotonic);
+    exitBuilder.CreateStore(iterationPHI, exitBuilder.CreateStructGEP(recordOfTask, 0));
+    exitBuilder.CreateStore(ConstantInt::get(int32, exitID), exitBuilder.CreateStructGEP(recordOfTask, 1));
+
+    /*
+     * Record the live-out values consumed at the exit.
+     */
+    for (auto field = 0; field < this->liveOutVariablesOfEarlyExits.size(); field++){
+      auto producer = LDI->environment->producerAt(this->liveOutVariablesOfEarlyExits[field]);
+      auto isConsumedAtThisExit = false;
+      for (auto consumer : LDI->environment->consumersOf(producer)){
+        auto consumerInst = dyn_cast<Instruction>(consumer);
+        if (  true
+              && (consumerInst != nullptr)
+              && (consumerInst->getParent() == exitBB)
+          ){
+          isConsumedAtThisExit = true;
+        }
+      }
+      if (!isConsumedAtThisExit){
+        continue ;
+      }
+      exitBuilder.CreateStore(this->fetchClone(producer), exitBuilder.CreateStructGEP(recordOfTask, field + 2));
+    }
+  }
+
+  return iterationPHI;
+}
+
+void DOALL::pollEarlyExitsAtChunkBoundaries (
+  LoopDependenceInfo *LDI,
+  PHINode *chunkPHI,
+  PHINode *iterationPHI
+) {
+  if (iterationPHI == nullptr){
+    return ;
+  }
+
+  /*
+   * Fetch the task.
+   */
+  auto task = (DOALLTask *)this->tasks[0];
+  auto loopStructure = LDI->getLoopStructure();
+  auto headerClone = task->getCloneOfOriginalBasicBlock(loopStructure->getHeader());
+  auto &cxt = this->module.getContext();
+
+  /*
+   * At the end of every chunk, the task checks if another task took an exit at an earlier iteration than the next one it would execute.
+   * In this case, the rest of the iterations of the task are not needed.
+   */
+  for (auto latch : loopStructure->getLatches()){
+    auto latchClone = task->getCloneOfOriginalBasicBlock(latch);
+    auto isChunkCompleted = cast<SelectInst>(chunkPHI->getIncomingValueForBlock(latchClone))->getCondition();
+    auto nextIteration = iterationPHI->getIncomingValueForBlock(latchClone);
+
+    /*
+     * Redirect the back edge of the latch.
+     */
+    auto checkBB = BasicBlock::Create(cxt, "", task->getTaskBody());
+    auto pollBB = BasicBlock::Create(cxt, "", task->getTaskBody());
+    auto latchTerminator = latchClone->getTerminator();
+    for (auto i = 0; i < latchTerminator->getNumSuccessors(); i++){
+      if (latchTerminator->getSuccessor(i) == headerClone){
+        latchTerminator->setSuccessor(i, checkBB);
+      }
+    }
+    for (auto &I : *headerClone){
+      auto phi = dyn_cast<PHINode>(&I);
+      if (phi == nullptr){
+        break ;
+      }
+      auto incomingValue = phi->getIncomingValueForBlock(latchClone);
+      phi->setIncomingBlock(phi->getBasicBlockIndex(latchClone), checkBB);
+      phi->addIncoming(incomingValue, pollBB);
+    }
+
+    /*
+     * Poll the first iteration that took an exit only at the end of a chunk.
+     */
+    IRBuilder<> checkBuilder(checkBB);
+    checkBuilder.CreateCondBr(isChunkCompleted, pollBB, headerClone);
+    IRBuilder<> pollBuilder(pollBB);
+    auto firstEarlyExitIteration = pollBuilder.CreateLoad(this->firstEarlyExitIterationInTask);
+    firstEarlyExitIteration->setAtomic(AtomicOrdering::Monotonic);
+    firstEarlyExitIteration->setAlignment(8);
+    auto isCancelled = pollBuilder.CreateICmpULT(firstEarlyExitIteration, nextIteration);
+    pollBuilder.CreateCondBr(isCancelled, task->getExit(), headerClone);
+  }
+
+  return ;
+}
+
+void DOALL::generateCodeToSelectFirstEarlyExit (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> &builder
+) {
+  if (this->earlyExitRecords == nullptr){
+    return ;
+  }
+
+  /*
+   * Fetch the exits of the loop.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopHeader = loopStructure->getHeader();
+  auto exitBlocks = loopStructure->getLoopExitBasicBlocks();
+  auto governingExitBlock = this->fetchGoverningExitBlock(LDI);
+  auto governingExitID = std::find(exitBlocks.begin(), exitBlocks.end(), governingExitBlock) - exitBlocks.begin();
+  auto int32 = IntegerType::get(this->module.getContext(), 32);
+  auto int64 = IntegerType::get(this->module.getContext(), 64);
+
+  /*
+   * The exit taken by the loop is the one of the task that recorded the first iteration that exited.
+   */
+  auto firstEarlyExitIteration = builder.CreateLoad(this->firstEarlyExitIteration);
+  Value *exitID = ConstantInt::get(int32, governingExitID);
+  std::vector<Value *> liveOutValues;
+  for (auto envIndex : this->liveOutVariablesOfEarlyExits){
+    liveOutValues.push_back(UndefValue::get(LDI->environment->producerAt(envIndex)->getType()));
+  }
+  for (auto core = 0; core < LDI->getMaximumNumberOfCores(); core++){
+    auto record = builder.CreateInBoundsGEP(this->earlyExitRecords, ArrayRef<Value *>({
+      ConstantInt::get(int64, 0),
+      ConstantInt::get(int64, core)
+    }));
+    auto isFirst = builder.CreateICmpEQ(builder.CreateLoad(builder.CreateStructGEP(record, 0)), firstEarlyExitIteration);
+    exitID = builder.CreateSelect(isFirst, builder.CreateLoad(builder.CreateStructGEP(record, 1)), exitID);
+    for (auto field = 0; field < liveOutValues.size(); field++){
+      liveOutValues[field] = builder.CreateSelect(isFirst, builder.CreateLoad(builder.CreateStructGEP(record, field + 2)), liveOutValues[field]);
+    }
+  }
+  auto isEarlyExitTaken = builder.CreateICmpNE(firstEarlyExitIteration, ConstantInt::getAllOnesValue(int64));
+  exitID = builder.CreateSelect(isEarlyExitTaken, exitID, ConstantInt::get(int32, governingExitID));
+
+  /*
+   * Store the exit taken and its live-out values to the environment, which is where the code after the parallelized loop fetches them from.
+   */
+  builder.CreateStore(exitID, this->envBuilder->getEnvVar(LDI->environment->indexOfExitBlockTaken()));
+  for (auto field = 0; field < liveOutValues.size(); field++){
+    builder.CreateStore(liveOutValues[field], this->envBuilder->getEnvVar(this->liveOutVariablesOfEarlyExits[field]));
+  }
+
+  /*
+   * Values of the PHIs of early exits that are not computed by the loop do not go through the environment.
+   */
+  for (auto exitBB : exitBlocks){
+    if (exitBB == governingExitBlock){
+      continue ;
+    }
+    for (auto &I : *exitBB){
+      auto phi = dyn_cast<PHINode>(&I);
+      if (phi == nullptr){
+        break ;
+      }
+      auto incomingBB = phi->getIncomingBlock(0);
+      auto incomingValue = phi->getIncomingValue(0);
+      if (incomingBB == loopHeader){
+        continue ;
+      }
+      auto incomingInst = dyn_cast<Instruction>(incomingValue);
+      if (  true
+            && (incomingInst != nullptr)
+            && loopStructure->isIncluded(incomingInst)
+        ){
+        continue ;
+      }
+      phi->addIncoming(incomingValue, this->exitPointOfParallelizedLoop);
+    }
+  }
+
+  return ;
+}
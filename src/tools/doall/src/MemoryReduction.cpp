@@ -0,0 +1,285 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+#include "DOALLTask.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+/*
+ * Append to @f a loop that iterates over the elements of type @elementType of the buffers @buffers, which have @sizeInBytes bytes.
+ * The code generated by @body is executed for every element; it gets the pointers to the current element of every buffer.
+ *
+ * Return the basic block executed after the loop (it has no terminator).
+ */
+static BasicBlock * createLoopOverElements (
+  Function *f,
+  std::vector<Value *> buffers,
+  Value *sizeInBytes,
+  Type *elementType,
+  std::function<void (IRBuilder<> &bodyBuilder, std::vector<Value *> &elements)> body
+) {
+  auto &cxt = f->getContext();
+  auto &DL = f->getParent()->getDataLayout();
+  auto int64 = IntegerType::get(cxt, 64);
+
+  /*
+   * Create the basic blocks of the loop.
+   */
+  auto entryBB = BasicBlock::Create(cxt, "", f);
+  auto headerBB = BasicBlock::Create(cxt, "", f);
+  auto bodyBB = BasicBlock::Create(cxt, "", f);
+  auto exitBB = BasicBlock::Create(cxt, "", f);
+
+  /*
+   * Compute the number of elements.
+   */
+  IRBuilder<> entryBuilder(entryBB);
+  std::vector<Value *> elementBuffers;
+  for (auto buffer : buffers){
+    elementBuffers.push_back(entryBuilder.CreateBitCast(buffer, PointerType::getUnqual(elementType)));
+  }
+  auto elementSize = ConstantInt::get(int64, DL.getTypeAllocSize(elementType));
+  auto numberOfElements = entryBuilder.CreateUDiv(sizeInBytes, elementSize);
+  entryBuilder.CreateBr(headerBB);
+
+  /*
+   * Check if there are elements left.
+   */
+  IRBuilder<> headerBuilder(headerBB);
+  auto index = headerBuilder.CreatePHI(int64, 2);
+  index->addIncoming(ConstantInt::get(int64, 0), entryBB);
+  auto isNotDone = headerBuilder.CreateICmpULT(index, numberOfElements);
+  headerBuilder.CreateCondBr(isNotDone, bodyBB, exitBB);
+
+  /*
+   * Handle the current element.
+   */
+  IRBuilder<> bodyBuilder(bodyBB);
+  std::vector<Value *> elements;
+  for (auto elementBuffer : elementBuffers){
+    elements.push_back(bodyBuilder.CreateInBoundsGEP(elementBuffer, index));
+  }
+  body(bodyBuilder, elements);
+  auto nextIndex = bodyBuilder.CreateAdd(index, ConstantInt::get(int64, 1));
+  index->addIncoming(nextIndex, bodyBuilder.GetInsertBlock());
+  bodyBuilder.CreateBr(headerBB);
+
+  return exitBB;
+}
+
+std::unordered_set<const ReducibleMemoryLocation *> DOALL::fetchMemoryLocationsToReduce (
+  LoopDependenceInfo *LDI
+) const {
+  std::unordered_set<const ReducibleMemoryLocation *> locations;
+
+  /*
+   * Check every SCC that blocks DOALL.
+   */
+  auto sccManager = LDI->getSCCManager();
+  for (auto scc : sccManager->getSCCsWithLoopCarriedDataDependencies()) {
+    auto sccInfo = sccManager->getSCCAttrs(scc);
+    if (!sccInfo->canBeReducedUsingPrivateMemoryLocations()){
+      continue ;
+    }
+
+    /*
+     * Private copies are not needed if the loop-carried dependences of the SCC are removed in a cheaper way.
+     * This must match the order of the checks of DOALL::canBeAppliedToLoop.
+     */
+    if (  false
+          || sccInfo->canExecuteReducibly()
+          || sccInfo->canBeCloned()
+          || sccInfo->canBeClonedUsingLocalMemoryLocations()
+          || this->areLoopCarriedDependencesBetweenDisjointMemoryAccesses(LDI, scc)
+      ){
+      continue ;
+    }
+
+    /*
+     * The memory objects updated by the SCC need to be reduced.
+     */
+    for (auto location : sccInfo->getMemoryLocationsToReduce()){
+      locations.insert(location);
+    }
+  }
+
+  return locations;
+}
+
+void DOALL::privatizeMemoryLocationsToReduce (
+  LoopDependenceInfo *LDI,
+  Noelle &par
+) {
+
+  /*
+   * Fetch the memory objects to reduce.
+   */
+  auto locations = this->fetchMemoryLocationsToReduce(LDI);
+  if (locations.size() == 0){
+    return ;
+  }
+
+  /*
+   * Fetch the task and the user of the environment attached to it.
+   */
+  auto task = (DOALLTask *)this->tasks[0];
+  auto envUser = this->envBuilder->getUser(0);
+  auto &opInfo = LDI->getSCCManager()->accumOpInfo;
+
+  /*
+   * Privatize the memory objects.
+   */
+  IRBuilder<> dispatcherBuilder(this->entryPointOfParallelizedLoop);
+  IRBuilder<> entryBuilder(task->getEntry());
+  auto numCores = ConstantInt::get(par.int64, LDI->getMaximumNumberOfCores());
+  for (auto location : locations){
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   Reduce the memory object " << *location->getAllocation() << " through private copies\n";
+    }
+
+    /*
+     * Allocate one private copy per task just before dispatching the loop.
+     * Every task reuses its copy for all of its chunks.
+     */
+    auto sizeInBytes = location->generateCodeToComputeSizeInBytes(dispatcherBuilder);
+    auto copies = dispatcherBuilder.CreateCall(this->allocatePrivateCopies, ArrayRef<Value *>({
+      sizeInBytes,
+      numCores
+    }));
+    this->privateCopiesOfMemoryLocations[location] = copies;
+
+    /*
+     * The private copies become a new live-in of the task.
+     */
+    auto envIndex = LDI->environment->addLiveInValue(copies, {});
+    this->envBuilder->addVariableToEnvironment(envIndex, copies->getType());
+    envUser->addLiveInIndex(envIndex);
+    envUser->createEnvPtr(entryBuilder, envIndex, copies->getType());
+    auto copiesInTask = entryBuilder.CreateLoad(envUser->getEnvPtr(envIndex));
+
+    /*
+     * Initialize the private copy of the task to the identity of the operation that updates the memory object.
+     */
+    auto initializer = this->createPrivateCopyInitializer(location, opInfo);
+    auto initializerType = this->initializePrivateCopy->getFunctionType()->getParamType(2);
+    auto privateCopy = entryBuilder.CreateCall(this->initializePrivateCopy, ArrayRef<Value *>({
+      copiesInTask,
+      task->coreArg,
+      entryBuilder.CreateBitCast(initializer, initializerType)
+    }));
+
+    /*
+     * The task accesses its private copy rather than the original memory object.
+     */
+    auto pointer = location->getPointer();
+    auto privatePointer = entryBuilder.CreateBitCast(privateCopy, pointer->getType());
+    task->addLiveIn(pointer, privatePointer);
+  }
+
+  return ;
+}
+
+void DOALL::generateCodeToReduceMemoryLocations (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> &builder,
+  Value *numThreadsUsed,
+  Value *numCores
+) {
+  auto &opInfo = LDI->getSCCManager()->accumOpInfo;
+  auto reducerType = this->reducePrivateCopies->getFunctionType()->getParamType(2);
+  auto int8Ptr = this->reducePrivateCopies->getFunctionType()->getParamType(1);
+  auto int64 = IntegerType::get(this->module.getContext(), 64);
+
+  /*
+   * Merge the private copies of the tasks that run into the original memory objects.
+   * The runtime merges disjoint blocks of large objects in parallel and it frees the copies.
+   */
+  for (auto &locationCopies : this->privateCopiesOfMemoryLocations){
+    auto location = locationCopies.first;
+    auto copies = locationCopies.second;
+    auto reducer = this->createPrivateCopyReducer(location, opInfo);
+    builder.CreateCall(this->reducePrivateCopies, ArrayRef<Value *>({
+      copies,
+      builder.CreateBitCast(location->getPointer(), int8Ptr),
+      builder.CreateBitCast(reducer, reducerType),
+      builder.CreateZExtOrTrunc(numThreadsUsed, int64),
+      numCores
+    }));
+  }
+
+  return ;
+}
+
+Function * DOALL::createPrivateCopyInitializer (
+  const ReducibleMemoryLocation *location,
+  AccumulatorOpInfo &opInfo
+) {
+
+  /*
+   * Create the function: void (i8 *copy, i64 sizeInBytes)
+   */
+  auto &cxt = this->module.getContext();
+  auto int8Ptr = PointerType::getUnqual(IntegerType::get(cxt, 8));
+  auto int64 = IntegerType::get(cxt, 64);
+  auto signature = FunctionType::get(Type::getVoidTy(cxt), ArrayRef<Type *>({ int8Ptr, int64 }), false);
+  auto initializer = Function::Create(signature, GlobalValue::InternalLinkage, ".noelle.reduction_init", this->module);
+  auto args = initializer->arg_begin();
+  auto copy = &*(args++);
+  auto sizeInBytes = &*(args++);
+
+  /*
+   * Store the identity of the operation to every element of the copy.
+   */
+  auto elementType = location->getElementType();
+  auto identity = opInfo.generateIdentityFor(location->getAccumulator(), elementType);
+  auto exitBB = createLoopOverElements(initializer, { copy }, sizeInBytes, elementType, [identity](IRBuilder<> &bodyBuilder, std::vector<Value *> &elements) -> void {
+    bodyBuilder.CreateStore(identity, elements[0]);
+  });
+  IRBuilder<> exitBuilder(exitBB);
+  exitBuilder.CreateRetVoid();
+
+  return initializer;
+}
+
+Function * DOALL::createPrivateCopyReducer (
+  const ReducibleMemoryLocation *location,
+  AccumulatorOpInfo &opInfo
+) {
+
+  /*
+   * Create the function: void (i8 *destination, i8 *source, i64 sizeInBytes)
+   */
+  auto &cxt = this->module.getContext();
+  auto int8Ptr = PointerType::getUnqual(IntegerType::get(cxt, 8));
+  auto int64 = IntegerType::get(cxt, 64);
+  auto signature = FunctionType::get(Type::getVoidTy(cxt), ArrayRef<Type *>({ int8Ptr, int8Ptr, int64 }), false);
+  auto reducer = Function::Create(signature, GlobalValue::InternalLinkage, ".noelle.reduction_merge", this->module);
+  auto args = reducer->arg_begin();
+  auto destination = &*(args++);
+  auto source = &*(args++);
+  auto sizeInBytes = &*(args++);
+
+  /*
+   * Accumulate every element of the source into the destination.
+   */
+  auto accumulator = location->getAccumulator();
+  auto exitBB = createLoopOverElements(reducer, { destination, source }, sizeInBytes, location->getElementType(), [&opInfo, accumulator](IRBuilder<> &bodyBuilder, std::vector<Value *> &elements) -> void {
+    auto accumulatedValue = bodyBuilder.CreateLoad(elements[0]);
+    auto privateValue = bodyBuilder.CreateLoad(elements[1]);
+    auto newValue = opInfo.generateAccumulation(bodyBuilder, accumulator, accumulatedValue, privateValue);
+    bodyBuilder.CreateStore(newValue, elements[0]);
+  });
+  IRBuilder<> exitBuilder(exitBB);
+  exitBuilder.CreateRetVoid();
+
+  return reducer;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+#include "DOALLTask.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+Value * DOALL::invokeTaskWithOpenMP (
+  IRBuilder<> &builder,
+  Value *envPtr,
+  Value *numCores,
+  Value *chunkSize,
+  Noelle &par
+) {
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << "DOALL:  Dispatch the parallelized loop through the OpenMP runtime\n";
+  }
+
+  /*
+   * Fetch the OpenMP code generator.
+   */
+  auto openmp = this->getOpenMPRuntime();
+
+  /*
+   * Fetch the task.
+   */
+  auto taskBody = tasks[0]->getTaskBody();
+
+  /*
+   * Create the microtask that will be executed by every thread of the OpenMP team.
+   *
+   * The DOALL task is instantiated @numCores times (one per chunk stream) independently of the number of threads libomp gives us.
+   * Each thread of the team executes the task instances assigned to it by the work-sharing loop.
+   * The schedule is "runtime" so it can be tuned with OMP_SCHEDULE.
+   */
+  auto microtask = openmp->createMicrotask({ envPtr->getType(), par.int64, par.int64 });
+  auto microtaskArgs = microtask->arg_begin();
+  microtaskArgs += 2;
+  auto envArg = &*(microtaskArgs++);
+  auto numCoresArg = &*(microtaskArgs++);
+  auto chunkSizeArg = &*(microtaskArgs++);
+  IRBuilder<> microtaskBuilder(&microtask->getEntryBlock());
+  auto invokeTaskInstance = [taskBody, envArg, numCoresArg, chunkSizeArg](IRBuilder<> &bodyBuilder, Value *instanceID) -> void {
+    bodyBuilder.CreateCall(taskBody, ArrayRef<Value *>({
+      envArg,
+      instanceID,
+      numCoresArg,
+      chunkSizeArg
+    }));
+  };
+  auto afterTasksBB = openmp->createWorksharingLoop(microtaskBuilder, microtask, numCoresArg, OpenMPRuntime::Schedule::RUNTIME, invokeTaskInstance);
+  IRBuilder<> afterTasksBuilder(afterTasksBB);
+  afterTasksBuilder.CreateRetVoid();
+
+  /*
+   * Fork the OpenMP team.
+   */
+  openmp->createForkCall(builder, microtask, { envPtr, numCores, chunkSize }, numCores);
+
+  /*
+   * All task instances have been executed when the fork returns.
+   * The number of cores can be a value computed at run time, so it is converted rather than folded (IRBuilder folds it when it is a constant).
+   */
+  auto numTaskInstancesExecuted = builder.CreateZExtOrTrunc(numCores, par.int32);
+
+  return numTaskInstancesExecuted;
+}
@@ -20,6 +20,7 @@
 #include "ParallelizationTechniqueForLoopsWithLoopCarriedDataDependences.hpp"
 #include "DSWPTask.hpp"
 #include "LoopDependenceInfo.hpp"
+#include "IVStepperUtility.hpp"
 
 namespace llvm::noelle {
 
@@ -64,6 +65,12 @@ namespace llvm::noelle {
       std::unordered_map<SCC *, DSWPTask *> sccToStage;
       std::vector<std::unique_ptr<QueueInfo>> queues;
 
+      /*
+       * Number of stage instances (including replicas) and of queues (including their copies)
+       */
+      uint64_t numberOfStageInstances;
+      uint64_t numberOfQueueCopies;
+
       /*
        * Types for arrays storing dependencies and stages
        */
@@ -104,6 +111,24 @@ namespace llvm::noelle {
         IRBuilder<> funcBuilder,
         Noelle &par
       );
+      Value * createReplicaIDsArrayFromStages (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> funcBuilder,
+        Noelle &par
+      );
+
+      /*
+       * Replication of the stages without loop-carried dependences (PS-DSWP)
+       */
+      void replicateStages (LoopDependenceInfo *LDI, Noelle &par, Heuristics *h);
+      bool canStageBeReplicated (LoopDependenceInfo *LDI, DSWPTask *task) const ;
+      void stepInductionVariablesOfReplicatedStage (LoopDependenceInfo *LDI, int taskIndex);
+      Value * fetchQueuePointer (
+        IRBuilder<> &builder,
+        QueueInfo *queueInfo,
+        QueueInstrs *queueInstrs,
+        Noelle &par
+      );
 
       /*
        * Recursively inline queue push/pop functions in DSWP Utils and ThreadPool API
@@ -38,6 +38,7 @@ namespace llvm::noelle {
        * DSWP specific task function arguments
        */
       Value *queueArg;
+      Value *replicaIDArg;
 
       /*
        * Original loops' relevant structures
@@ -45,6 +46,12 @@ namespace llvm::noelle {
       std::set<SCC *> stageSCCs;
       std::set<SCC *> clonableSCCs;
 
+      /*
+       * Number of instances of the stage.
+       * Stages without loop-carried dependences can be replicated; the i-th replica executes the iterations i, i + numberOfReplicas, ...
+       */
+      uint32_t numberOfReplicas;
+
       /*
        * Maps from producer to the queues they push to
        */
@@ -78,8 +85,15 @@ namespace llvm::noelle {
     std::set<Instruction *> consumers;
     unordered_map<Instruction *, int> consumerToPushIndex;
 
+    /*
+     * A queue connected to a replicated stage has one copy per replica.
+     * The copies are stored consecutively in the array of queues given to the stages, starting from the index firstCopy.
+     */
+    uint32_t numberOfCopies;
+    int firstCopy;
+
     QueueInfo(Instruction *p, Instruction *c, Type *type, bool isMemoryDependence)
-        : producer{p}, dependentType{type}, isMemoryDependence{isMemoryDependence} {
+        : producer{p}, dependentType{type}, isMemoryDependence{isMemoryDependence}, numberOfCopies{1}, firstCopy{0} {
       consumers.insert(c);
       if (isMemoryDependence) {
         dependentType = IntegerType::get(c->getContext(), 1);
@@ -107,5 +121,12 @@ namespace llvm::noelle {
     Value *alloca;
     Value *allocaCast;
     Value *load;
+
+    /*
+     * Stages that are not replicated access the copies of a queue in round-robin.
+     * These are the pointer to the first copy and the variable that stores the index of the next copy to access.
+     */
+    Value *copies;
+    Value *nextCopy;
   };
 }
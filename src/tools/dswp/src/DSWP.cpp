@@ -24,7 +24,9 @@ DSWP::DSWP (
   enableMergingSCC{enableSCCMerging},
   queues{}, queueArrayType{nullptr},
   sccToStage{}, stageArrayType{nullptr},
-  zeroIndexForBaseArray{nullptr}
+  zeroIndexForBaseArray{nullptr},
+  numberOfStageInstances{0},
+  numberOfQueueCopies{0}
   {
 
   /*
@@ -59,6 +61,8 @@ void DSWP::reset () {
   queueArrayType = nullptr;
   stageArrayType = nullptr;
   zeroIndexForBaseArray = nullptr;
+  numberOfStageInstances = 0;
+  numberOfQueueCopies = 0;
 }
 
 
@@ -100,12 +104,15 @@ bool DSWP::canBeAppliedToLoop (
 
     /*
      * Check the coverage of the SCC.
+     * SCCs without loop-carried dependences can be replicated, so they do not unbalance the pipeline.
      */
     auto currentSCCTotalInsts = profiles->getTotalInstructions(currentSCC);
-    if (currentSCCTotalInsts > biggestSCC){
+    if (  true
+          && (currentSCCTotalInsts > biggestSCC)
+          && (!currentSCCInfo->canExecuteIndependently())
+      ){
       biggestSCC = currentSCCTotalInsts;
     }
-    assert(biggestSCC >= currentSCCTotalInsts);
 
     /*
      * Check if the current SCC can be removed (e.g., because it is due to induction variables).
@@ -269,6 +276,11 @@ bool DSWP::apply (
   collectLiveInEnvInfo(LDI);
   collectLiveOutEnvInfo(LDI);
 
+  /*
+   * Replicate the stages without loop-carried dependences
+   */
+  replicateStages(LDI, par, h);
+
   if (this->verbose >= Verbosity::Minimal) {
     printStageSCCs(LDI);
   }
@@ -284,8 +296,8 @@ bool DSWP::apply (
    * Helper declarations
    */
   this->zeroIndexForBaseArray = cast<Value>(ConstantInt::get(par.int64, 0));
-  this->queueArrayType = ArrayType::get(PointerType::getUnqual(par.int8), this->queues.size());
-  this->stageArrayType = ArrayType::get(PointerType::getUnqual(par.int8), this->tasks.size());
+  this->queueArrayType = ArrayType::get(PointerType::getUnqual(par.int8), this->numberOfQueueCopies);
+  this->stageArrayType = ArrayType::get(PointerType::getUnqual(par.int8), this->numberOfStageInstances);
 
   /*
    * Create the pipeline stages (technique tasks)
@@ -360,6 +372,16 @@ bool DSWP::apply (
     IRBuilder<> exitBuilder(task->getExit());
     exitBuilder.CreateRetVoid();
 
+    /*
+     * The replicas of a stage execute disjoint sets of iterations.
+     */
+    if (task->numberOfReplicas > 1) {
+      stepInductionVariablesOfReplicatedStage(LDI, i);
+      if (this->verbose >= Verbosity::Maximal) {
+        errs() << "DSWP:  Stepped induction variables of the replicated stage\n";
+      }
+    }
+
     /*
      * Store final results to loop live-out variables.
      * Generate a store to propagate the information about which exit block has been taken from the parallelized loop to the code outside it.
@@ -20,7 +20,8 @@ DSWPTask::DSWPTask (
   )
   : Task{ID, taskSignature, M},
     stageSCCs{},
-    clonableSCCs{}
+    clonableSCCs{},
+    numberOfReplicas{1}
   {
 
   return ;
@@ -30,6 +31,7 @@ void DSWPTask::extractFuncArgs (void) {
   auto argIter = this->F->arg_begin();
   this->envArg = (Value *) &*(argIter++);
   this->queueArg = (Value *) &*(argIter++);
+  this->replicaIDArg = (Value *) &*(argIter++);
   instanceIndexV = ConstantInt::get(
     IntegerType::get(F->getContext(), 64),
     this->getID()
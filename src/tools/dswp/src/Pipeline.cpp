@@ -144,11 +144,17 @@ void DSWP::createPipelineFromStages (LoopDependenceInfo *LDI, Noelle &par) {
    */
   auto queueSizesPtr = createQueueSizesArrayFromStages(LDI, builder, par);
 
+  /*
+   * Allocate an array of integers.
+   * Each integer is the replica ID of a stage instance.
+   */
+  auto replicaIDsPtr = createReplicaIDsArrayFromStages(LDI, builder, par);
+
   /*
    * Call the stage dispatcher with the environment, queues array, and stages array
    */
-  auto queuesCount = cast<Value>(ConstantInt::get(par.int64, this->queues.size()));
-  auto stagesCount = cast<Value>(ConstantInt::get(par.int64, this->numTaskInstances));
+  auto queuesCount = cast<Value>(ConstantInt::get(par.int64, this->numberOfQueueCopies));
+  auto stagesCount = cast<Value>(ConstantInt::get(par.int64, this->numberOfStageInstances));
 
   /*
    * Add the call to the task dispatcher
@@ -157,6 +163,7 @@ void DSWP::createPipelineFromStages (LoopDependenceInfo *LDI, Noelle &par) {
     envPtr,
     queueSizesPtr,
     stagesPtr,
+    replicaIDsPtr,
     stagesCount,
     queuesCount
   }));
@@ -180,15 +187,22 @@ Value * DSWP::createStagesArrayFromStages (
 ) {
   auto stagesAlloca = cast<Value>(funcBuilder.CreateAlloca(this->stageArrayType));
   auto stageCastType = PointerType::getUnqual(this->tasks[0]->getTaskBody()->getType());
+  auto instanceIndex = 0;
   for (int i = 0; i < this->numTaskInstances; ++i) {
-    auto stage = this->tasks[i];
-    auto stageIndex = cast<Value>(ConstantInt::get(par.int64, i));
-    auto stagePtr = funcBuilder.CreateInBoundsGEP(stagesAlloca, ArrayRef<Value*>({
-      this->zeroIndexForBaseArray,
-      stageIndex
-    }));
-    auto stageCast = funcBuilder.CreateBitCast(stagePtr, stageCastType);
-    funcBuilder.CreateStore(stage->getTaskBody(), stageCast);
+    auto stage = (DSWPTask *)this->tasks[i];
+
+    /*
+     * Every replica of a stage is an instance of it.
+     */
+    for (auto replicaID = 0; replicaID < stage->numberOfReplicas; ++replicaID) {
+      auto stageIndex = cast<Value>(ConstantInt::get(par.int64, instanceIndex++));
+      auto stagePtr = funcBuilder.CreateInBoundsGEP(stagesAlloca, ArrayRef<Value*>({
+        this->zeroIndexForBaseArray,
+        stageIndex
+      }));
+      auto stageCast = funcBuilder.CreateBitCast(stagePtr, stageCastType);
+      funcBuilder.CreateStore(stage->getTaskBody(), stageCast);
+    }
   }
 
   return cast<Value>(funcBuilder.CreateBitCast(stagesAlloca, PointerType::getUnqual(par.int8)));
@@ -199,17 +213,45 @@ Value * DSWP::createQueueSizesArrayFromStages (
   IRBuilder<> funcBuilder,
   Noelle &par
 ) {
-  auto queuesAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, this->queues.size())));
+  auto queuesAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, this->numberOfQueueCopies)));
   for (int i = 0; i < this->queues.size(); ++i) {
     auto &queue = this->queues[i];
-    auto queueIndex = cast<Value>(ConstantInt::get(par.int64, i));
-    auto queuePtr = funcBuilder.CreateInBoundsGEP(queuesAlloca, ArrayRef<Value*>({
-      this->zeroIndexForBaseArray,
-      queueIndex
-    }));
-    auto queueCast = funcBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(par.int64));
-    funcBuilder.CreateStore(ConstantInt::get(par.int64, queue->bitLength), queueCast);
+
+    /*
+     * Every copy of a queue has the same bitwidth.
+     */
+    for (auto copy = 0; copy < queue->numberOfCopies; ++copy) {
+      auto queueIndex = cast<Value>(ConstantInt::get(par.int64, queue->firstCopy + copy));
+      auto queuePtr = funcBuilder.CreateInBoundsGEP(queuesAlloca, ArrayRef<Value*>({
+        this->zeroIndexForBaseArray,
+        queueIndex
+      }));
+      auto queueCast = funcBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(par.int64));
+      funcBuilder.CreateStore(ConstantInt::get(par.int64, queue->bitLength), queueCast);
+    }
   }
 
   return cast<Value>(funcBuilder.CreateBitCast(queuesAlloca, PointerType::getUnqual(par.int64)));
 }
+
+Value * DSWP::createReplicaIDsArrayFromStages (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> funcBuilder,
+  Noelle &par
+) {
+  auto replicaIDsAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, this->numberOfStageInstances)));
+  auto instanceIndex = 0;
+  for (int i = 0; i < this->numTaskInstances; ++i) {
+    auto stage = (DSWPTask *)this->tasks[i];
+    for (auto replicaID = 0; replicaID < stage->numberOfReplicas; ++replicaID) {
+      auto replicaIDIndex = cast<Value>(ConstantInt::get(par.int64, instanceIndex++));
+      auto replicaIDPtr = funcBuilder.CreateInBoundsGEP(replicaIDsAlloca, ArrayRef<Value*>({
+        this->zeroIndexForBaseArray,
+        replicaIDIndex
+      }));
+      funcBuilder.CreateStore(ConstantInt::get(par.int64, replicaID), replicaIDPtr);
+    }
+  }
+
+  return cast<Value>(funcBuilder.CreateBitCast(replicaIDsAlloca, PointerType::getUnqual(par.int64)));
+}
@@ -294,7 +294,15 @@ void DSWP::generateLoadsOfQueuePointers (
    */
   auto loadQueuePtrFromIndex = [&](int queueIndex) -> void {
     auto queueInfo = this->queues[queueIndex].get();
-    auto queueIndexValue = cast<Value>(ConstantInt::get(par.int64, queueIndex));
+
+    /*
+     * Fetch the copy of the queue used by the current stage.
+     * Every replica of a stage uses the copy that matches its ID.
+     */
+    Value *queueIndexValue = cast<Value>(ConstantInt::get(par.int64, queueInfo->firstCopy));
+    if (task->numberOfReplicas > 1) {
+      queueIndexValue = entryBuilder.CreateAdd(queueIndexValue, task->replicaIDArg);
+    }
     auto queuePtr = entryBuilder.CreateInBoundsGEP(queuesArray, ArrayRef<Value*>({
       this->zeroIndexForBaseArray,
       queueIndexValue
@@ -311,6 +319,18 @@ void DSWP::generateLoadsOfQueuePointers (
       queueInstrs->alloca,
       PointerType::getUnqual(queueElemType)
     );
+
+    /*
+     * A stage that is not replicated accesses all copies of the queue, starting from the first one.
+     */
+    if (  true
+          && (task->numberOfReplicas == 1)
+          && (queueInfo->numberOfCopies > 1)
+      ) {
+      queueInstrs->copies = queueCast;
+      queueInstrs->nextCopy = entryBuilder.CreateAlloca(par.int64);
+      entryBuilder.CreateStore(ConstantInt::get(par.int64, 0), queueInstrs->nextCopy);
+    }
     task->queueInstrMap[queueIndex] = std::move(queueInstrs);
   };
 
@@ -325,7 +345,6 @@ void DSWP::popValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex)
   for (auto queueIndex : task->popValueQueues) {
     auto &queueInfo = this->queues[queueIndex];
     auto queueInstrs = task->queueInstrMap[queueIndex].get();
-    auto queueCallArgs = ArrayRef<Value*>({ queueInstrs->queuePtr, queueInstrs->allocaCast });
 
     /*
      * Determine the clone of the basic block of the original producer
@@ -337,7 +356,8 @@ void DSWP::popValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex)
     Instruction *insertionPoint = clonedB->getFirstNonPHIOrDbgOrLifetime();
     IRBuilder<> builder(insertionPoint);
     auto queuePopFunction = par.queues.queuePops[par.queues.queueSizeToIndex[queueInfo->bitLength]];
-    queueInstrs->queueCall = builder.CreateCall(queuePopFunction, queueCallArgs);
+    auto queuePtr = this->fetchQueuePointer(builder, queueInfo.get(), queueInstrs, par);
+    queueInstrs->queueCall = builder.CreateCall(queuePopFunction, ArrayRef<Value*>({ queuePtr, queueInstrs->allocaCast }));
     queueInstrs->load = builder.CreateLoad(queueInstrs->alloca);
 
     /*
@@ -354,7 +374,6 @@ void DSWP::pushValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex)
   for (auto queueIndex : task->pushValueQueues) {
     auto queueInstrs = task->queueInstrMap[queueIndex].get();
     auto queueInfo = this->queues[queueIndex].get();
-    auto queueCallArgs = ArrayRef<Value*>({ queueInstrs->queuePtr, queueInstrs->allocaCast });
     auto queuePushFunction = par.queues.queuePushes[par.queues.queueSizeToIndex[queueInfo->bitLength]];
 
     /*
@@ -370,7 +389,8 @@ void DSWP::pushValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex)
     }
     IRBuilder<> builder(insertPoint);
     builder.CreateStore(producerClone, queueInstrs->alloca);
-    queueInstrs->queueCall = builder.CreateCall(queuePushFunction, queueCallArgs);
+    auto queuePtr = this->fetchQueuePointer(builder, queueInfo, queueInstrs, par);
+    queueInstrs->queueCall = builder.CreateCall(queuePushFunction, ArrayRef<Value*>({ queuePtr, queueInstrs->allocaCast }));
 
   }
 }
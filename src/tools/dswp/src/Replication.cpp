@@ -0,0 +1,362 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DSWP.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+void DSWP::replicateStages (LoopDependenceInfo *LDI, Noelle &par, Heuristics *h) {
+
+  /*
+   * Decide the number of replicas of each stage.
+   *
+   * The cost of a stage is given by the instructions it executes, which are known only with profiles.
+   * Without profiles, no stage is replicated.
+   */
+  auto profiles = par.getProfiles();
+  if (profiles->isAvailable()){
+    std::vector<uint64_t> stageCosts;
+    std::vector<bool> canStagesBeReplicated;
+    for (auto techniqueTask : this->tasks) {
+      auto task = (DSWPTask *)techniqueTask;
+
+      /*
+       * Compute the cost of the stage.
+       * Every instance of a stage executes its clonable SCCs as well.
+       */
+      uint64_t stageCost = 0;
+      for (auto scc : task->stageSCCs) {
+        stageCost += profiles->getTotalInstructions(scc);
+      }
+      for (auto scc : task->clonableSCCs) {
+        stageCost += profiles->getTotalInstructions(scc);
+      }
+      stageCosts.push_back(stageCost);
+
+      /*
+       * Check if the stage can be replicated.
+       */
+      canStagesBeReplicated.push_back(this->canStageBeReplicated(LDI, task));
+    }
+    auto replicas = h->computeReplicationFactorsForDSWP(stageCosts, canStagesBeReplicated, LDI->getMaximumNumberOfCores(), this->verbose);
+    for (auto i = 0; i < this->tasks.size(); ++i) {
+      auto task = (DSWPTask *)this->tasks[i];
+      task->numberOfReplicas = replicas[i];
+    }
+  }
+
+  /*
+   * The copies of a queue are distributed in round-robin by the stage that is not replicated.
+   * Hence, two replicated stages cannot be connected by a queue: only the producer one is kept replicated.
+   */
+  for (auto &queueInfo : this->queues) {
+    auto fromStage = (DSWPTask *)this->tasks[queueInfo->fromStage];
+    auto toStage = (DSWPTask *)this->tasks[queueInfo->toStage];
+    if (  true
+          && (fromStage->numberOfReplicas > 1)
+          && (toStage->numberOfReplicas > 1)
+      ){
+      toStage->numberOfReplicas = 1;
+    }
+  }
+
+  /*
+   * Count the stage instances.
+   */
+  this->numberOfStageInstances = 0;
+  for (auto techniqueTask : this->tasks) {
+    auto task = (DSWPTask *)techniqueTask;
+    this->numberOfStageInstances += task->numberOfReplicas;
+    if (  true
+          && (this->verbose != Verbosity::Disabled)
+          && (task->numberOfReplicas > 1)
+      ){
+      errs() << "DSWP:  Stage " << task->getID() << " is replicated " << task->numberOfReplicas << " times\n";
+    }
+  }
+
+  /*
+   * Lay out the queues: a queue connected to a replicated stage has one copy per replica.
+   */
+  this->numberOfQueueCopies = 0;
+  for (auto &queueInfo : this->queues) {
+    auto fromStage = (DSWPTask *)this->tasks[queueInfo->fromStage];
+    auto toStage = (DSWPTask *)this->tasks[queueInfo->toStage];
+    queueInfo->numberOfCopies = std::max(fromStage->numberOfReplicas, toStage->numberOfReplicas);
+    queueInfo->firstCopy = this->numberOfQueueCopies;
+    this->numberOfQueueCopies += queueInfo->numberOfCopies;
+  }
+
+  return ;
+}
+
+bool DSWP::canStageBeReplicated (LoopDependenceInfo *LDI, DSWPTask *task) const {
+
+  /*
+   * Fetch the loop.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopHeader = loopStructure->getHeader();
+  auto sccManager = LDI->getSCCManager();
+  auto sccdag = sccManager->getSCCDAG();
+
+  /*
+   * Every replica executes a disjoint set of iterations by stepping the induction variables it includes.
+   * Hence, the loop must be governed by an induction variable and it must exit only from its header.
+   */
+  auto loopGoverningIVAttr = LDI->getLoopGoverningIVAttribution();
+  if (loopGoverningIVAttr == nullptr){
+    return false;
+  }
+  for (auto exitEdge : loopStructure->getLoopExitEdges()){
+    if (exitEdge.first != loopHeader){
+      return false;
+    }
+  }
+
+  /*
+   * The replica must compute the exit condition on its own.
+   */
+  auto headerCmpSCC = sccdag->sccOfValue(loopGoverningIVAttr->getHeaderCmpInst());
+  auto headerBrSCC = sccdag->sccOfValue(loopGoverningIVAttr->getHeaderBrInst());
+  if (  false
+        || (task->clonableSCCs.find(headerCmpSCC) == task->clonableSCCs.end())
+        || (task->clonableSCCs.find(headerBrSCC) == task->clonableSCCs.end())
+    ){
+    return false;
+  }
+
+  /*
+   * The steps of the induction variables must be constant.
+   * This avoids computing them within the replicas.
+   */
+  auto ivManager = LDI->getInductionVariableManager();
+  for (auto ivInfo : ivManager->getInductionVariables(*loopStructure)) {
+    auto stepValue = ivInfo->getSingleComputedStepValue();
+    if (  false
+          || (stepValue == nullptr)
+          || (!isa<ConstantData>(stepValue))
+      ){
+      return false;
+    }
+  }
+
+  /*
+   * The only loop-carried dependences a replica can include are the ones of its induction variables.
+   */
+  for (auto scc : task->clonableSCCs) {
+    auto sccInfo = sccManager->getSCCAttrs(scc);
+    if (sccInfo->isInductionVariableSCC()){
+      continue ;
+    }
+    auto hasLoopCarriedDependences = false;
+    sccManager->iterateOverLoopCarriedDataDependences(scc, [&hasLoopCarriedDependences](DGEdge<Value> *dep) -> bool {
+      hasLoopCarriedDependences = true;
+      return true;
+    });
+    if (hasLoopCarriedDependences){
+      return false;
+    }
+  }
+
+  /*
+   * The SCCs of the stage must not have loop-carried dependences.
+   *
+   * Also, the header executes once more than the body of the loop; replicas would execute it once more each.
+   * Hence, the instructions of the stage must be outside the header.
+   */
+  std::unordered_set<Value *> stageInstructions;
+  for (auto scc : task->stageSCCs) {
+    auto sccInfo = sccManager->getSCCAttrs(scc);
+    if (!sccInfo->canExecuteIndependently()){
+      return false;
+    }
+    for (auto nodePair : scc->internalNodePairs()) {
+      auto inst = cast<Instruction>(nodePair.first);
+      if (inst->getParent() == loopHeader){
+        return false;
+      }
+      stageInstructions.insert(inst);
+    }
+  }
+  for (auto edge : LDI->getLoopDG()->getEdges()) {
+    if (!edge->isLoopCarriedDependence()){
+      continue ;
+    }
+    if (  true
+          && (stageInstructions.find(edge->getOutgoingT()) != stageInstructions.end())
+          && (stageInstructions.find(edge->getIncomingT()) != stageInstructions.end())
+      ){
+      return false;
+    }
+  }
+
+  /*
+   * Live-out values would need to be selected among the replicas.
+   */
+  auto liveOutVars = this->envBuilder->getUser(task->getID())->getEnvIndicesOfLiveOutVars();
+  if (liveOutVars.begin() != liveOutVars.end()){
+    return false;
+  }
+
+  /*
+   * The values of the queues connected to a replicated stage are distributed to the replicas based on the order they are pushed.
+   * Hence, every producer must push exactly once per iteration, and control values that would change the iterations executed by a replica cannot be consumed.
+   */
+  auto latches = loopStructure->getLatches();
+  for (auto &queueInfo : this->queues) {
+    auto isPushedByTheStage = (queueInfo->fromStage == task->getID());
+    auto isPoppedByTheStage = (queueInfo->toStage == task->getID());
+    if (  true
+          && (!isPushedByTheStage)
+          && (!isPoppedByTheStage)
+      ){
+      continue ;
+    }
+
+    /*
+     * Check the producer.
+     */
+    auto producer = queueInfo->producer;
+    auto producerBlock = producer->getParent();
+    if (  false
+          || (producerBlock == loopHeader)
+          || loopStructure->isIncludedInItsSubLoops(producer)
+      ){
+      return false;
+    }
+    for (auto latch : latches) {
+      if (!this->originalFunctionDS->DT.dominates(producerBlock, latch)){
+        return false;
+      }
+    }
+
+    /*
+     * Check the consumers.
+     */
+    if (!isPoppedByTheStage){
+      continue ;
+    }
+    for (auto consumer : queueInfo->consumers) {
+      if (consumer->isTerminator()){
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void DSWP::stepInductionVariablesOfReplicatedStage (LoopDependenceInfo *LDI, int taskIndex) {
+
+  /*
+   * Fetch the task and the loop.
+   */
+  auto task = (DSWPTask *)this->tasks[taskIndex];
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopPreHeader = loopStructure->getPreHeader();
+  auto preheaderClone = task->getCloneOfOriginalBasicBlock(loopPreHeader);
+  auto ivManager = LDI->getInductionVariableManager();
+  IRBuilder<> entryBuilder(task->getEntry()->getTerminator());
+
+  auto fetchClone = [&](Value *original) -> Value * {
+    if (isa<ConstantData>(original)) return original;
+
+    auto liveInClone = task->getCloneOfOriginalLiveIn(original);
+    if (liveInClone) return liveInClone;
+
+    assert(isa<Instruction>(original));
+    auto originalI = cast<Instruction>(original);
+    assert(task->isAnOriginalInstruction(originalI));
+    return task->getCloneOfOriginalInstruction(originalI);
+  };
+
+  /*
+   * Fetch the step values of the induction variables.
+   */
+  auto clonedStepSizeMap = this->cloneIVStepValueComputation(LDI, taskIndex, entryBuilder);
+
+  /*
+   * Step the induction variables included in the stage.
+   * replica_start: original_start + original_step_size * replica_id
+   * jump_step_size: original_step_size * (replicas - 1)
+   */
+  for (auto ivInfo : ivManager->getInductionVariables(*loopStructure)) {
+    auto originalIVPHI = ivInfo->getLoopEntryPHI();
+    if (!task->isAnOriginalInstruction(originalIVPHI)){
+      continue ;
+    }
+    auto ivPHI = cast<PHINode>(task->getCloneOfOriginalInstruction(originalIVPHI));
+    auto startOfIV = fetchClone(ivInfo->getStartValue());
+    auto stepOfIV = clonedStepSizeMap.at(ivInfo);
+
+    auto replicaOffset = entryBuilder.CreateMul(
+      stepOfIV,
+      entryBuilder.CreateZExtOrTrunc(
+        task->replicaIDArg,
+        stepOfIV->getType()
+      ),
+      "stepSize_X_replicaIdx"
+    );
+    auto offsetStartValue = IVUtility::offsetIVPHI(preheaderClone, ivPHI, startOfIV, replicaOffset);
+    ivPHI->setIncomingValueForBlock(preheaderClone, offsetStartValue);
+
+    auto jumpStepSize = entryBuilder.CreateMul(
+      stepOfIV,
+      ConstantInt::get(stepOfIV->getType(), task->numberOfReplicas - 1),
+      "nReplicasStepSize"
+    );
+    IVUtility::stepInductionVariablePHI(preheaderClone, ivPHI, jumpStepSize);
+  }
+
+  /*
+   * The loop governing induction variable can now skip the exit value.
+   * Update its condition to catch iterating past it.
+   */
+  auto loopGoverningIVAttr = LDI->getLoopGoverningIVAttribution();
+  assert(loopGoverningIVAttr != nullptr);
+  LoopGoverningIVUtility ivUtility(loopGoverningIVAttr->getInductionVariable(), *loopGoverningIVAttr);
+  auto cmpInst = cast<CmpInst>(task->getCloneOfOriginalInstruction(loopGoverningIVAttr->getHeaderCmpInst()));
+  auto brInst = cast<BranchInst>(task->getCloneOfOriginalInstruction(loopGoverningIVAttr->getHeaderBrInst()));
+  auto headerExitClone = task->getCloneOfOriginalBasicBlock(loopGoverningIVAttr->getExitBlockFromHeader());
+  ivUtility.updateConditionAndBranchToCatchIteratingPastExitValue(cmpInst, brInst, headerExitClone);
+
+  return ;
+}
+
+Value * DSWP::fetchQueuePointer (
+  IRBuilder<> &builder,
+  QueueInfo *queueInfo,
+  QueueInstrs *queueInstrs,
+  Noelle &par
+) {
+
+  /*
+   * Check if the stage accesses a single copy of the queue.
+   */
+  if (queueInstrs->nextCopy == nullptr){
+    return queueInstrs->queuePtr;
+  }
+
+  /*
+   * The stage accesses the copies of the queue in round-robin.
+   * This distributes the iterations to the replicas on the other side of the queue and it merges their values in the original order.
+   */
+  auto copyIndex = builder.CreateLoad(queueInstrs->nextCopy);
+  auto copyPtr = builder.CreateInBoundsGEP(queueInstrs->copies, copyIndex);
+  auto queuePtr = builder.CreateLoad(copyPtr);
+  auto nextCopyIndex = builder.CreateAdd(copyIndex, ConstantInt::get(par.int64, 1));
+  auto isLastCopy = builder.CreateICmpEQ(nextCopyIndex, ConstantInt::get(par.int64, queueInfo->numberOfCopies));
+  auto newCopyIndex = builder.CreateSelect(isLastCopy, ConstantInt::get(par.int64, 0), nextCopyIndex);
+  builder.CreateStore(newCopyIndex, queueInstrs->nextCopy);
+
+  return queuePtr;
+}
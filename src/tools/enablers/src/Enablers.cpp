@@ -20,7 +20,8 @@ bool EnablersManager::applyEnablers (
     LoopUnroll &loopUnroll,
     LoopWhilifier &loopWhilifier,
     LoopInvariantCodeMotion &loopInvariantCodeMotion,
-    SCEVSimplification &scevSimplification
+    SCEVSimplification &scevSimplification,
+    LoopAliasVersioning &loopAliasVersioning
     ){
 
   /*
@@ -86,6 +87,21 @@ bool EnablersManager::applyEnablers (
     }
   }
 
+  /*
+  * Version loops with run-time alias checks.
+  * The versioned loop is only useful if DOALL can parallelize it.
+  */
+  if (  true
+        && par.isTransformationEnabled(Transformation::LOOP_ALIAS_VERSIONING_ID)
+        && par.isTransformationEnabled(Transformation::DOALL_ID)
+    ){
+    errs() << "EnablersManager:   Try to version loops with run-time alias checks\n";
+    if (this->applyLoopAliasVersioning(LDI, par, loopAliasVersioning)){
+      errs() << "EnablersManager:     The loop has been versioned\n";
+      return true;
+    }
+  }
+
   return false;
 }
 
@@ -280,3 +296,26 @@ bool EnablersManager::applyDevirtualizer (
 
   return modified;
 }
+
+bool EnablersManager::applyLoopAliasVersioning (
+    LoopDependenceInfo *LDI,
+    Noelle &par,
+    LoopAliasVersioning &loopAliasVersioning
+    ){
+
+  /*
+  * Fetch the analyses of the function that includes the loop.
+  * The loop access analysis is fetched last because fetching an analysis recomputes the others, and the loop access analysis keeps a pointer to the scalar evolution it has been computed with.
+  */
+  auto &loopFunction = *LDI->getLoopStructure()->getFunction();
+  auto& LI = getAnalysis<LoopInfoWrapperPass>(loopFunction).getLoopInfo();
+  auto& DT = getAnalysis<DominatorTreeWrapperPass>(loopFunction).getDomTree();
+  auto& LAA = getAnalysis<LoopAccessLegacyAnalysis>(loopFunction);
+
+  /*
+  * Version the loop.
+  */
+  auto modified = loopAliasVersioning.versionLoop(*LDI, LI, DT, LAA);
+
+  return modified;
+}
@@ -47,6 +47,7 @@ bool EnablersManager::runOnModule (Module &M) {
   auto loopWhilify = LoopWhilifier(noelle);
   auto loopInvariantCodeMotion = LoopInvariantCodeMotion(noelle);
   auto scevSimplification = SCEVSimplification(noelle);
+  auto loopAliasVersioning = LoopAliasVersioning();
 
   /*
   * Fetch all the loops we want to parallelize.
@@ -89,7 +90,8 @@ bool EnablersManager::runOnModule (Module &M) {
       loopUnroll,
       loopWhilify,
       loopInvariantCodeMotion,
-      scevSimplification
+      scevSimplification,
+      loopAliasVersioning
     );
     modified |= modifiedFunctions[f];
   }
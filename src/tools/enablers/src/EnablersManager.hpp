@@ -21,6 +21,7 @@
 #include "LoopDistribution.hpp"
 #include "LoopUnroll.hpp"
 #include "LoopWhilify.hpp"
+#include "LoopAliasVersioning.hpp"
 #include "LoopInvariantCodeMotion.hpp"
 #include "SCEVSimplification.hpp"
 
@@ -64,7 +65,8 @@ namespace llvm::noelle {
         LoopUnroll &loopUnroll,
         LoopWhilifier &LoopWhilifier,
         LoopInvariantCodeMotion &loopInvariantCodeMotion,
-        SCEVSimplification &scevSimplification
+        SCEVSimplification &scevSimplification,
+        LoopAliasVersioning &loopAliasVersioning
         );
 
       bool applyLoopWhilifier (
@@ -84,6 +86,12 @@ namespace llvm::noelle {
         Noelle &par,
         LoopUnroll &loopUnroll
         );
+
+      bool applyLoopAliasVersioning (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        LoopAliasVersioning &loopAliasVersioning
+        );
   };
 
 }
@@ -34,6 +34,7 @@ void EnablersManager::getAnalysisUsage (AnalysisUsage &AU) const {
   AU.addRequired<DominatorTreeWrapperPass>();
   AU.addRequired<ScalarEvolutionWrapperPass>();
   AU.addRequired<AssumptionCacheTracker>();
+  AU.addRequired<LoopAccessLegacyAnalysis>();
 
   /*
   * Noelle framework.
@@ -80,6 +80,15 @@ namespace llvm::noelle {
         uint64_t numberOfSequentialSegments
       );
 
+      Value * invokeTaskWithOpenMP (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> &builder,
+        Value *envPtr,
+        Value *loopCarriedEnvPtr,
+        uint64_t numberOfSequentialSegments,
+        Noelle &par
+      );
+
       void spillLoopCarriedDataDependencies (
         LoopDependenceInfo *LDI,
         DataFlowResult *reachabilityDFR
@@ -123,6 +132,11 @@ namespace llvm::noelle {
         LoopDependenceInfo *LDI,
         DataFlowResult *reachabilityDFR
       );
+
+      int64_t computeDependenceDistanceOfSCC (
+        SCCDAGAttrs *sccManager,
+        SCC *scc
+      ) const ;
  
       void squeezeSequentialSegments (
         LoopDependenceInfo *LDI,
@@ -133,7 +147,7 @@ namespace llvm::noelle {
       void scheduleSequentialSegments (
         LoopDependenceInfo *LDI,
         std::vector<SequentialSegment *> *sss,
-        DataFlowResult *reachabilityDFR
+        Hot *profiles
       );
 
       void addSynchronizations (
@@ -149,6 +163,27 @@ namespace llvm::noelle {
         LoopDependenceInfo *LDI
       );
 
+      /*
+       * Number of consecutive iterations assigned to a core before the sequential segments are forwarded to the next core.
+       */
+      uint64_t computeChunkSize (
+        LoopDependenceInfo *LDI,
+        Noelle &par
+      ) const ;
+
+      double computeMinimumInstructionsPerChunk (
+        LoopDependenceInfo *LDI
+      ) const ;
+
+      /*
+       * Estimate the instructions per iteration on the critical path of the loop parallelized with chunks of @chunkSize iterations.
+       */
+      double estimateInstructionsPerIteration (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        uint64_t chunkSize
+      ) const ;
+
     private:
       Function *waitSSCall, *signalSSCall;
       LoopDependenceInfo *originalLDI;
@@ -158,6 +193,7 @@ namespace llvm::noelle {
       std::unordered_set<SpilledLoopCarriedDependency *> spills;
       std::unordered_map<Instruction *, Instruction *> lastIterationExecutionDuplicateMap;
       BasicBlock *lastIterationExecutionBlock;
+      uint64_t chunkSize;
       bool enableInliner;
       Function *taskDispatcherSS;
       Function *taskDispatcherCS;
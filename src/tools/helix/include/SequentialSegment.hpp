@@ -32,6 +32,14 @@ namespace llvm::noelle {
 
       int32_t getID (void);
 
+      /*
+       * Number of iterations between an iteration and the earlier one it needs to wait for before entering the sequential segment.
+       * This is 1 unless all loop-carried dependences of the segment have a known, longer distance.
+       */
+      int64_t getDependenceDistance (void) const ;
+
+      void setDependenceDistance (int64_t distance) ;
+
       iterator_range<unordered_set<SCC *>::iterator> getSCCs(void) ; 
 
       std::unordered_set<Instruction *> getInstructions (void) ;
@@ -42,6 +50,7 @@ namespace llvm::noelle {
       SCCSet *sccs;
       int32_t ID;
       Verbosity verbosity;
+      int64_t dependenceDistance;
 
       void determineEntryAndExitFrontier (
         LoopDependenceInfo *LDI,
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "HELIX.hpp"
+#include "Architecture.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+double HELIX::computeMinimumInstructionsPerChunk (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * Every chunk of iterations needs to forward the sequential segments to the next core.
+   * Hence, chunks shorter than the latency of this forwarding spend most of their time waiting.
+   */
+  double minimumInstructions = 20;
+  if (Architecture::isCommunicationCostModelCalibrated()){
+    auto distance = Architecture::getDistanceOfCores(LDI->getMaximumNumberOfCores());
+    minimumInstructions = Architecture::fromNanosecondsToInstructions(Architecture::getCoreToCoreLatency(distance));
+  }
+
+  return minimumInstructions;
+}
+
+uint64_t HELIX::computeChunkSize (
+  LoopDependenceInfo *LDI,
+  Noelle &par
+) const {
+
+  /*
+   * Fetch the profiles.
+   * Without them, we cannot estimate the cost of an iteration and we assign iterations to cores one at a time.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto profiles = par.getProfiles();
+  if (!profiles->isAvailable()){
+    return 1;
+  }
+  auto instsPerIteration = profiles->getAverageTotalInstructionsPerIteration(loopStructure);
+  if (  false
+        || (instsPerIteration < 1)
+        || std::isinf(instsPerIteration)
+    ){
+    return 1;
+  }
+
+  /*
+   * A chunk should execute enough instructions to amortize forwarding the sequential segments to the next core.
+   */
+  auto minimumInstructionsPerChunk = this->computeMinimumInstructionsPerChunk(LDI);
+  auto chunkSize = (uint64_t)std::ceil(minimumInstructionsPerChunk / instsPerIteration);
+
+  /*
+   * Every core should get at least one chunk per invocation of the loop.
+   */
+  if (profiles->getInvocations(loopStructure) > 0){
+    auto iterationsPerInvocation = profiles->getAverageLoopIterationsPerInvocation(loopStructure);
+    auto maximumChunkSize = (uint64_t)(iterationsPerInvocation / LDI->getMaximumNumberOfCores());
+    chunkSize = std::min(chunkSize, maximumChunkSize);
+  }
+
+  /*
+   * Iterations of a chunk run their sequential segments back to back on the same core.
+   * Large chunks would serialize the loop, so we bound them.
+   */
+  uint64_t maximumChunkSize = 64;
+  chunkSize = std::min(chunkSize, maximumChunkSize);
+  chunkSize = std::max(chunkSize, (uint64_t)1);
+
+  /*
+   * Chunks shorten the critical path only if they hide more forwarding latency than the parallel code they serialize.
+   */
+  if (this->estimateInstructionsPerIteration(LDI, par, chunkSize) >= this->estimateInstructionsPerIteration(LDI, par, 1)){
+    return 1;
+  }
+
+  return chunkSize;
+}
+
+double HELIX::estimateInstructionsPerIteration (
+  LoopDependenceInfo *LDI,
+  Noelle &par,
+  uint64_t chunkSize
+) const {
+
+  /*
+   * Fetch the instructions of an iteration and split them into sequential (T_ss) and parallel (T_par) ones.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto profiles = par.getProfiles();
+  auto instsPerIteration = profiles->getAverageTotalInstructionsPerIteration(loopStructure);
+  auto sequentialInstructions = instsPerIteration * this->computeSequentialFractionOfExecution(LDI, par);
+  auto parallelInstructions = instsPerIteration - sequentialInstructions;
+  auto latency = this->computeMinimumInstructionsPerChunk(LDI);
+
+  /*
+   * The iterations of a chunk execute back to back on the same core.
+   * Hence, the sequential segments of a chunk of K iterations are forwarded to the next core after K * T_ss + (K - 1) * T_par + L instructions, where L is the latency of the forwarding.
+   * Furthermore, the cores cannot execute iterations faster than they have instructions to execute.
+   */
+  auto K = (double)chunkSize;
+  auto criticalPathPerChunk = (K * sequentialInstructions) + ((K - 1) * parallelInstructions) + latency;
+  auto criticalPathPerIteration = criticalPathPerChunk / K;
+  auto workPerIteration = instsPerIteration / LDI->getMaximumNumberOfCores();
+
+  return std::max(criticalPathPerIteration, workPerIteration);
+}
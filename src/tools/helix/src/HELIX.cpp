@@ -23,6 +23,7 @@ HELIX::HELIX (
     loopCarriedEnvBuilder{nullptr}, 
     taskFunctionDG{nullptr},
     lastIterationExecutionBlock{nullptr},
+    chunkSize{1},
     enableInliner{true}
   {
 
@@ -117,7 +118,8 @@ bool HELIX::canBeAppliedToLoop (LoopDependenceInfo *LDI, Noelle &par, Heuristics
   auto loopID = LDI->getID();
   auto loopStructure = LDI->getLoopStructure();
   auto averageInstructions = profiles->getAverageTotalInstructionsPerIteration(loopStructure);
-  auto averageInstructionThreshold = 20;
+  auto averageInstructionThreshold = this->computeMinimumInstructionsPerChunk(LDI);
+
   bool hasLittleExecution = averageInstructions < averageInstructionThreshold;
   auto maximumSequentialFraction = .2;
   auto sequentialFraction = this->computeSequentialFractionOfExecution(LDI, par);
@@ -134,6 +136,22 @@ bool HELIX::canBeAppliedToLoop (LoopDependenceInfo *LDI, Noelle &par, Heuristics
     return false;
   }
 
+  /*
+   * The critical path of the parallelized loop must be shorter than the sequential execution of its iterations.
+   */
+  if (!profiles->isAvailable()){
+    return true;
+  }
+  auto chunkSize = this->computeChunkSize(LDI, par);
+  auto parallelInstructions = this->estimateInstructionsPerIteration(LDI, par, chunkSize);
+  if (parallelInstructions >= averageInstructions){
+    errs() << "Parallelizer:    Loop " << loopID << " has "
+      << parallelInstructions << " instructions per iteration on the critical path with chunks of " << chunkSize << " iterations\n";
+    errs() << "Parallelizer:      It will not be faster than its " << averageInstructions << " sequential instructions per iteration\n";
+
+    return false;
+  }
+
   return true ;
 }
 
@@ -246,6 +264,14 @@ void HELIX::createParallelizableTask (
   this->numTaskInstances = LDI->getMaximumNumberOfCores();
   assert(helixTask == this->tasks[0]);
 
+  /*
+   * Choose the number of consecutive iterations each core executes before handing the sequential segments off to the next core.
+   */
+  this->chunkSize = this->computeChunkSize(LDI, par);
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << "HELIX:  Chunk size = " << this->chunkSize << "\n";
+  }
+
   /*
    * Fetch the indices of live-in and live-out variables of the loop being parallelized.
    */
@@ -384,6 +410,12 @@ bool HELIX::synchronizeTask (
   auto sequentialSegments = this->identifySequentialSegments(originalLDI, LDI, reachabilityDFR);
   this->squeezeSequentialSegments(LDI, &sequentialSegments, reachabilityDFR);
 
+  /*
+   * Schedule the sequential segments to overlap parallel and sequential segments.
+   * Like squeezing, this moves instructions, so it must happen before the entry and exit frontiers are computed.
+   */
+  this->scheduleSequentialSegments(LDI, &sequentialSegments, par.getProfiles());
+
   /*
    * Free the memory.
    */
@@ -402,11 +434,6 @@ bool HELIX::synchronizeTask (
   reachabilityDFR = this->computeReachabilityFromInstructions(LDI);
   sequentialSegments = this->identifySequentialSegments(originalLDI, LDI, reachabilityDFR);
 
-  /*
-   * Schedule the sequential segments to overlap parallel and sequential segments.
-   */
-  this->scheduleSequentialSegments(LDI, &sequentialSegments, reachabilityDFR);
-
   /*
    * Delete reachability results here before we decide whether to continue with the HELIX parallelization
    */
@@ -17,7 +17,8 @@ HELIXTask::HELIXTask(
   FunctionType *taskSignature,
   Module &M
   )
-  :Task{0, taskSignature, M}
+  :Task{0, taskSignature, M},
+   chunkPHI{nullptr}
   {
 
   return ;
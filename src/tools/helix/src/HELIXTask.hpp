@@ -42,6 +42,12 @@ namespace llvm::noelle {
       PHINode *originalIVClone;
       PHINode *outermostLoopIV;
 
+      /*
+       * Position of the current iteration within the chunk of consecutive iterations executed by the core.
+       * It is nullptr if iterations are assigned to cores one at a time.
+       */
+      PHINode *chunkPHI;
+
       /*
        * Synchronization calls (waits, signals)
        */
@@ -75,9 +75,19 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
    */
   auto clonedStepSizeMap = cloneIVStepValueComputation(LDI, 0, entryBuilder);
 
+  /*
+   * Each core executes chunks of consecutive iterations.
+   * Track the position of the current iteration within its chunk. This is used to jump to the next chunk of the core and to synchronize sequential segments once per chunk.
+   */
+  if (this->chunkSize > 1){
+    auto chunkCounterType = IntegerType::get(entryBuilder.getContext(), 64);
+    auto chunkSizeValue = ConstantInt::get(chunkCounterType, this->chunkSize);
+    task->chunkPHI = IVUtility::createChunkPHI(preheaderClone, headerClone, chunkCounterType, chunkSizeValue);
+  }
+
   /*
    * Determine start value of the IV for the task
-   * core_start: original_start + original_step_size * core_id
+   * core_start: original_start + original_step_size * core_id * chunk_size
    */
   for (auto ivInfo : ivInfos) {
     auto startOfIV = fetchClone(ivInfo->getStartValue());
@@ -86,7 +96,10 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
     auto ivPHI = cast<PHINode>(fetchClone(originalIVPHI));
 
     auto nthCoreOffset = entryBuilder.CreateMul(
-      stepOfIV,
+      entryBuilder.CreateMul(
+        stepOfIV,
+        ConstantInt::get(stepOfIV->getType(), this->chunkSize)
+      ),
       entryBuilder.CreateZExtOrTrunc(
         task->coreArg,
         stepOfIV->getType()
@@ -100,7 +113,9 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
 
   /*
    * Determine additional step size to account for n cores each executing the task
-   * jump_step_size: original_step_size * (num_cores - 1)
+   * jump_step_size: original_step_size * (num_cores - 1) * chunk_size
+   *
+   * With chunks, the additional step is only taken when moving from the last iteration of a chunk to the first one of the next chunk.
    */
   for (auto ivInfo : ivInfos) {
     auto stepOfIV = clonedStepSizeMap.at(ivInfo);
@@ -108,7 +123,10 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
     auto ivPHI = cast<PHINode>(fetchClone(originalIVPHI));
 
     auto jumpStepSize = entryBuilder.CreateMul(
-      stepOfIV,
+      entryBuilder.CreateMul(
+        stepOfIV,
+        ConstantInt::get(stepOfIV->getType(), this->chunkSize)
+      ),
       entryBuilder.CreateSub(
         entryBuilder.CreateZExtOrTrunc(
           task->numCoresArg,
@@ -119,7 +137,11 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
       "nCoresStepSize"
     );
 
-    IVUtility::stepInductionVariablePHI(preheaderClone, ivPHI, jumpStepSize);
+    if (task->chunkPHI != nullptr){
+      IVUtility::chunkInductionVariablePHI(preheaderClone, ivPHI, task->chunkPHI, jumpStepSize);
+    } else {
+      IVUtility::stepInductionVariablePHI(preheaderClone, ivPHI, jumpStepSize);
+    }
   }
 
   /*
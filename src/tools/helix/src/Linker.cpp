@@ -10,6 +10,7 @@
  */
 #include "HELIX.hpp"
 #include "HELIXTask.hpp"
+#include "Architecture.hpp"
 
 using namespace llvm;
 using namespace llvm::noelle;
@@ -58,14 +59,20 @@ void HELIX::addChunkFunctionExecutionAsideOriginalLoop (
    * Call the function that incudes the parallelized loop.
    */
   IRBuilder<> helixBuilder(this->entryPointOfParallelizedLoop);
-  auto runtimeCall = helixBuilder.CreateCall(this->taskDispatcherSS, ArrayRef<Value *>({
-    (Value *)tasks[0]->getTaskBody(),
-    envPtr,
-    loopCarriedEnvPtr,
-    numCores,
-    numOfSS
-  }));
-  auto numThreadsUsed = helixBuilder.CreateExtractValue(runtimeCall, (uint64_t)0);
+  Value *numThreadsUsed = nullptr;
+  if (this->getParallelizationRuntime() == ParallelizationRuntime::OPENMP){
+    numThreadsUsed = this->invokeTaskWithOpenMP(LDI, helixBuilder, envPtr, loopCarriedEnvPtr, numberOfSequentialSegments, par);
+
+  } else {
+    auto runtimeCall = helixBuilder.CreateCall(this->taskDispatcherSS, ArrayRef<Value *>({
+      (Value *)tasks[0]->getTaskBody(),
+      envPtr,
+      loopCarriedEnvPtr,
+      numCores,
+      numOfSS
+    }));
+    numThreadsUsed = helixBuilder.CreateExtractValue(runtimeCall, (uint64_t)0);
+  }
 
   /*
    * Propagate the last value of live-out variables to the code outside the parallelized loop.
@@ -77,3 +84,155 @@ void HELIX::addChunkFunctionExecutionAsideOriginalLoop (
 
   return ;
 }
+
+Value * HELIX::invokeTaskWithOpenMP (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> &builder,
+  Value *envPtr,
+  Value *loopCarriedEnvPtr,
+  uint64_t numberOfSequentialSegments,
+  Noelle &par
+) {
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << "HELIX:  Dispatch the parallelized loop through the OpenMP runtime\n";
+  }
+
+  /*
+   * Fetch the OpenMP code generator.
+   */
+  auto openmp = this->getOpenMPRuntime();
+
+  /*
+   * Fetch the loop function.
+   */
+  auto loopFunction = LDI->getLoopStructure()->getFunction();
+  auto &cxt = loopFunction->getContext();
+  auto int8Ptr = PointerType::getUnqual(par.int8);
+  auto int32Ptr = PointerType::getUnqual(par.int32);
+  auto int64Ptr = PointerType::getUnqual(par.int64);
+
+  /*
+   * Fetch the pthread APIs used to initialize the sequential segments.
+   * Sequential segments are synchronized by HELIX_wait and HELIX_signal, which rely on pthread spinlocks.
+   */
+  auto spinInit = this->module.getOrInsertFunction("pthread_spin_init", FunctionType::get(par.int32, { int32Ptr, par.int32 }, false));
+  auto spinLock = this->module.getOrInsertFunction("pthread_spin_lock", FunctionType::get(par.int32, { int32Ptr }, false));
+
+  /*
+   * Allocate the variables shared with the OpenMP team at the beginning of the function that includes the loop.
+   *
+   * Each thread of the team has its own sequential segment array.
+   * The number of threads of the team is at most the number of cores requested.
+   */
+  auto maxCores = LDI->getMaximumNumberOfCores();
+  auto ssArraySize = numberOfSequentialSegments * Architecture::getCacheLineBytes();
+  IRBuilder<> allocaBuilder(&*loopFunction->begin()->begin());
+  Value *ssArrays = ConstantPointerNull::get(int8Ptr);
+  if (numberOfSequentialSegments > 0){
+    auto ssArraysAlloca = allocaBuilder.CreateAlloca(par.int8, ConstantInt::get(par.int64, maxCores * ssArraySize));
+    ssArraysAlloca->setAlignment(Architecture::getCacheLineBytes());
+    ssArrays = ssArraysAlloca;
+  }
+  auto loopIsOverFlag = allocaBuilder.CreateAlloca(par.int64);
+  auto numThreadsUsedPtr = allocaBuilder.CreateAlloca(par.int32);
+  builder.CreateStore(ConstantInt::get(par.int64, 0), loopIsOverFlag);
+
+  /*
+   * Create the microtask that will be executed by every thread of the OpenMP team.
+   */
+  auto microtask = openmp->createMicrotask({ int8Ptr, int8Ptr, int8Ptr, int64Ptr, int32Ptr });
+  auto microtaskArgs = microtask->arg_begin();
+  microtaskArgs += 2;
+  auto envArg = &*(microtaskArgs++);
+  auto loopCarriedEnvArg = &*(microtaskArgs++);
+  auto ssArraysArg = &*(microtaskArgs++);
+  auto loopIsOverFlagArg = &*(microtaskArgs++);
+  auto numThreadsUsedArg = &*(microtaskArgs++);
+  IRBuilder<> microtaskBuilder(&microtask->getEntryBlock());
+  auto gtid = openmp->getGlobalThreadID(microtaskBuilder, microtask);
+  auto threadID = microtaskBuilder.CreateSExt(openmp->createGetThreadNum(microtaskBuilder), par.int64);
+  auto numThreads = microtaskBuilder.CreateSExt(openmp->createGetNumThreads(microtaskBuilder), par.int64);
+
+  /*
+   * Identify the past and future sequential segment arrays of the current thread.
+   */
+  auto fetchSSArray = [&microtaskBuilder, ssArraysArg, ssArraySize, &par](Value *ssArrayID) -> Value * {
+    auto offset = microtaskBuilder.CreateMul(ssArrayID, ConstantInt::get(par.int64, ssArraySize));
+    return microtaskBuilder.CreateInBoundsGEP(ssArraysArg, offset);
+  };
+  Value *ssArrayPast = ssArraysArg;
+  Value *ssArrayFuture = ssArraysArg;
+  if (numberOfSequentialSegments > 0){
+    auto nextThreadID = microtaskBuilder.CreateURem(
+      microtaskBuilder.CreateAdd(threadID, ConstantInt::get(par.int64, 1)),
+      numThreads
+    );
+    ssArrayPast = fetchSSArray(threadID);
+    ssArrayFuture = fetchSSArray(nextThreadID);
+
+    /*
+     * Initialize the locks of the past array of the current thread.
+     * Only the first thread of the team can enter the sequential segments of its first iteration.
+     */
+    std::vector<Value *> locks;
+    for (auto ssID = 0; ssID < numberOfSequentialSegments; ssID++){
+      auto lockPtr = microtaskBuilder.CreateInBoundsGEP(ssArrayPast, ConstantInt::get(par.int64, ssID * Architecture::getCacheLineBytes()));
+      auto lock = microtaskBuilder.CreateBitCast(lockPtr, int32Ptr);
+      microtaskBuilder.CreateCall(spinInit, { lock, ConstantInt::get(par.int32, 0) });
+      locks.push_back(lock);
+    }
+    auto lockBB = BasicBlock::Create(cxt, "", microtask);
+    auto afterLockBB = BasicBlock::Create(cxt, "", microtask);
+    auto isNotFirstThread = microtaskBuilder.CreateICmpNE(threadID, ConstantInt::get(par.int64, 0));
+    microtaskBuilder.CreateCondBr(isNotFirstThread, lockBB, afterLockBB);
+    IRBuilder<> lockBuilder(lockBB);
+    for (auto lock : locks){
+      lockBuilder.CreateCall(spinLock, { lock });
+    }
+    lockBuilder.CreateBr(afterLockBB);
+    microtaskBuilder.SetInsertPoint(afterLockBB);
+
+    /*
+     * Wait for all threads of the team to initialize their sequential segments.
+     */
+    openmp->createBarrier(microtaskBuilder, gtid);
+  }
+
+  /*
+   * Report the number of threads that executed the task.
+   */
+  auto storeBB = BasicBlock::Create(cxt, "", microtask);
+  auto invokeBB = BasicBlock::Create(cxt, "", microtask);
+  auto isFirstThread = microtaskBuilder.CreateICmpEQ(threadID, ConstantInt::get(par.int64, 0));
+  microtaskBuilder.CreateCondBr(isFirstThread, storeBB, invokeBB);
+  IRBuilder<> storeBuilder(storeBB);
+  storeBuilder.CreateStore(storeBuilder.CreateTrunc(numThreads, par.int32), numThreadsUsedArg);
+  storeBuilder.CreateBr(invokeBB);
+
+  /*
+   * Invoke the HELIX task.
+   */
+  IRBuilder<> invokeBuilder(invokeBB);
+  invokeBuilder.CreateCall(tasks[0]->getTaskBody(), ArrayRef<Value *>({
+    envArg,
+    loopCarriedEnvArg,
+    ssArrayPast,
+    ssArrayFuture,
+    threadID,
+    numThreads,
+    loopIsOverFlagArg
+  }));
+  invokeBuilder.CreateRetVoid();
+
+  /*
+   * Fork the OpenMP team.
+   */
+  openmp->createForkCall(builder, microtask, { envPtr, loopCarriedEnvPtr, ssArrays, loopIsOverFlag, numThreadsUsedPtr }, ConstantInt::get(par.int64, maxCores));
+
+  /*
+   * Fetch the number of threads that executed the task.
+   */
+  auto numThreadsUsed = builder.CreateLoad(numThreadsUsedPtr);
+
+  return numThreadsUsed;
+}
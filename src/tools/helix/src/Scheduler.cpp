@@ -9,12 +9,33 @@
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "HELIX.hpp"
+#include "HELIXTask.hpp"
 #include "llvm/IR/CFG.h"
+#include "llvm/Analysis/ValueTracking.h"
 #include "SCCPartitionScheduler.hpp"
 
 using namespace llvm;
 using namespace llvm::noelle;
 
+static std::vector<Instruction *> listScheduleInstructions (
+  std::vector<Instruction *> &instructions,
+  PDG *taskDG,
+  std::unordered_set<Instruction *> &ssInstructions,
+  std::unordered_map<Instruction *, uint64_t> &latencies
+  );
+
+static bool mustPreserveOrder (
+  Instruction *first,
+  Instruction *second,
+  PDG *taskDG
+  );
+
+static uint64_t computeSequentialSegmentsCriticalPath (
+  std::vector<Instruction *> &schedule,
+  std::unordered_set<Instruction *> &ssInstructions,
+  std::unordered_map<Instruction *, uint64_t> &latencies
+  );
+
 /*
  * Heuristic used: push furthest outlier instructions closer to the rest of the sequential segment
  * by moving between control flow equivalent sets of basic blocks
@@ -67,12 +88,353 @@ void HELIX::squeezeSequentialSegments (
   return ;
 }
 
+/*
+ * Heuristic used: list schedule every basic block of the loop body so that the instructions of the sequential segments,
+ * and the instructions they depend on, execute as early as possible within an iteration.
+ * The remaining instructions are sunk below them.
+ * This shortens the path between the wait and the signal of a sequential segment, which is the critical path of HELIX.
+ */
 void HELIX::scheduleSequentialSegments (
   LoopDependenceInfo *LDI,
   std::vector<SequentialSegment *> *sss,
-  DataFlowResult *reachabilityDFR
+  Hot *profiles
   ){
-  //TODO
+
+  /*
+   * Fetch the HELIX task and its internal dependence graph.
+   */
+  auto helixTask = static_cast<HELIXTask *>(this->tasks[0]);
+  auto taskDG = LDI->getLoopDG();
+  auto loopStructure = LDI->getLoopStructure();
+
+  /*
+   * Collect the instructions of the sequential segments.
+   * PHIs must stay at the top of their basic blocks, so they are not scheduled.
+   */
+  std::unordered_set<Instruction *> ssInstructions;
+  for (auto ss : *sss){
+    for (auto inst : ss->getInstructions()){
+      if (isa<PHINode>(inst)) {
+        continue ;
+      }
+      ssInstructions.insert(inst);
+    }
+  }
+  if (ssInstructions.size() == 0){
+    return ;
+  }
+
+  /*
+   * Estimate the latency of the instructions of the loop.
+   * Every instruction costs one, except calls for which the profiles tell us the number of instructions executed per invocation (callees included).
+   */
+  std::unordered_map<Instruction *, uint64_t> latencies;
+  for (auto bb : loopStructure->getBasicBlocks()){
+    for (auto &inst : *bb){
+      latencies[&inst] = 1;
+    }
+  }
+  if (profiles->isAvailable()){
+    for (auto originalInst : helixTask->getOriginalInstructions()){
+      if (!isa<CallInst>(originalInst)){
+        continue ;
+      }
+      auto cloneInst = helixTask->getCloneOfOriginalInstruction(originalInst);
+      if (latencies.find(cloneInst) == latencies.end()){
+        continue ;
+      }
+      auto invocations = profiles->getInvocations(originalInst);
+      if (invocations == 0){
+        continue ;
+      }
+      latencies[cloneInst] = std::max(profiles->getTotalInstructions(originalInst) / invocations, (uint64_t)1);
+    }
+  }
+
+  /*
+   * Schedule the basic blocks of the loop one at a time.
+   */
+  uint64_t criticalPathBefore = 0;
+  uint64_t criticalPathAfter = 0;
+  for (auto bb : loopStructure->getBasicBlocks()){
+
+    /*
+     * Fetch the instructions that can be scheduled.
+     * PHIs, landing pads, and the terminator do not move.
+     */
+    std::vector<Instruction *> instructions;
+    auto terminator = bb->getTerminator();
+    for (auto it = bb->getFirstInsertionPt(); &*it != terminator; it++){
+      instructions.push_back(&*it);
+    }
+
+    /*
+     * Check if there is anything to gain in this basic block.
+     */
+    uint64_t ssInstructionsInBB = 0;
+    for (auto inst : instructions){
+      if (ssInstructions.find(inst) != ssInstructions.end()){
+        ssInstructionsInBB++;
+      }
+    }
+    if (  false
+          || (ssInstructionsInBB == 0)
+          || (ssInstructionsInBB == instructions.size())
+      ){
+      auto criticalPath = computeSequentialSegmentsCriticalPath(instructions, ssInstructions, latencies);
+      criticalPathBefore += criticalPath;
+      criticalPathAfter += criticalPath;
+      continue ;
+    }
+
+    /*
+     * Schedule the instructions.
+     */
+    auto schedule = listScheduleInstructions(instructions, taskDG, ssInstructions, latencies);
+    auto oldCriticalPath = computeSequentialSegmentsCriticalPath(instructions, ssInstructions, latencies);
+    auto newCriticalPath = computeSequentialSegmentsCriticalPath(schedule, ssInstructions, latencies);
+    criticalPathBefore += oldCriticalPath;
+
+    /*
+     * Keep the original order if the new one does not shorten the sequential segments.
+     */
+    if (newCriticalPath >= oldCriticalPath){
+      criticalPathAfter += oldCriticalPath;
+      continue ;
+    }
+    criticalPathAfter += newCriticalPath;
+
+    /*
+     * Reorder the instructions.
+     */
+    for (auto inst : schedule){
+      inst->moveBefore(terminator);
+    }
+  }
+
+  /*
+   * Print the predicted change of the critical path.
+   */
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << "HELIX:  Sequential segments critical path: " << criticalPathBefore << " -> " << criticalPathAfter << " instructions per iteration\n";
+  }
 
   return ;
 }
+
+static std::vector<Instruction *> listScheduleInstructions (
+  std::vector<Instruction *> &instructions,
+  PDG *taskDG,
+  std::unordered_set<Instruction *> &ssInstructions,
+  std::unordered_map<Instruction *, uint64_t> &latencies
+  ){
+  auto n = instructions.size();
+  std::unordered_map<Instruction *, uint32_t> positions;
+  for (uint32_t i = 0; i < n; i++){
+    positions[instructions[i]] = i;
+  }
+
+  /*
+   * Compute the dependences between the instructions given as input.
+   * Every dependence goes from the instruction that comes first in the original order to the other one.
+   * Hence, the original order is always a valid schedule.
+   */
+  std::vector<std::set<uint32_t>> successors(n);
+  auto addDependence = [&positions, &successors](Value *first, Value *second) -> void {
+    auto firstInst = dyn_cast<Instruction>(first);
+    auto secondInst = dyn_cast<Instruction>(second);
+    if (  false
+          || (firstInst == nullptr)
+          || (secondInst == nullptr)
+          || (positions.find(firstInst) == positions.end())
+          || (positions.find(secondInst) == positions.end())
+      ){
+      return ;
+    }
+    auto firstPosition = positions[firstInst];
+    auto secondPosition = positions[secondInst];
+    if (firstPosition == secondPosition){
+      return ;
+    }
+    successors[std::min(firstPosition, secondPosition)].insert(std::max(firstPosition, secondPosition));
+  };
+  for (uint32_t i = 0; i < n; i++){
+    auto inst = instructions[i];
+
+    /*
+     * Data dependences through registers.
+     */
+    for (auto &op : inst->operands()){
+      addDependence(op.get(), inst);
+    }
+
+    /*
+     * Dependences of the task-internal dependence graph.
+     */
+    if (taskDG->isInGraph(inst)){
+      auto node = taskDG->fetchNode(inst);
+      for (auto edge : node->getAllConnectedEdges()){
+        addDependence(edge->getOutgoingT(), edge->getIncomingT());
+      }
+    }
+
+    /*
+     * Orderings not captured by the dependence graph.
+     */
+    for (uint32_t j = i + 1; j < n; j++){
+      if (mustPreserveOrder(inst, instructions[j], taskDG)){
+        successors[i].insert(j);
+      }
+    }
+  }
+
+  /*
+   * Compute the priority of the instructions.
+   *
+   * The instructions that (transitively) feed a sequential segment come first, so they execute before the segment starts.
+   * Then we have the instructions of the sequential segments.
+   * Everything else is independent of the sequential segments and it comes last.
+   * Instructions of the same class are ordered by their longest latency path to the end of the sequential segments.
+   */
+  std::vector<bool> feedsSS(n, false);
+  std::vector<uint32_t> classes(n, 2);
+  std::vector<uint64_t> heights(n, 0);
+  for (int64_t i = n - 1; i >= 0; i--){
+    auto inst = instructions[i];
+    auto isSS = ssInstructions.find(inst) != ssInstructions.end();
+    uint64_t successorsHeight = 0;
+    for (auto s : successors[i]){
+      if (!feedsSS[s]){
+        continue ;
+      }
+      feedsSS[i] = true;
+      successorsHeight = std::max(successorsHeight, heights[s]);
+    }
+    if (isSS){
+      feedsSS[i] = true;
+      classes[i] = 1;
+    } else if (feedsSS[i]){
+      classes[i] = 0;
+    }
+    if (feedsSS[i]){
+      heights[i] = latencies[inst] + successorsHeight;
+    }
+  }
+
+  /*
+   * List schedule the instructions.
+   */
+  std::vector<uint32_t> unscheduledPredecessors(n, 0);
+  for (uint32_t i = 0; i < n; i++){
+    for (auto s : successors[i]){
+      unscheduledPredecessors[s]++;
+    }
+  }
+  std::set<uint32_t> ready;
+  for (uint32_t i = 0; i < n; i++){
+    if (unscheduledPredecessors[i] == 0){
+      ready.insert(i);
+    }
+  }
+  std::vector<Instruction *> schedule;
+  while (ready.size() > 0){
+
+    /*
+     * Pick the ready instruction with the highest priority.
+     * Ties are broken by the original order.
+     */
+    auto best = *ready.begin();
+    for (auto candidate : ready){
+      if (  false
+            || (classes[candidate] < classes[best])
+            || ((classes[candidate] == classes[best]) && (heights[candidate] > heights[best]))
+        ){
+        best = candidate;
+      }
+    }
+    ready.erase(best);
+    schedule.push_back(instructions[best]);
+
+    /*
+     * Release the instructions that depend on it.
+     */
+    for (auto s : successors[best]){
+      unscheduledPredecessors[s]--;
+      if (unscheduledPredecessors[s] == 0){
+        ready.insert(s);
+      }
+    }
+  }
+  assert(schedule.size() == n);
+
+  return schedule;
+}
+
+static bool mustPreserveOrder (
+  Instruction *first,
+  Instruction *second,
+  PDG *taskDG
+  ){
+
+  /*
+   * The memory dependences of instructions added by the parallelizer and of intrinsics (e.g., lifetime markers) are not part of the dependence graph.
+   */
+  auto isMemoryUnknown = [taskDG](Instruction *inst) -> bool {
+    return inst->mayReadOrWriteMemory() && (!taskDG->isInGraph(inst) || isa<IntrinsicInst>(inst));
+  };
+  if (  false
+        || (isMemoryUnknown(first) && second->mayReadOrWriteMemory())
+        || (isMemoryUnknown(second) && first->mayReadOrWriteMemory())
+    ){
+    return true;
+  }
+
+  /*
+   * Fences and atomic instructions order the memory accesses around them.
+   */
+  if (  false
+        || (first->isAtomic() && second->mayReadOrWriteMemory())
+        || (second->isAtomic() && first->mayReadOrWriteMemory())
+    ){
+    return true;
+  }
+
+  /*
+   * Instructions that cannot be speculated cannot cross an instruction that might not pass the control to the next one (e.g., a call to exit).
+   */
+  if (  false
+        || (!isGuaranteedToTransferExecutionToSuccessor(first) && !isSafeToSpeculativelyExecute(second))
+        || (!isGuaranteedToTransferExecutionToSuccessor(second) && !isSafeToSpeculativelyExecute(first))
+    ){
+    return true;
+  }
+
+  return false;
+}
+
+/*
+ * The critical path of a sequential segment within a basic block goes from its first instruction to its last one.
+ */
+static uint64_t computeSequentialSegmentsCriticalPath (
+  std::vector<Instruction *> &schedule,
+  std::unordered_set<Instruction *> &ssInstructions,
+  std::unordered_map<Instruction *, uint64_t> &latencies
+  ){
+  uint64_t criticalPath = 0;
+  uint64_t pendingLatency = 0;
+  auto withinSS = false;
+  for (auto inst : schedule){
+    auto latency = latencies[inst];
+    if (ssInstructions.find(inst) != ssInstructions.end()){
+      withinSS = true;
+      criticalPath += pendingLatency + latency;
+      pendingLatency = 0;
+      continue ;
+    }
+    if (withinSS){
+      pendingLatency += latency;
+    }
+  }
+
+  return criticalPath;
+}
@@ -22,7 +22,8 @@ SequentialSegment::SequentialSegment (
   int32_t ID,
   Verbosity verbosity
   ) :
-  verbosity{verbosity}
+  verbosity{verbosity},
+  dependenceDistance{1}
   {
 
   /*
@@ -109,6 +110,16 @@ int32_t SequentialSegment::getID (void){
   return this->ID;
 }
 
+int64_t SequentialSegment::getDependenceDistance (void) const {
+  return this->dependenceDistance;
+}
+
+void SequentialSegment::setDependenceDistance (int64_t distance){
+  this->dependenceDistance = distance;
+
+  return ;
+}
+
 void SequentialSegment::determineEntryAndExitFrontier (
   LoopDependenceInfo *LDI,
   DominatorSummary &DS,
@@ -150,8 +150,10 @@ std::vector<SequentialSegment *> HELIX::identifySequentialSegments (
 
     /*
      * Check if the current set of SCCs require a sequential segments.
+     * Also compute the shortest distance (in iterations) of the loop-carried dependences the segment needs to preserve.
      */
     auto requireSS = false;
+    int64_t ssDistance = 0;
     for (auto scc : set->sccs){
 
       /*
@@ -159,9 +161,11 @@ std::vector<SequentialSegment *> HELIX::identifySequentialSegments (
        * NOTE: If no original SCC mapping exists, default to analyzing the newly constructed SCC
        */
       auto sccToAnalyze = scc;
+      auto sccManagerToAnalyze = sccManager;
       SCCAttrs *sccInfo = sccManager->getSCCAttrs(sccToAnalyze);
       if (taskToOriginalFunctionSCCMap.find(scc) != taskToOriginalFunctionSCCMap.end()) {
         sccToAnalyze = taskToOriginalFunctionSCCMap.at(scc);
+        sccManagerToAnalyze = originalSCCManager;
         sccInfo = originalSCCManager->getSCCAttrs(sccToAnalyze);
       }
 
@@ -172,6 +176,17 @@ std::vector<SequentialSegment *> HELIX::identifySequentialSegments (
         continue;
       }
 
+      /*
+       * Do not synchronize the counter of the iterations within a chunk as every core has its own.
+       */
+      if (  true
+            && (helixTask->chunkPHI != nullptr)
+            && (sccToAnalyze == scc)
+            && scc->isInternal(helixTask->chunkPHI)
+         ){
+        continue ;
+      }
+
       /*
        * If the SCC is due to a control dependence, but the number of iterations can be computed just before executing the loop, then we can skip it.
        */
@@ -193,7 +208,8 @@ std::vector<SequentialSegment *> HELIX::identifySequentialSegments (
        */
       if (sccType == SCCAttrs::SEQUENTIAL) {
         requireSS = true;
-        break ;
+        auto sccDistance = this->computeDependenceDistanceOfSCC(sccManagerToAnalyze, sccToAnalyze);
+        ssDistance = (int64_t)GreatestCommonDivisor64(ssDistance, sccDistance);
       }
     }
     if (!requireSS){
@@ -204,6 +220,13 @@ std::vector<SequentialSegment *> HELIX::identifySequentialSegments (
      * Allocate a sequential segment.
      */
     auto ss = new SequentialSegment(LDI, reachabilityDFR, set, ssID, this->verbose);
+    ss->setDependenceDistance(ssDistance);
+    if (  true
+          && (this->verbose != Verbosity::Disabled)
+          && (ssDistance > 1)
+      ){
+      errs() << "HELIX:  Sequential segment " << ssID << " synchronizes iterations that are " << ssDistance << " iterations apart\n";
+    }
 
     /*
      * Insert the new sequential segment to the list.
@@ -214,3 +237,29 @@ std::vector<SequentialSegment *> HELIX::identifySequentialSegments (
 
   return sss;
 }
+
+int64_t HELIX::computeDependenceDistanceOfSCC (
+  SCCDAGAttrs *sccManager,
+  SCC *scc
+) const {
+
+  /*
+   * Every iteration waits only for the one that is @distance iterations before it.
+   * Hence, every loop-carried dependence must span a multiple of @distance iterations, which is why their greatest common divisor is used rather than their minimum (e.g., distances 2 and 3 require a distance of 1).
+   * Dependences with an unknown distance come from the previous iteration.
+   */
+  int64_t distance = 0;
+  sccManager->iterateOverLoopCarriedDataDependences(scc, [&distance](DGEdge<Value> *dep) -> bool {
+    if (!dep->hasDependenceDistance()){
+      distance = 1;
+      return true;
+    }
+    distance = (int64_t)GreatestCommonDivisor64(distance, dep->getDependenceDistance());
+    return false;
+  });
+  if (distance <= 0){
+    distance = 1;
+  }
+
+  return distance;
+}
@@ -99,14 +99,76 @@ void HELIX::addSynchronizations (
     return entryBuilder.CreateIntToPtr(ssEntryAsInt, ssArray->getType());
   };
 
+  /*
+   * Define a helper to compute the number of hand-offs between the iteration (or chunk of iterations) that signals a sequential segment and the one that waits for it.
+   * This is 1 unless the loop-carried dependences of the sequential segment span several iterations.
+   * When the distance is not a multiple of the chunk size, an iteration waits for the chunk just before the one that includes its source; hence, the chunk to wait for changes within a chunk and 1 hand-off is used.
+   */
+  auto fetchHandoffDistance = [this, helixTask](SequentialSegment *ss) -> int64_t {
+    auto distance = ss->getDependenceDistance();
+    if (helixTask->chunkPHI != nullptr){
+      auto chunkSize = (int64_t)this->chunkSize;
+      distance = ((distance % chunkSize) == 0) ? (distance / chunkSize) : 1;
+    }
+    return std::max(distance, (int64_t)1);
+  };
+
+  /*
+   * Define a helper to fetch the sequential segment array of the core that executes the iteration @handoffDistance hand-offs after the current one.
+   * The arrays of all cores are contiguous and the past array of the current core is the one of core @coreArg.
+   * Hence, the array of core (@coreArg + distance) % @numCoresArg can be computed from the past array.
+   *
+   * Every core has a single entry per sequential segment, so the iterations that signal the same core must be totally ordered.
+   * This holds only if @handoffDistance divides the number of cores: the cores are then partitioned in @handoffDistance independent rings.
+   * Otherwise (e.g., 2 hand-offs on 3 cores), a core could be signaled twice before waiting (and a signal would be lost), or it could signal itself.
+   * Hence, the distance falls back to 1 hand-off at run time when it does not divide the number of cores.
+   */
+  auto coreID = entryBuilder.CreateZExtOrTrunc(helixTask->coreArg, int64);
+  auto numCores = entryBuilder.CreateZExtOrTrunc(helixTask->numCoresArg, int64);
+  auto ssArraySize = ConstantInt::get(int64, sss->size() * Architecture::getCacheLineBytes());
+  auto fetchRuntimeDistance = [&entryBuilder, numCores, int64](int64_t handoffDistance) -> Value * {
+    auto distance = ConstantInt::get(int64, handoffDistance);
+    auto isDistanceShorter = entryBuilder.CreateICmpULE(distance, numCores);
+    auto isDistanceDivisor = entryBuilder.CreateICmpEQ(
+      entryBuilder.CreateURem(numCores, distance),
+      ConstantInt::get(int64, 0)
+    );
+    auto canUseDistance = entryBuilder.CreateAnd(isDistanceShorter, isDistanceDivisor);
+    return entryBuilder.CreateSelect(canUseDistance, distance, ConstantInt::get(int64, 1));
+  };
+  auto fetchFutureArray = [&](int64_t handoffDistance) -> Value * {
+    if (handoffDistance == 1){
+      return helixTask->ssFutureArrayArg;
+    }
+    auto pastArrayAsInt = entryBuilder.CreatePtrToInt(helixTask->ssPastArrayArg, int64);
+    auto ssArraysAsInt = entryBuilder.CreateSub(pastArrayAsInt, entryBuilder.CreateMul(coreID, ssArraySize));
+    auto futureCoreID = entryBuilder.CreateURem(entryBuilder.CreateAdd(coreID, fetchRuntimeDistance(handoffDistance)), numCores);
+    auto futureArrayAsInt = entryBuilder.CreateAdd(ssArraysAsInt, entryBuilder.CreateMul(futureCoreID, ssArraySize));
+    return entryBuilder.CreateIntToPtr(futureArrayAsInt, helixTask->ssPastArrayArg->getType());
+  };
+
   /*
    * Fetch sequential segments entry in the past and future array
    * Allocate space to track sequential segment entry state
    */
-  std::vector<Value *> ssPastPtrs{}, ssFuturePtrs{}, ssStates{};
+  std::vector<Value *> ssPastPtrs{}, ssFuturePtrs{}, ssStates{}, ssWithoutPast{};
   for (auto ss : *sss) {
+    auto handoffDistance = fetchHandoffDistance(ss);
     ssPastPtrs.push_back(fetchEntry(helixTask->ssPastArrayArg, ss->getID()));
-    ssFuturePtrs.push_back(fetchEntry(helixTask->ssFutureArrayArg, ss->getID()));
+    ssFuturePtrs.push_back(fetchEntry(fetchFutureArray(handoffDistance), ss->getID()));
+
+    /*
+     * With a distance of d hand-offs, the first iterations (or chunks) of cores 1 to d-1 have nothing to wait for.
+     * Only the lock of core 0 is released before the loop starts, so these cores must skip their first wait.
+     */
+    Value *isCoreWithoutPast = nullptr;
+    if (handoffDistance > 1){
+      isCoreWithoutPast = entryBuilder.CreateAnd(
+        entryBuilder.CreateICmpNE(coreID, ConstantInt::get(int64, 0)),
+        entryBuilder.CreateICmpULT(coreID, fetchRuntimeDistance(handoffDistance))
+      );
+    }
+    ssWithoutPast.push_back(isCoreWithoutPast);
 
     /*
      * We must execute exactly one wait instruction for each sequential segment, for each loop iteration, and for each thread.
@@ -120,6 +182,77 @@ void HELIX::addSynchronizations (
     ssStates.push_back(ssStateAlloca);
   }
 
+  /*
+   * Track whether the current iteration is the first one executed by the core.
+   * This is needed only by sequential segments that skip their first wait.
+   */
+  PHINode *isFirstIterationOfCore = nullptr;
+  for (auto isCoreWithoutPast : ssWithoutPast){
+    if (isCoreWithoutPast == nullptr){
+      continue ;
+    }
+    IRBuilder<> phiBuilder(&*loopHeader->begin());
+    auto int1 = IntegerType::get(cxt, 1);
+    isFirstIterationOfCore = phiBuilder.CreatePHI(int1, pred_size(loopHeader));
+    for (auto predBB : predecessors(loopHeader)){
+      auto isFromOutsideLoop = !loopStructure->isIncluded(predBB);
+      isFirstIterationOfCore->addIncoming(ConstantInt::get(int1, isFromOutsideLoop ? 1 : 0), predBB);
+    }
+    break ;
+  }
+
+  /*
+   * When cores execute chunks of consecutive iterations, the sequential segments are forwarded to the next core only at the end of a chunk.
+   * Iterations that do not end a chunk signal a location private to the current core instead.
+   */
+  Value *privateSignalPtr = nullptr;
+  if (helixTask->chunkPHI != nullptr){
+    auto privateSignalAlloca = entryBuilder.CreateAlloca(int64);
+    privateSignalAlloca->moveBefore(helixTask->getEntry()->getFirstNonPHIOrDbgOrLifetime());
+    privateSignalPtr = entryBuilder.CreateBitCast(privateSignalAlloca, helixTask->ssFutureArrayArg->getType());
+  }
+
+  /*
+   * Define a helper to check whether the loop can execute more iterations after a given basic block.
+   * Signals that cannot be followed by other iterations (e.g., at loop exits) must always forward the sequential segments.
+   */
+  auto canLoopContinueFrom = [loopHeader](BasicBlock *block) -> bool {
+    std::unordered_set<BasicBlock *> visited{};
+    std::queue<BasicBlock *> worklist{};
+    worklist.push(block);
+    while (!worklist.empty()){
+      auto currentBlock = worklist.front();
+      worklist.pop();
+      for (auto succBlock : successors(currentBlock)){
+        if (succBlock == loopHeader){
+          return true;
+        }
+        if (visited.find(succBlock) != visited.end()){
+          continue ;
+        }
+        visited.insert(succBlock);
+        worklist.push(succBlock);
+      }
+    }
+    return false;
+  };
+
+  /*
+   * Define a helper to fetch the location to signal to forward a sequential segment.
+   */
+  auto fetchSignalPtr = [&](SequentialSegment *ss, IRBuilder<> &signalBuilder) -> Value * {
+    auto ssFuturePtr = ssFuturePtrs.at(ss->getID());
+    if (  false
+          || (helixTask->chunkPHI == nullptr)
+          || (!canLoopContinueFrom(signalBuilder.GetInsertBlock()))
+      ){
+      return ssFuturePtr;
+    }
+    auto lastPositionInChunk = ConstantInt::get(helixTask->chunkPHI->getType(), this->chunkSize - 1);
+    auto isLastIterationOfChunk = signalBuilder.CreateICmpEQ(helixTask->chunkPHI, lastPositionInChunk);
+    return signalBuilder.CreateSelect(isLastIterationOfChunk, ssFuturePtr, privateSignalPtr);
+  };
+
   /*
    * Define the code that inject wait instructions.
    */
@@ -194,14 +327,14 @@ void HELIX::addSynchronizations (
     if (!justBeforeExitBr || justBeforeExitBr->isUnconditional()) {
       Instruction *insertPoint = terminator == justBeforeExit ? terminator : justBeforeExit->getNextNode();
       IRBuilder<> beforeExitBuilder(insertPoint);
-      auto signal = beforeExitBuilder.CreateCall(this->signalSSCall, { ssFuturePtrs.at(ss->getID()) });
+      auto signal = beforeExitBuilder.CreateCall(this->signalSSCall, { fetchSignalPtr(ss, beforeExitBuilder) });
       helixTask->signals.insert(cast<CallInst>(signal));
       return;
     }
 
     for (auto successorBlock : successors(block)) {
       IRBuilder<> beforeExitBuilder(successorBlock->getFirstNonPHIOrDbgOrLifetime());
-      auto signal = beforeExitBuilder.CreateCall(this->signalSSCall, { ssFuturePtrs.at(ss->getID()) });
+      auto signal = beforeExitBuilder.CreateCall(this->signalSSCall, { fetchSignalPtr(ss, beforeExitBuilder) });
       helixTask->signals.insert(cast<CallInst>(signal));
     }
   };
@@ -283,10 +416,25 @@ void HELIX::addSynchronizations (
      * Reset the value of ssState at the beginning of the iteration
      * NOTE: This has to be done BEFORE any preamble synchronization, so this
      * insertion comes after the check exit logic has already been inserted
+     *
+     * With chunks, the value is reset only at the beginning of a chunk.
+     * Hence, a core waits for a sequential segment only once per chunk.
      */
     auto firstLoopInst = loopHeader->getFirstNonPHIOrDbgOrLifetime();
     IRBuilder<> headerBuilder(firstLoopInst);
-    headerBuilder.CreateStore(ConstantInt::get(int64, 0), ssStates.at(ss->getID()));
+    auto ssState = ssStates.at(ss->getID());
+    Value *ssStateAtIterationStart = ConstantInt::get(int64, 0);
+    auto isCoreWithoutPast = ssWithoutPast.at(ss->getID());
+    if (isCoreWithoutPast != nullptr){
+      auto skipWait = headerBuilder.CreateAnd(isFirstIterationOfCore, isCoreWithoutPast);
+      ssStateAtIterationStart = headerBuilder.CreateZExt(skipWait, int64);
+    }
+    if (helixTask->chunkPHI != nullptr){
+      auto isFirstIterationOfChunk = headerBuilder.CreateICmpEQ(helixTask->chunkPHI, ConstantInt::get(helixTask->chunkPHI->getType(), 0));
+      auto ssStateOfChunk = headerBuilder.CreateLoad(ssState);
+      ssStateAtIterationStart = headerBuilder.CreateSelect(isFirstIterationOfChunk, ssStateAtIterationStart, ssStateOfChunk);
+    }
+    headerBuilder.CreateStore(ssStateAtIterationStart, ssState);
 
     /*
      * Inject waits.
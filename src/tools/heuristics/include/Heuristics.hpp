@@ -21,6 +21,7 @@
 #include "PartitionCostAnalysis.hpp"
 #include "SmallestSizePartitionAnalysis.hpp"
 #include "MinMaxSizePartitionAnalysis.hpp"
+#include "SpeedupModel.hpp"
 
 using namespace std;
 
@@ -41,6 +42,18 @@ namespace llvm::noelle {
         Verbosity verbose
       );
 
+      /*
+       * Compute the number of replicas of each DSWP stage given its cost (e.g., its profiled instructions).
+       * Only stages with @canStageBeReplicated set can have more than one replica.
+       * The total number of stage instances does not exceed @numThreads.
+       */
+      std::vector<uint32_t> computeReplicationFactorsForDSWP (
+        const std::vector<uint64_t> &stageCosts,
+        const std::vector<bool> &canStageBeReplicated,
+        uint64_t numThreads,
+        Verbosity verbose
+      );
+
      private:
 
       void minMaxMergePartition (
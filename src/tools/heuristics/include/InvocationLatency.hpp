@@ -15,6 +15,7 @@
 #include "SCCDAGAttrs.hpp"
 #include "SCCDAGPartition.hpp"
 #include "Hot.hpp"
+#include "Architecture.hpp"
 
 namespace llvm::noelle {
 
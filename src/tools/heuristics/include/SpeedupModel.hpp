@@ -0,0 +1,73 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "Noelle.hpp"
+#include "Architecture.hpp"
+
+namespace llvm::noelle {
+
+  /*
+   * Critical-path model of the time spent in a loop once parallelized by DOALL, HELIX, or DSWP.
+   *
+   * Time is measured in cycles if the time spent in loops has been profiled. Otherwise, it is measured in instructions executed.
+   * The unit is the same for every loop: instructions of loops that have not been timed are converted into cycles (see Hot::getCyclesPerInstruction).
+   * Communication and dispatch costs come from the communication cost model of the target machine (see Architecture).
+   * All times are totals across all invocations of the loop.
+   */
+  class SpeedupModel {
+    public:
+      SpeedupModel (Hot *profiles);
+
+      bool isTimeMeasuredInCycles (void) const ;
+
+      /*
+       * Time spent in the loop when it runs sequentially.
+       */
+      double getSequentialTime (LoopDependenceInfo *ldi) const ;
+
+      /*
+       * Sequential SCCs of the loop that no transformation can remove (e.g., by cloning or by privatizing memory).
+       */
+      std::vector<SCC *> getSequentialSCCs (LoopDependenceInfo *ldi) const ;
+
+      double getTime (LoopDependenceInfo *ldi, SCC *scc) const ;
+
+      double getTimeOfBiggestSequentialSCC (LoopDependenceInfo *ldi) const ;
+
+      double getTimeOfSequentialSCCs (LoopDependenceInfo *ldi) const ;
+
+      /*
+       * Number of values that flow between SCCs that cannot be cloned.
+       * This is the number of queues DSWP would need if every such SCC were a stage.
+       */
+      uint64_t getNumberOfQueues (LoopDependenceInfo *ldi) const ;
+
+      /*
+       * Time spent dispatching and joining the tasks of all invocations of the loop.
+       */
+      double getDispatchTime (LoopDependenceInfo *ldi, uint32_t cores) const ;
+
+      double predictDOALLTime (LoopDependenceInfo *ldi, uint32_t cores) const ;
+
+      double predictHELIXTime (LoopDependenceInfo *ldi, uint32_t cores) const ;
+
+      double predictDSWPTime (LoopDependenceInfo *ldi, uint32_t cores) const ;
+
+    private:
+      Hot *profiles;
+      bool timeMeasuredInCycles;
+
+      double fromNanoseconds (LoopDependenceInfo *ldi, double nanoseconds) const ;
+  };
+
+}
@@ -65,3 +65,68 @@ void Heuristics::smallestSizeMergePartition (
     modified = PCA.mergeCandidateSubsets();
   } while (modified);
 }
+
+std::vector<uint32_t> Heuristics::computeReplicationFactorsForDSWP (
+  const std::vector<uint64_t> &stageCosts,
+  const std::vector<bool> &canStageBeReplicated,
+  uint64_t numThreads,
+  Verbosity verbose
+) {
+  assert(stageCosts.size() == canStageBeReplicated.size());
+
+  /*
+   * Every stage starts with one instance.
+   */
+  std::vector<uint32_t> replicas(stageCosts.size(), 1);
+  uint64_t instances = stageCosts.size();
+
+  /*
+   * The throughput of the pipeline is bounded by its slowest stage, which is the one with the highest cost per replica.
+   * Add replicas to the slowest stage as long as it can be replicated and there are threads left.
+   */
+  while (instances < numThreads){
+
+    /*
+     * Find the slowest stage.
+     */
+    uint64_t slowestStage = 0;
+    double slowestStageCost = 0;
+    for (auto i = 0; i < stageCosts.size(); ++i){
+      auto costPerReplica = ((double)stageCosts[i]) / ((double)replicas[i]);
+      if (costPerReplica > slowestStageCost){
+        slowestStage = i;
+        slowestStageCost = costPerReplica;
+      }
+    }
+
+    /*
+     * Check if the slowest stage can be replicated.
+     */
+    if (  false
+          || (slowestStageCost == 0)
+          || (!canStageBeReplicated[slowestStage])
+      ){
+      break ;
+    }
+
+    /*
+     * Replicate the slowest stage.
+     */
+    replicas[slowestStage]++;
+    instances++;
+  }
+
+  /*
+   * Print the replicated stages.
+   */
+  if (verbose >= Verbosity::Minimal){
+    for (auto i = 0; i < replicas.size(); ++i){
+      if (replicas[i] == 1){
+        continue ;
+      }
+      errs() << "Heuristics:  Stage " << i << " with cost " << stageCosts[i] << " is replicated " << replicas[i] << " times\n";
+    }
+  }
+
+  return replicas;
+}
@@ -30,8 +30,9 @@ uint64_t InvocationLatency::latencyPerInvocation (SCC *scc){
 
   /*
    * Compute the latency of the SCC.
+   * We use the time spent in the SCC if it has been profiled. Otherwise, we use the number of instructions executed.
    */
-  auto cost = this->profiles->getTotalInstructions(scc);
+  auto cost = this->profiles->hasTimeProfiles() ? this->profiles->getTotalCycles(scc) : this->profiles->getTotalInstructions(scc);
   sccToCost[scc] = cost;
 
   return cost;
@@ -87,14 +88,53 @@ uint64_t InvocationLatency::latencyPerInvocation (Instruction *inst){
   /*
    * Estimate the latency.
    */
-  auto latency = this->profiles->getTotalInstructions(inst);
+  uint64_t latency = this->profiles->getTotalInstructions(inst);
+  if (this->profiles->hasTimeProfiles()){
+    latency = (uint64_t)(latency * this->profiles->getCyclesPerInstruction(inst->getParent()));
+  }
 
   return latency;
 }
 
 uint64_t InvocationLatency::queueLatency (Value *queueVal){
-  // TODO(angelo): use primitive size of bits of type of value?
-  return 100;
+
+  /*
+   * Check if the communication costs of the target machine are known.
+   */
+  if (!Architecture::isCommunicationCostModelCalibrated()){
+    return 100;
+  }
+
+  /*
+   * Fetch the size of the value queued.
+   */
+  auto valueType = queueVal->getType();
+  uint64_t bits = valueType->isPointerTy() ? 64 : valueType->getPrimitiveSizeInBits();
+  if (bits == 0){
+    auto inst = dyn_cast<Instruction>(queueVal);
+    bits = (inst != nullptr) ? inst->getModule()->getDataLayout().getTypeSizeInBits(valueType) : 64;
+  }
+
+  /*
+   * Compute the cost of sending the value once.
+   * Stages that communicate through a queue are placed on the closest cores.
+   */
+  auto distance = Architecture::getDistanceOfCores(2);
+  auto latencyPerValue = Architecture::getQueuePushLatency(bits, distance) + Architecture::getQueuePopLatency(bits, distance);
+  latencyPerValue = this->profiles->hasTimeProfiles() ? Architecture::fromNanosecondsToCycles(latencyPerValue) : Architecture::fromNanosecondsToInstructions(latencyPerValue);
+
+  /*
+   * The value is sent every time it is produced.
+   */
+  uint64_t valuesSent = 1;
+  if (auto inst = dyn_cast<Instruction>(queueVal)){
+    if (this->profiles->isAvailable()){
+      valuesSent = std::max(this->profiles->getInvocations(inst), (uint64_t)1);
+    }
+  }
+  auto latency = (uint64_t)(latencyPerValue * valuesSent);
+
+  return latency;
 }
 
 /*
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "SpeedupModel.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+SpeedupModel::SpeedupModel (Hot *profiles)
+  : profiles{profiles}
+  , timeMeasuredInCycles{profiles->hasTimeProfiles()}
+  {
+  return ;
+}
+
+bool SpeedupModel::isTimeMeasuredInCycles (void) const {
+  return this->timeMeasuredInCycles;
+}
+
+double SpeedupModel::getSequentialTime (LoopDependenceInfo *ldi) const {
+  auto ls = ldi->getLoopStructure();
+  if (this->isTimeMeasuredInCycles()){
+    return (double)this->profiles->getTotalCycles(ls);
+  }
+
+  return (double)this->profiles->getTotalInstructions(ls);
+}
+
+std::vector<SCC *> SpeedupModel::getSequentialSCCs (LoopDependenceInfo *ldi) const {
+  std::vector<SCC *> sccs{};
+
+  /*
+   * Fetch the set of sequential SCCs.
+   */
+  auto sccManager = ldi->getSCCManager();
+  auto sequentialSCCs = sccManager->getSCCsOfType(SCCAttrs::SCCType::SEQUENTIAL);
+
+  /*
+   * Collect the sequential SCCs that cannot be removed.
+   */
+  for (auto sequentialSCC : sequentialSCCs){
+    assert(sequentialSCC->mustExecuteSequentially());
+
+    /*
+     * Fetch the SCC.
+     */
+    auto currentSCC = sequentialSCC->getSCC();
+
+    /*
+     * Check if the SCC can be removed by a transformation.
+     */
+    if (sequentialSCC->isInductionVariableSCC()){
+      continue ;
+    }
+    if (sequentialSCC->canBeCloned()){
+      continue ;
+    }
+    if (sequentialSCC->canBeClonedUsingLocalMemoryLocations()){
+      continue ;
+    }
+
+    auto areAllDataLCDsFromDisjointMemoryAccesses = true;
+    auto domainSpaceAnalysis = ldi->getLoopIterationDomainSpaceAnalysis();
+    sccManager->iterateOverLoopCarriedDataDependences(currentSCC, [
+      &areAllDataLCDsFromDisjointMemoryAccesses, domainSpaceAnalysis
+    ](DGEdge<Value> *dep) -> bool {
+      if (dep->isControlDependence()) return false;
+
+      if (!dep->isMemoryDependence()) {
+        areAllDataLCDsFromDisjointMemoryAccesses = false;
+        return true;
+      }
+
+      auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
+      auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
+      areAllDataLCDsFromDisjointMemoryAccesses &= fromInst && toInst && domainSpaceAnalysis->
+        areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst);
+      return !areAllDataLCDsFromDisjointMemoryAccesses;
+    });
+    if (areAllDataLCDsFromDisjointMemoryAccesses) {
+      continue;
+    }
+
+    sccs.push_back(currentSCC);
+  }
+
+  return sccs;
+}
+
+double SpeedupModel::getTime (LoopDependenceInfo *ldi, SCC *scc) const {
+  if (this->isTimeMeasuredInCycles()){
+    return (double)this->profiles->getTotalCycles(scc);
+  }
+
+  return (double)this->profiles->getTotalInstructions(scc);
+}
+
+double SpeedupModel::getTimeOfBiggestSequentialSCC (LoopDependenceInfo *ldi) const {
+  double biggestSCCTime = 0;
+  for (auto scc : this->getSequentialSCCs(ldi)){
+    biggestSCCTime = std::max(biggestSCCTime, this->getTime(ldi, scc));
+  }
+
+  return biggestSCCTime;
+}
+
+double SpeedupModel::getTimeOfSequentialSCCs (LoopDependenceInfo *ldi) const {
+  double sequentialTime = 0;
+  for (auto scc : this->getSequentialSCCs(ldi)){
+    sequentialTime += this->getTime(ldi, scc);
+  }
+
+  return sequentialTime;
+}
+
+uint64_t SpeedupModel::getNumberOfQueues (LoopDependenceInfo *ldi) const {
+
+  /*
+   * Collect the values that are produced by an SCC and consumed by another one, where neither SCC can be cloned.
+   */
+  auto sccManager = ldi->getSCCManager();
+  auto sccdag = sccManager->getSCCDAG();
+  std::unordered_set<Value *> valuesToSend{};
+  for (auto edge : sccdag->getEdges()){
+    auto producerSCC = edge->getOutgoingT();
+    auto consumerSCC = edge->getIncomingT();
+    if (  false
+          || sccManager->getSCCAttrs(producerSCC)->canBeCloned()
+          || sccManager->getSCCAttrs(consumerSCC)->canBeCloned()
+      ){
+      continue ;
+    }
+    for (auto subEdge : edge->getSubEdges()){
+      if (  false
+            || subEdge->isControlDependence()
+            || subEdge->isMemoryDependence()
+        ){
+        continue ;
+      }
+      valuesToSend.insert(subEdge->getOutgoingT());
+    }
+  }
+
+  return valuesToSend.size();
+}
+
+double SpeedupModel::getDispatchTime (LoopDependenceInfo *ldi, uint32_t cores) const {
+  auto invocations = (double)this->profiles->getInvocations(ldi->getLoopStructure());
+  auto dispatchTime = this->fromNanoseconds(ldi, Architecture::getForkJoinLatency(cores)) * invocations;
+
+  return dispatchTime;
+}
+
+double SpeedupModel::predictDOALLTime (LoopDependenceInfo *ldi, uint32_t cores) const {
+
+  /*
+   * Iterations are independent.
+   */
+  auto parallelTime = this->getSequentialTime(ldi) / cores;
+  parallelTime += this->getDispatchTime(ldi, cores);
+
+  return parallelTime;
+}
+
+double SpeedupModel::predictHELIXTime (LoopDependenceInfo *ldi, uint32_t cores) const {
+
+  /*
+   * Consecutive iterations run on different cores.
+   * The biggest sequential segment and its forwarding to the next core serialize the iterations.
+   */
+  auto iterations = (double)this->profiles->getIterations(ldi->getLoopStructure());
+  auto sequentialTimePerIteration = (iterations > 0) ? (this->getTimeOfBiggestSequentialSCC(ldi) / iterations) : 0;
+  auto distance = Architecture::getDistanceOfCores(cores);
+  auto criticalPathPerIteration = sequentialTimePerIteration + this->fromNanoseconds(ldi, Architecture::getCoreToCoreLatency(distance));
+  auto parallelTime = std::max(this->getSequentialTime(ldi) / cores, criticalPathPerIteration * iterations);
+  parallelTime += this->getDispatchTime(ldi, cores);
+
+  return parallelTime;
+}
+
+double SpeedupModel::predictDSWPTime (LoopDependenceInfo *ldi, uint32_t cores) const {
+
+  /*
+   * Iterations flow through a pipeline of stages.
+   * The work (including the communication) is spread across the cores, but the biggest sequential stage bounds the throughput and it communicates at least one value per iteration.
+   */
+  auto iterations = (double)this->profiles->getIterations(ldi->getLoopStructure());
+  auto distance = Architecture::getDistanceOfCores(cores);
+  auto communicationPerValue = this->fromNanoseconds(ldi, Architecture::getQueuePushLatency(64, distance) + Architecture::getQueuePopLatency(64, distance));
+  auto communicationTime = communicationPerValue * this->getNumberOfQueues(ldi) * iterations;
+  auto workBound = (this->getSequentialTime(ldi) + communicationTime) / cores;
+  auto stageBound = this->getTimeOfBiggestSequentialSCC(ldi) + communicationPerValue * iterations;
+  auto parallelTime = std::max(workBound, stageBound);
+  parallelTime += this->getDispatchTime(ldi, cores);
+
+  return parallelTime;
+}
+
+double SpeedupModel::fromNanoseconds (LoopDependenceInfo *ldi, double nanoseconds) const {
+  if (this->isTimeMeasuredInCycles()){
+    return Architecture::fromNanosecondsToCycles(nanoseconds);
+  }
+
+  return Architecture::fromNanosecondsToInstructions(nanoseconds);
+}
@@ -0,0 +1,388 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*
+ * Runtime of the loop profiler.
+ *
+ * The code injected by the LoopProfiler pass invokes the APIs below.
+ * Profiles are dumped to the file named by the environment variable NOELLE_LOOP_PROFILE (default: noelle_loop_profile.txt) when the program exits.
+ * Each line of the file is
+ *    LOOP_ID KIND BUCKET COUNT
+ * where KIND is "trips" for the number of iterations per invocation, "insts" for the number of instructions per invocation, and "cycles" for the total time spent in the loop.
+ * For "cycles", BUCKET is always 0 and COUNT is the number of cycles (or nanoseconds on architectures without a time-stamp counter).
+ *
+ * When memory dependences are profiled, the following kinds are dumped as well:
+ * - "memiters": BUCKET is always 0 and COUNT is the number of iterations executed while profiling the memory accesses of the loop.
+ * - "meminsts": BUCKET encodes a profiled load/store (see MEMINST_KEY) and COUNT is the number of times it has been executed.
+ *   Loads and stores are identified by the ID of their node in the embedded PDG (metadata "noelle.pdg.inst.id"), which does not depend on where they are in the code.
+ * - "memdeps": BUCKET encodes a loop-carried dependence that has been observed (see MEMDEP_KEY) and COUNT is the number of times it has been observed.
+ */
+
+/*
+ * Trip counts below this value are recorded exactly.
+ * Larger values are recorded in buckets that are powers of two (the bucket is the lower bound of the range).
+ */
+#define EXACT_BUCKETS 128
+
+/*
+ * Memory accesses are tracked at this granularity (in bytes).
+ * An access of N bytes touches every granule that overlaps [address, address + N).
+ * Accesses to different bytes of the same granule are considered to be dependent.
+ */
+#define MEMORY_GRANULE_SIZE 8
+
+/*
+ * A profiled instruction is identified by its ID and by whether it is a store.
+ * The latter allows checking that the profile still matches the code it is embedded into.
+ */
+#define MEMINST_KEY(id, isStore) ((((uint64_t)(id)) << 1) | ((isStore) ? 1 : 0))
+
+/*
+ * A loop-carried memory dependence is identified by its source instruction, its destination instruction, and its iteration distance.
+ * Instruction IDs must fit 24 bits (the LoopProfiler pass does not profile the others) and distances that do not fit 16 bits are saturated.
+ */
+#define MEMDEP_MAX_DISTANCE 0xFFFF
+#define MEMDEP_KEY(src, dst, distance) ((((uint64_t)(src)) << 40) | (((uint64_t)(dst)) << 16) | ((distance) > MEMDEP_MAX_DISTANCE ? MEMDEP_MAX_DISTANCE : (distance)))
+
+typedef std::map<uint64_t, uint64_t> histogram_t;
+
+typedef struct {
+  uint64_t instID;
+  uint64_t iteration;
+} memoryAccess_t;
+
+/*
+ * Accesses to a memory granule since the last store to it.
+ */
+typedef struct {
+  bool isWritten;
+  memoryAccess_t lastStore;
+  std::vector<memoryAccess_t> loads;
+} shadowGranule_t;
+
+typedef struct {
+  histogram_t trips;
+  histogram_t insts;
+  uint64_t cycles;
+
+  /*
+   * Memory dependence profile.
+   */
+  uint64_t memoryIterations;
+  histogram_t memoryInsts;
+  histogram_t memoryDeps;
+  std::unordered_map<uint64_t, shadowGranule_t> shadowMemory;
+} loopProfile_t;
+
+class LoopProfiles {
+  public:
+    ~LoopProfiles ();
+
+    void addInvocation (uint64_t loopID, uint64_t iterations, uint64_t instructions);
+
+    void addTimedInvocation (uint64_t loopID, uint64_t iterations, uint64_t cycles);
+
+    void startMemoryInvocation (uint64_t loopID);
+
+    void addMemoryAccess (uint64_t loopID, uint64_t instID, void *address, uint64_t size, uint64_t iteration, bool isStore);
+
+    void endMemoryInvocation (uint64_t loopID, uint64_t iterations);
+
+    static uint64_t now (void);
+
+  private:
+    std::unordered_map<uint64_t, loopProfile_t> loops;
+    std::mutex lock;
+
+    static uint64_t getBucket (uint64_t value);
+
+    static void recordDependence (std::set<uint64_t> &dependences, memoryAccess_t &src, uint64_t dstID, uint64_t dstIteration);
+
+    static void dump (FILE *file, uint64_t loopID, const char *kind, histogram_t &histogram);
+};
+
+static LoopProfiles profiles{};
+
+extern "C" {
+
+  void NOELLE_LoopProfiler_invocation (uint64_t loopID, uint64_t iterations, uint64_t instructions){
+    profiles.addInvocation(loopID, iterations, instructions);
+
+    return ;
+  }
+
+  uint64_t NOELLE_LoopProfiler_now (void){
+    return LoopProfiles::now();
+  }
+
+  void NOELLE_LoopProfiler_timedInvocation (uint64_t loopID, uint64_t iterations, uint64_t startTime){
+    auto endTime = LoopProfiles::now();
+    profiles.addTimedInvocation(loopID, iterations, endTime - startTime);
+
+    return ;
+  }
+
+  void NOELLE_LoopProfiler_memoryInvocationStart (uint64_t loopID){
+    profiles.startMemoryInvocation(loopID);
+
+    return ;
+  }
+
+  void NOELLE_LoopProfiler_load (uint64_t loopID, uint64_t instID, void *address, uint64_t size, uint64_t iteration){
+    profiles.addMemoryAccess(loopID, instID, address, size, iteration, false);
+
+    return ;
+  }
+
+  void NOELLE_LoopProfiler_store (uint64_t loopID, uint64_t instID, void *address, uint64_t size, uint64_t iteration){
+    profiles.addMemoryAccess(loopID, instID, address, size, iteration, true);
+
+    return ;
+  }
+
+  void NOELLE_LoopProfiler_memoryInvocationEnd (uint64_t loopID, uint64_t iterations){
+    profiles.endMemoryInvocation(loopID, iterations);
+
+    return ;
+  }
+
+}
+
+void LoopProfiles::addInvocation (uint64_t loopID, uint64_t iterations, uint64_t instructions){
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  /*
+   * Record the invocation.
+   */
+  auto &loopProfile = this->loops[loopID];
+  loopProfile.trips[LoopProfiles::getBucket(iterations)]++;
+  loopProfile.insts[LoopProfiles::getBucket(instructions)]++;
+
+  return ;
+}
+
+void LoopProfiles::addTimedInvocation (uint64_t loopID, uint64_t iterations, uint64_t cycles){
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  /*
+   * Record the invocation.
+   */
+  auto &loopProfile = this->loops[loopID];
+  loopProfile.trips[LoopProfiles::getBucket(iterations)]++;
+  loopProfile.cycles += cycles;
+
+  return ;
+}
+
+void LoopProfiles::startMemoryInvocation (uint64_t loopID){
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  /*
+   * Dependences between different invocations of the loop are not loop-carried.
+   */
+  auto &loopProfile = this->loops[loopID];
+  loopProfile.shadowMemory.clear();
+
+  return ;
+}
+
+void LoopProfiles::addMemoryAccess (uint64_t loopID, uint64_t instID, void *address, uint64_t size, uint64_t iteration, bool isStore){
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  /*
+   * Record the execution of the instruction.
+   */
+  auto &loopProfile = this->loops[loopID];
+  loopProfile.memoryInsts[MEMINST_KEY(instID, isStore)]++;
+
+  /*
+   * Check every granule accessed.
+   * A dependence is counted once per access even if several granules expose it.
+   */
+  std::set<uint64_t> dependences{};
+  auto firstGranule = ((uint64_t)address) / MEMORY_GRANULE_SIZE;
+  auto lastGranule = (((uint64_t)address) + (size > 0 ? size - 1 : 0)) / MEMORY_GRANULE_SIZE;
+  for (auto granule = firstGranule; granule <= lastGranule; granule++){
+    auto &shadow = loopProfile.shadowMemory[granule];
+
+    /*
+     * Handle loads.
+     */
+    if (!isStore){
+
+      /*
+       * Check for a RAW dependence.
+       */
+      if (shadow.isWritten){
+        LoopProfiles::recordDependence(dependences, shadow.lastStore, instID, iteration);
+      }
+
+      /*
+       * Remember the load.
+       * Only the last execution of each load is needed.
+       */
+      auto isTracked = false;
+      for (auto &load : shadow.loads){
+        if (load.instID == instID){
+          load.iteration = iteration;
+          isTracked = true;
+          break ;
+        }
+      }
+      if (!isTracked){
+        shadow.loads.push_back({ instID, iteration });
+      }
+      continue ;
+    }
+
+    /*
+     * Check for WAR dependences.
+     */
+    for (auto &load : shadow.loads){
+      LoopProfiles::recordDependence(dependences, load, instID, iteration);
+    }
+
+    /*
+     * Check for a WAW dependence.
+     */
+    if (shadow.isWritten){
+      LoopProfiles::recordDependence(dependences, shadow.lastStore, instID, iteration);
+    }
+
+    /*
+     * The store kills all previous accesses.
+     */
+    shadow.isWritten = true;
+    shadow.lastStore = { instID, iteration };
+    shadow.loads.clear();
+  }
+
+  /*
+   * Record the dependences observed.
+   */
+  for (auto dependence : dependences){
+    loopProfile.memoryDeps[dependence]++;
+  }
+
+  return ;
+}
+
+void LoopProfiles::endMemoryInvocation (uint64_t loopID, uint64_t iterations){
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  /*
+   * Account for the iterations of the invocation.
+   */
+  auto &loopProfile = this->loops[loopID];
+  loopProfile.memoryIterations += iterations;
+
+  /*
+   * Free the shadow memory.
+   */
+  loopProfile.shadowMemory.clear();
+
+  return ;
+}
+
+void LoopProfiles::recordDependence (std::set<uint64_t> &dependences, memoryAccess_t &src, uint64_t dstID, uint64_t dstIteration){
+
+  /*
+   * Only dependences across iterations are recorded.
+   */
+  if (src.iteration >= dstIteration){
+    return ;
+  }
+  auto distance = dstIteration - src.iteration;
+  dependences.insert(MEMDEP_KEY(src.instID, dstID, distance));
+
+  return ;
+}
+
+uint64_t LoopProfiles::now (void){
+  #if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+  #else
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return ((uint64_t)t.tv_sec) * 1000000000 + t.tv_nsec;
+  #endif
+}
+
+uint64_t LoopProfiles::getBucket (uint64_t value){
+  if (value < EXACT_BUCKETS){
+    return value;
+  }
+
+  /*
+   * Round down to the closest power of two.
+   */
+  uint64_t bucket = EXACT_BUCKETS;
+  while ((bucket << 1) <= value){
+    bucket <<= 1;
+  }
+
+  return bucket;
+}
+
+void LoopProfiles::dump (FILE *file, uint64_t loopID, const char *kind, histogram_t &histogram){
+  for (auto &pair : histogram){
+    fprintf(file, "%lu %s %lu %lu\n", (unsigned long)loopID, kind, (unsigned long)pair.first, (unsigned long)pair.second);
+  }
+
+  return ;
+}
+
+LoopProfiles::~LoopProfiles (){
+
+  /*
+   * Open the output file.
+   */
+  auto fileName = getenv("NOELLE_LOOP_PROFILE");
+  if (fileName == nullptr){
+    fileName = (char *)"noelle_loop_profile.txt";
+  }
+  auto file = fopen(fileName, "w");
+  if (file == nullptr){
+    fprintf(stderr, "LoopProfiler: ERROR = cannot open %s\n", fileName);
+    return ;
+  }
+
+  /*
+   * Dump the profiles.
+   */
+  for (auto &pair : this->loops){
+    LoopProfiles::dump(file, pair.first, "trips", pair.second.trips);
+    LoopProfiles::dump(file, pair.first, "insts", pair.second.insts);
+    if (pair.second.cycles > 0){
+      fprintf(file, "%lu cycles 0 %lu\n", (unsigned long)pair.first, (unsigned long)pair.second.cycles);
+    }
+    if (pair.second.memoryIterations > 0){
+      fprintf(file, "%lu memiters 0 %lu\n", (unsigned long)pair.first, (unsigned long)pair.second.memoryIterations);
+      LoopProfiles::dump(file, pair.first, "meminsts", pair.second.memoryInsts);
+      LoopProfiles::dump(file, pair.first, "memdeps", pair.second.memoryDeps);
+    }
+  }
+  fclose(file);
+
+  return ;
+}
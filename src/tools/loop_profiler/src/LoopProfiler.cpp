@@ -0,0 +1,310 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "SystemHeaders.hpp"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+
+#include "LoopProfiler.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+bool LoopProfiler::instrumentLoop (
+  LoopStructure *loop,
+  Noelle &par,
+  FunctionCallee invocationProfiler,
+  FunctionCallee timeFetcher,
+  FunctionCallee timedInvocationProfiler
+  ){
+
+  /*
+   * Profiles are mapped back to loops by their IDs.
+   * Hence, only loops with IDs embedded in the IR can be profiled.
+   */
+  if (!loop->doesHaveMetadata("noelle.loop_ID")){
+    return false;
+  }
+  auto loopID = loop->getID();
+
+  /*
+   * Fetch the pre-header.
+   */
+  auto preHeader = loop->getPreHeader();
+  if (preHeader == nullptr){
+    return false;
+  }
+
+  /*
+   * Collect the information we need about the loop before changing the CFG.
+   */
+  auto loopFunction = loop->getFunction();
+  auto loopBBs = loop->getBasicBlocks();
+  std::set<std::pair<BasicBlock *, BasicBlock *>> exitEdges{};
+  for (auto exitEdge : loop->getLoopExitEdges()){
+    if (exitEdge.second->isEHPad()){
+      continue ;
+    }
+    exitEdges.insert(exitEdge);
+  }
+
+  /*
+   * Count the iterations of the current invocation of the loop.
+   */
+  auto iterationsCounter = this->createIterationCounter(loop, par);
+
+  /*
+   * Allocate the other counters of the current invocation of the loop.
+   */
+  IRBuilder<> entryBuilder(&*loopFunction->getEntryBlock().getFirstInsertionPt());
+  auto instructionsCounter = entryBuilder.CreateAlloca(par.int64);
+  auto startTime = entryBuilder.CreateAlloca(par.int64);
+
+  /*
+   * Reset the counters every time the loop is invoked.
+   */
+  IRBuilder<> preHeaderBuilder(preHeader->getTerminator());
+  auto zero = ConstantInt::get(par.int64, 0);
+  preHeaderBuilder.CreateStore(zero, instructionsCounter);
+
+  /*
+   * Count the instructions executed by the loop (callees are not included).
+   */
+  if (!this->profileTime){
+    for (auto bb : loopBBs){
+      IRBuilder<> bbBuilder(bb->getTerminator());
+      this->incrementCounter(bbBuilder, instructionsCounter, bb->size(), par);
+    }
+  }
+
+  /*
+   * Take the time when the loop starts.
+   * This is done as late as possible to not include the instrumentation code above.
+   */
+  if (this->profileTime){
+    auto now = preHeaderBuilder.CreateCall(timeFetcher);
+    preHeaderBuilder.CreateStore(now, startTime);
+  }
+
+  /*
+   * Record the invocation when the loop exits.
+   */
+  auto loopIDValue = ConstantInt::get(par.int64, loopID);
+  for (auto exitEdge : exitEdges){
+    auto exitBB = this->fetchBasicBlockOfExitEdge(exitEdge);
+    IRBuilder<> exitBuilder(exitBB->getTerminator());
+    auto iterations = exitBuilder.CreateLoad(iterationsCounter);
+    if (this->profileTime){
+      auto start = exitBuilder.CreateLoad(startTime);
+      exitBuilder.CreateCall(timedInvocationProfiler, { loopIDValue, iterations, start });
+      continue ;
+    }
+    auto instructions = exitBuilder.CreateLoad(instructionsCounter);
+    exitBuilder.CreateCall(invocationProfiler, { loopIDValue, iterations, instructions });
+  }
+
+  return true;
+}
+
+std::map<Instruction *, uint64_t> LoopProfiler::getMemoryAccessesToProfile (
+  LoopStructure *loop,
+  Noelle &par
+  ){
+  std::map<Instruction *, uint64_t> memoryAccesses{};
+
+  /*
+   * Profiles are mapped back to loops by their IDs.
+   */
+  if (  false
+        || (!loop->doesHaveMetadata("noelle.loop_ID"))
+        || (loop->getPreHeader() == nullptr)
+    ){
+    return memoryAccesses;
+  }
+
+  /*
+   * Define a helper to fetch the ID of an instruction.
+   * The profiles are mapped back to the instructions through the IDs of their nodes in the embedded PDG (see noelle-meta-pdg-embed), which do not depend on the position of the instructions in the code.
+   * IDs that do not fit the encoding of the dependences (24 bits) are not profiled.
+   */
+  auto fetchID = [](Instruction *inst, uint64_t &id) -> bool {
+    auto idMetadata = inst->getMetadata("noelle.pdg.inst.id");
+    if (idMetadata == nullptr){
+      return false;
+    }
+    id = mdconst::extract<ConstantInt>(idMetadata->getOperand(0))->getZExtValue();
+    return id < (((uint64_t)1) << 24);
+  };
+
+  /*
+   * Fetch the loads and stores involved in loop-carried memory dependences.
+   */
+  auto LDI = par.getLoop(loop);
+  auto loopDG = LDI->getLoopDG();
+  for (auto edge : loopDG->getEdges()){
+    if (  false
+          || (!edge->isMemoryDependence())
+          || (!edge->isLoopCarriedDependence())
+      ){
+      continue ;
+    }
+    for (auto value : { edge->getOutgoingT(), edge->getIncomingT() }){
+      auto inst = dyn_cast<Instruction>(value);
+      uint64_t id;
+      if (  false
+            || (inst == nullptr)
+            || (!isa<LoadInst>(inst) && !isa<StoreInst>(inst))
+            || (!loop->isIncluded(inst))
+            || (!fetchID(inst, id))
+        ){
+        continue ;
+      }
+      memoryAccesses[inst] = id;
+    }
+  }
+
+  /*
+   * Free the memory.
+   */
+  delete LDI;
+
+  return memoryAccesses;
+}
+
+bool LoopProfiler::instrumentMemoryAccessesOfLoop (
+  LoopStructure *loop,
+  std::map<Instruction *, uint64_t> &memoryAccesses,
+  Noelle &par,
+  FunctionCallee invocationStart,
+  FunctionCallee loadProfiler,
+  FunctionCallee storeProfiler,
+  FunctionCallee invocationEnd
+  ){
+
+  /*
+   * Check if there is something to profile.
+   */
+  if (memoryAccesses.size() == 0){
+    return false;
+  }
+  auto loopID = loop->getID();
+  auto loopIDValue = ConstantInt::get(par.int64, loopID);
+
+  /*
+   * Collect the exit edges before changing the CFG.
+   */
+  std::set<std::pair<BasicBlock *, BasicBlock *>> exitEdges{};
+  for (auto exitEdge : loop->getLoopExitEdges()){
+    if (exitEdge.second->isEHPad()){
+      continue ;
+    }
+    exitEdges.insert(exitEdge);
+  }
+
+  /*
+   * Count the iterations of the current invocation of the loop.
+   * Dependences are loop-carried when the iterations of their accesses differ.
+   */
+  auto iterationsCounter = this->createIterationCounter(loop, par);
+
+  /*
+   * Start tracking the memory accesses every time the loop is invoked.
+   */
+  IRBuilder<> preHeaderBuilder(loop->getPreHeader()->getTerminator());
+  preHeaderBuilder.CreateCall(invocationStart, { loopIDValue });
+
+  /*
+   * Track the memory accesses.
+   * Every access is tracked with its size, so accesses that only overlap partially are still found dependent.
+   */
+  auto &DL = loop->getFunction()->getParent()->getDataLayout();
+  for (auto &pair : memoryAccesses){
+    auto inst = pair.first;
+    auto instID = ConstantInt::get(par.int64, pair.second);
+    IRBuilder<> builder(inst);
+    auto iteration = builder.CreateLoad(iterationsCounter);
+    if (auto load = dyn_cast<LoadInst>(inst)){
+      auto address = builder.CreateBitCast(load->getPointerOperand(), PointerType::getUnqual(par.int8));
+      auto size = ConstantInt::get(par.int64, DL.getTypeStoreSize(load->getType()));
+      builder.CreateCall(loadProfiler, { loopIDValue, instID, address, size, iteration });
+      continue ;
+    }
+    auto store = cast<StoreInst>(inst);
+    auto address = builder.CreateBitCast(store->getPointerOperand(), PointerType::getUnqual(par.int8));
+    auto size = ConstantInt::get(par.int64, DL.getTypeStoreSize(store->getValueOperand()->getType()));
+    builder.CreateCall(storeProfiler, { loopIDValue, instID, address, size, iteration });
+  }
+
+  /*
+   * Stop tracking the memory accesses when the loop exits.
+   */
+  for (auto exitEdge : exitEdges){
+    auto exitBB = this->fetchBasicBlockOfExitEdge(exitEdge);
+    IRBuilder<> exitBuilder(exitBB->getTerminator());
+    auto iterations = exitBuilder.CreateLoad(iterationsCounter);
+    exitBuilder.CreateCall(invocationEnd, { loopIDValue, iterations });
+  }
+
+  return true;
+}
+
+AllocaInst * LoopProfiler::createIterationCounter (
+  LoopStructure *loop,
+  Noelle &par
+  ){
+
+  /*
+   * Allocate the counter.
+   */
+  auto loopFunction = loop->getFunction();
+  IRBuilder<> entryBuilder(&*loopFunction->getEntryBlock().getFirstInsertionPt());
+  auto iterationsCounter = entryBuilder.CreateAlloca(par.int64);
+
+  /*
+   * Reset the counter every time the loop is invoked.
+   */
+  IRBuilder<> preHeaderBuilder(loop->getPreHeader()->getTerminator());
+  preHeaderBuilder.CreateStore(ConstantInt::get(par.int64, 0), iterationsCounter);
+
+  /*
+   * Count the iterations.
+   */
+  IRBuilder<> headerBuilder(&*loop->getHeader()->getFirstInsertionPt());
+  this->incrementCounter(headerBuilder, iterationsCounter, 1, par);
+
+  return iterationsCounter;
+}
+
+BasicBlock * LoopProfiler::fetchBasicBlockOfExitEdge (
+  std::pair<BasicBlock *, BasicBlock *> exitEdge
+  ){
+
+  /*
+   * Nested loops can share exit edges.
+   * Hence, an edge is split only the first time it is requested.
+   */
+  if (this->exitEdgeBlocks.find(exitEdge) == this->exitEdgeBlocks.end()){
+    this->exitEdgeBlocks[exitEdge] = SplitEdge(exitEdge.first, exitEdge.second);
+  }
+
+  return this->exitEdgeBlocks[exitEdge];
+}
+
+void LoopProfiler::incrementCounter (
+  IRBuilder<> &builder,
+  Value *counter,
+  uint64_t increment,
+  Noelle &par
+  ){
+  auto oldValue = builder.CreateLoad(counter);
+  auto newValue = builder.CreateAdd(oldValue, ConstantInt::get(par.int64, increment));
+  builder.CreateStore(newValue, counter);
+
+  return ;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "Noelle.hpp"
+
+using namespace llvm;
+
+namespace llvm::noelle {
+
+  /*
+   * Inject the code that profiles the invocations of the loops of the program.
+   * The profiles are collected by the runtime LoopProfiler_utils.cpp.
+   *
+   * By default, the iterations and the instructions of each invocation are counted.
+   * When time is profiled, the iterations and the cycles of each invocation are measured instead (the instructions are not counted to limit the perturbation of the measurements).
+   * When memory dependences are profiled, the loads and stores involved in loop-carried memory dependences are tracked to identify the dependences that actually occur at run time.
+   */
+  class LoopProfiler : public ModulePass {
+    public:
+      static char ID; 
+
+      LoopProfiler();
+
+      bool doInitialization (Module &M) override ;
+
+      bool runOnModule (Module &M) override ;
+      
+      void getAnalysisUsage(AnalysisUsage &AU) const override ;
+
+    private:
+      bool profileTime;
+      bool profileMemory;
+      std::map<std::pair<BasicBlock *, BasicBlock *>, BasicBlock *> exitEdgeBlocks;
+
+      bool profileMemoryDependences (Module &M, Noelle &noelle) ;
+
+      bool instrumentLoop (
+        LoopStructure *loop,
+        Noelle &par,
+        FunctionCallee invocationProfiler,
+        FunctionCallee timeFetcher,
+        FunctionCallee timedInvocationProfiler
+        ) ;
+
+      /*
+       * Return the loads and stores of @loop that are involved in loop-carried memory dependences.
+       * Each instruction is mapped to the ID of its node in the embedded PDG; instructions without such an ID are not returned.
+       */
+      std::map<Instruction *, uint64_t> getMemoryAccessesToProfile (
+        LoopStructure *loop,
+        Noelle &par
+        ) ;
+
+      bool instrumentMemoryAccessesOfLoop (
+        LoopStructure *loop,
+        std::map<Instruction *, uint64_t> &memoryAccesses,
+        Noelle &par,
+        FunctionCallee invocationStart,
+        FunctionCallee loadProfiler,
+        FunctionCallee storeProfiler,
+        FunctionCallee invocationEnd
+        ) ;
+
+      /*
+       * Return the basic block executed when the loop exits through @exitEdge (the edge is split if needed).
+       */
+      BasicBlock * fetchBasicBlockOfExitEdge (
+        std::pair<BasicBlock *, BasicBlock *> exitEdge
+        ) ;
+
+      AllocaInst * createIterationCounter (
+        LoopStructure *loop,
+        Noelle &par
+        ) ;
+
+      void incrementCounter (IRBuilder<> &builder, Value *counter, uint64_t increment, Noelle &par) ;
+  };
+
+  /*
+   * Embed the loop profiles collected by the runtime of LoopProfiler into the IR.
+   */
+  class LoopProfilesEmbedder : public ModulePass {
+    public:
+      static char ID; 
+
+      LoopProfilesEmbedder();
+
+      bool doInitialization (Module &M) override ;
+
+      bool runOnModule (Module &M) override ;
+      
+      void getAnalysisUsage(AnalysisUsage &AU) const override ;
+
+    private:
+      std::string profileFileName;
+
+      /*
+       * Loop ID -> kind of profile -> bucket -> count.
+       */
+      std::unordered_map<uint64_t, std::unordered_map<std::string, std::map<uint64_t, uint64_t>>> profiles;
+
+      bool readProfiles (void) ;
+
+      MDNode * createHistogramMetadata (LLVMContext &context, std::map<uint64_t, uint64_t> &histogram) ;
+  };
+
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <fstream>
+
+#include "SystemHeaders.hpp"
+#include "LoopProfiler.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+bool LoopProfilesEmbedder::readProfiles (void){
+
+  /*
+   * Open the file.
+   */
+  std::ifstream profileFile(this->profileFileName);
+  if (!profileFile.is_open()){
+    errs() << "LoopProfilesEmbedder: ERROR = cannot open " << this->profileFileName << "\n";
+    return false;
+  }
+
+  /*
+   * Read the profiles.
+   * Every line has the format "LOOP_ID KIND BUCKET COUNT".
+   * Multiple runs can be concatenated in the same file as their counts are added up.
+   */
+  uint64_t loopID, bucket, count;
+  std::string kind;
+  while (profileFile >> loopID >> kind >> bucket >> count){
+    this->profiles[loopID][kind][bucket] += count;
+  }
+
+  return true;
+}
+
+MDNode * LoopProfilesEmbedder::createHistogramMetadata (
+  LLVMContext &context,
+  std::map<uint64_t, uint64_t> &histogram
+  ){
+
+  /*
+   * The histogram is encoded as a sequence of (bucket, count) pairs.
+   */
+  auto int64 = IntegerType::get(context, 64);
+  std::vector<Metadata *> values{};
+  for (auto &pair : histogram){
+    values.push_back(ConstantAsMetadata::get(ConstantInt::get(int64, pair.first)));
+    values.push_back(ConstantAsMetadata::get(ConstantInt::get(int64, pair.second)));
+  }
+  auto histogramMetadata = MDNode::get(context, values);
+
+  return histogramMetadata;
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "SystemHeaders.hpp"
+#include "LoopProfiler.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+static cl::opt<bool> ProfileTime("noelle-loop-profiler-time", cl::ZeroOrMore, cl::Hidden, cl::desc("Profile the time spent in loops"));
+static cl::opt<bool> ProfileMemory("noelle-loop-profiler-memory", cl::ZeroOrMore, cl::Hidden, cl::desc("Profile the loop-carried memory dependences of hot loops"));
+static cl::opt<std::string> LoopProfileFileName("noelle-loop-profile", cl::ZeroOrMore, cl::Hidden, cl::desc("File generated by the runtime of the loop profiler"));
+
+/*********************************** Instrumentation ***********************************/
+
+LoopProfiler::LoopProfiler()
+  :
+  ModulePass(ID),
+  profileTime{false},
+  profileMemory{false}
+  {
+
+  return ;
+}
+
+bool LoopProfiler::doInitialization (Module &M) {
+  this->profileTime = ProfileTime.getNumOccurrences() > 0 ? true : false;
+  this->profileMemory = ProfileMemory.getNumOccurrences() > 0 ? true : false;
+
+  return false;
+}
+
+bool LoopProfiler::runOnModule (Module &M) {
+
+  /*
+   * Fetch the outputs of the passes we rely on.
+   */
+  auto& noelle = getAnalysis<Noelle>();
+
+  /*
+   * Fetch the APIs of the runtime.
+   */
+  auto voidType = Type::getVoidTy(M.getContext());
+  auto invocationProfiler = M.getOrInsertFunction(
+    "NOELLE_LoopProfiler_invocation", 
+    FunctionType::get(voidType, { noelle.int64, noelle.int64, noelle.int64 }, false)
+    );
+  auto timeFetcher = M.getOrInsertFunction(
+    "NOELLE_LoopProfiler_now", 
+    FunctionType::get(noelle.int64, false)
+    );
+  auto timedInvocationProfiler = M.getOrInsertFunction(
+    "NOELLE_LoopProfiler_timedInvocation", 
+    FunctionType::get(voidType, { noelle.int64, noelle.int64, noelle.int64 }, false)
+    );
+
+  /*
+   * Check if memory dependences need to be profiled.
+   */
+  if (this->profileMemory){
+    return this->profileMemoryDependences(M, noelle);
+  }
+
+  /*
+   * Fetch all the loops of the program.
+   */
+  auto loops = noelle.getLoopStructures(0.0);
+
+  /*
+   * Instrument the loops.
+   */
+  auto modified = false;
+  for (auto loop : *loops){
+    modified |= this->instrumentLoop(loop, noelle, invocationProfiler, timeFetcher, timedInvocationProfiler);
+  }
+  errs() << "LoopProfiler: " << (modified ? "Loops have been instrumented" : "No loop has been instrumented") << "\n";
+
+  /*
+   * Free the memory.
+   */
+  delete loops;
+
+  return modified;
+}
+
+bool LoopProfiler::profileMemoryDependences (Module &M, Noelle &noelle) {
+
+  /*
+   * Fetch the APIs of the runtime.
+   */
+  auto voidType = Type::getVoidTy(M.getContext());
+  auto int8Ptr = PointerType::getUnqual(noelle.int8);
+  auto invocationStart = M.getOrInsertFunction(
+    "NOELLE_LoopProfiler_memoryInvocationStart", 
+    FunctionType::get(voidType, { noelle.int64 }, false)
+    );
+  auto loadProfiler = M.getOrInsertFunction(
+    "NOELLE_LoopProfiler_load", 
+    FunctionType::get(voidType, { noelle.int64, noelle.int64, int8Ptr, noelle.int64, noelle.int64 }, false)
+    );
+  auto storeProfiler = M.getOrInsertFunction(
+    "NOELLE_LoopProfiler_store", 
+    FunctionType::get(voidType, { noelle.int64, noelle.int64, int8Ptr, noelle.int64, noelle.int64 }, false)
+    );
+  auto invocationEnd = M.getOrInsertFunction(
+    "NOELLE_LoopProfiler_memoryInvocationEnd", 
+    FunctionType::get(voidType, { noelle.int64, noelle.int64 }, false)
+    );
+
+  /*
+   * Fetch the hot loops of the program.
+   * Tracking memory accesses is expensive, so only the loops that are hot enough (see -noelle-min-hot) are profiled.
+   */
+  auto loops = noelle.getLoopStructures();
+
+  /*
+   * The profiled instructions are identified by the IDs of the embedded PDG.
+   */
+  if (M.getNamedMetadata("noelle.module.pdg") == nullptr){
+    errs() << "LoopProfiler: WARNING: the PDG is not embedded (see noelle-meta-pdg-embed), so memory accesses cannot be profiled\n";
+  }
+
+  /*
+   * Identify the memory accesses to profile.
+   * This must be done before instrumenting any loop as instrumentation changes the dependences of the loops.
+   */
+  std::vector<std::pair<LoopStructure *, std::map<Instruction *, uint64_t>>> loopsToProfile{};
+  for (auto loop : *loops){
+    auto memoryAccesses = this->getMemoryAccessesToProfile(loop, noelle);
+    if (memoryAccesses.size() == 0){
+      continue ;
+    }
+    loopsToProfile.push_back(std::make_pair(loop, memoryAccesses));
+  }
+
+  /*
+   * Instrument the loops.
+   */
+  auto modified = false;
+  for (auto &pair : loopsToProfile){
+    modified |= this->instrumentMemoryAccessesOfLoop(pair.first, pair.second, noelle, invocationStart, loadProfiler, storeProfiler, invocationEnd);
+  }
+  errs() << "LoopProfiler: " << (modified ? "Memory accesses of loops have been instrumented" : "No loop has been instrumented") << "\n";
+
+  /*
+   * Free the memory.
+   */
+  delete loops;
+
+  return modified;
+}
+
+void LoopProfiler::getAnalysisUsage (AnalysisUsage &AU) const {
+  AU.addRequired<Noelle>();
+
+  return ;
+}
+
+/*********************************** Embedding ***********************************/
+
+LoopProfilesEmbedder::LoopProfilesEmbedder()
+  :
+  ModulePass(ID)
+  {
+
+  return ;
+}
+
+bool LoopProfilesEmbedder::doInitialization (Module &M) {
+  this->profileFileName = LoopProfileFileName.getNumOccurrences() > 0 ? LoopProfileFileName.getValue() : "noelle_loop_profile.txt";
+
+  return false;
+}
+
+bool LoopProfilesEmbedder::runOnModule (Module &M) {
+
+  /*
+   * Read the profiles.
+   */
+  if (!this->readProfiles()){
+    return false;
+  }
+
+  /*
+   * Loops are tagged by the metadata attached to the terminator of their headers.
+   */
+  auto &context = M.getContext();
+  auto modified = false;
+  for (auto &F : M){
+    for (auto &bb : F){
+      auto terminator = bb.getTerminator();
+      if (  false
+            || (terminator == nullptr)
+            || (terminator->getMetadata("noelle.loop_ID") == nullptr)
+        ){
+        continue ;
+      }
+
+      /*
+       * Fetch the loop ID.
+       */
+      auto loopIDMetadata = cast<MDNode>(terminator->getMetadata("noelle.loop_ID"));
+      auto loopIDString = cast<MDString>(loopIDMetadata->getOperand(0))->getString();
+      auto loopID = std::stoul(loopIDString.str());
+
+      /*
+       * Check if the loop has been executed.
+       */
+      if (this->profiles.find(loopID) == this->profiles.end()){
+        continue ;
+      }
+
+      /*
+       * Embed the profiles.
+       */
+      for (auto &kindHistogram : this->profiles[loopID]){
+        auto histogramMetadata = this->createHistogramMetadata(context, kindHistogram.second);
+        terminator->setMetadata("noelle.prof.loop_" + kindHistogram.first, histogramMetadata);
+      }
+      modified = true;
+    }
+  }
+
+  return modified;
+}
+
+void LoopProfilesEmbedder::getAnalysisUsage (AnalysisUsage &AU) const {
+  return ;
+}
+
+// Next there is code to register your pass to "opt"
+char LoopProfiler::ID = 0;
+static RegisterPass<LoopProfiler> X("LoopProfiler", "Inject code to profile loop invocations");
+char LoopProfilesEmbedder::ID = 0;
+static RegisterPass<LoopProfilesEmbedder> Y("LoopProfilesEmbedder", "Embed the loop profiles into the IR");
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+
+namespace llvm::noelle {
+
+  /*
+   * Parallel runtime invoked by the code generated by a parallelization technique.
+   */
+  enum class ParallelizationRuntime {
+    NOELLE,
+    OPENMP
+  };
+
+  /*
+   * Code generator for the LLVM OpenMP runtime (libomp).
+   *
+   * Parallel regions are created by outlining a "microtask" (i.e., a function with signature void (i32 *gtid, i32 *btid, shared arguments...)) that is invoked by __kmpc_fork_call.
+   */
+  class OpenMPRuntime {
+    public:
+
+      /*
+       * Scheduling policies of libomp (see kmp_sched_type in kmp.h).
+       */
+      enum Schedule : int32_t {
+        STATIC_CHUNKED = 33,
+        STATIC = 34,
+        DYNAMIC_CHUNKED = 35,
+        GUIDED_CHUNKED = 36,
+        RUNTIME = 37
+      };
+
+      OpenMPRuntime (Module &M) ;
+
+      /*
+       * Create an empty microtask.
+       * The first two arguments are the global and bound thread IDs. The remaining arguments have the types given as input.
+       */
+      Function * createMicrotask (
+        std::vector<Type *> sharedArgumentTypes
+        ) ;
+
+      /*
+       * Fetch the global thread ID of the caller of a microtask.
+       */
+      Value * getGlobalThreadID (
+        IRBuilder<> &builder,
+        Function *microtask
+        ) ;
+
+      /*
+       * Fork a team of threads (at most @numThreads) that execute @microtask with @sharedArguments.
+       * The call returns when all threads of the team completed @microtask.
+       */
+      void createForkCall (
+        IRBuilder<> &builder,
+        Function *microtask,
+        std::vector<Value *> sharedArguments,
+        Value *numThreads
+        ) ;
+
+      /*
+       * Distribute the indices [0, @numberOfIndices) among the threads of the current team using @schedule.
+       * The code generated by @body is executed for every index assigned to the calling thread.
+       *
+       * Return the basic block executed after the distributed loop (it has no terminator).
+       */
+      BasicBlock * createWorksharingLoop (
+        IRBuilder<> &builder,
+        Function *microtask,
+        Value *numberOfIndices,
+        Schedule schedule,
+        std::function<void (IRBuilder<> &bodyBuilder, Value *index)> body
+        ) ;
+
+      CallInst * createBarrier (
+        IRBuilder<> &builder,
+        Value *globalThreadID
+        ) ;
+
+      CallInst * createGetThreadNum (IRBuilder<> &builder) ;
+
+      CallInst * createGetNumThreads (IRBuilder<> &builder) ;
+
+    private:
+      Module &M;
+      IntegerType *int32;
+      IntegerType *int64;
+      PointerType *int8Ptr;
+      StructType *identType;
+      GlobalVariable *ident;
+      FunctionType *microtaskSignature;
+
+      FunctionCallee globalThreadNum;
+      FunctionCallee pushNumThreads;
+      FunctionCallee forkCall;
+      FunctionCallee forStaticInit;
+      FunctionCallee forStaticFini;
+      FunctionCallee dispatchInit;
+      FunctionCallee dispatchNext;
+      FunctionCallee barrier;
+      FunctionCallee getThreadNum;
+      FunctionCallee getNumThreads;
+
+      GlobalVariable * fetchOrCreateIdent (void) ;
+  };
+
+}
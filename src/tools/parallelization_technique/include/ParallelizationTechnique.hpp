@@ -21,6 +21,7 @@
 #include "Hot.hpp"
 #include "PDGPrinter.hpp"
 #include "SubCFGs.hpp"
+#include "OpenMPRuntime.hpp"
 
 namespace llvm::noelle {
 
@@ -61,6 +62,13 @@ namespace llvm::noelle {
 
       virtual void reset () ;
 
+      /*
+       * Select the parallel runtime the generated code relies on.
+       */
+      void setParallelizationRuntime (ParallelizationRuntime runtime) ;
+
+      ParallelizationRuntime getParallelizationRuntime (void) const ;
+
       /*
        * Destructor.
        */
@@ -99,7 +107,11 @@ namespace llvm::noelle {
 
       void populateLiveInEnvironment (LoopDependenceInfo *LDI);
 
-      virtual BasicBlock * propagateLiveOutEnvironment (LoopDependenceInfo *LDI, Value *numberOfThreadsExecuted);
+      /*
+       * Propagate the live-out variables to the code after the parallelized loop.
+       * Variables in @reducedLiveOutVariables have been reduced by the technique already; their private copies are ignored.
+       */
+      virtual BasicBlock * propagateLiveOutEnvironment (LoopDependenceInfo *LDI, Value *numberOfThreadsExecuted, std::unordered_map<int, Value *> reducedLiveOutVariables = {});
 
       /*
        * Task helpers for manipulating loop body clones
@@ -119,6 +131,17 @@ namespace llvm::noelle {
         int taskIndex
       );
 
+      /*
+       * Acquire a private copy of the heap object @location at the entry of the task and release it when the task exits.
+       * Return the private copy.
+       */
+      Instruction * acquirePrivateCopyOfHeapObject (
+        LoopDependenceInfo *LDI,
+        int taskIndex,
+        const ClonableMemoryLocation *location,
+        IRBuilder<> &entryBuilder
+      );
+
       std::unordered_map<InductionVariable *, Value *> cloneIVStepValueComputation (
         LoopDependenceInfo *LDI,
         int taskIndex,
@@ -209,6 +232,11 @@ namespace llvm::noelle {
         Noelle &par
       ) const ;
 
+      /*
+       * Return the code generator for the OpenMP runtime.
+       */
+      OpenMPRuntime * getOpenMPRuntime (void) ;
+
       /*
        * Debug
        */
@@ -233,6 +261,12 @@ namespace llvm::noelle {
        * Profiles.
        */
       Hot &profile;
+
+      /*
+       * Parallel runtime.
+       */
+      ParallelizationRuntime runtime;
+      OpenMPRuntime *openMPRuntime;
   };
 
 }
@@ -0,0 +1,296 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "OpenMPRuntime.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+OpenMPRuntime::OpenMPRuntime (Module &M)
+  : M{M}, ident{nullptr}
+  {
+
+  /*
+   * Fetch the types.
+   */
+  auto &cxt = M.getContext();
+  this->int32 = IntegerType::get(cxt, 32);
+  this->int64 = IntegerType::get(cxt, 64);
+  this->int8Ptr = PointerType::getUnqual(IntegerType::get(cxt, 8));
+  auto int32Ptr = PointerType::getUnqual(int32);
+  auto int64Ptr = PointerType::getUnqual(int64);
+  auto voidType = Type::getVoidTy(cxt);
+
+  /*
+   * Fetch the type of the source location descriptor of libomp (ident_t).
+   * Reuse the one generated by clang if the module has OpenMP code already.
+   */
+  this->identType = M.getTypeByName("struct.ident_t");
+  if (this->identType == nullptr){
+    this->identType = StructType::create(cxt, { int32, int32, int32, int32, int8Ptr }, "struct.ident_t");
+  }
+  auto identPtr = PointerType::getUnqual(this->identType);
+
+  /*
+   * Define the signature of a microtask.
+   */
+  this->microtaskSignature = FunctionType::get(voidType, { int32Ptr, int32Ptr }, true);
+  auto microtaskPtr = PointerType::getUnqual(this->microtaskSignature);
+
+  /*
+   * Declare the APIs of libomp we rely on.
+   */
+  this->globalThreadNum = M.getOrInsertFunction("__kmpc_global_thread_num", FunctionType::get(int32, { identPtr }, false));
+  this->pushNumThreads = M.getOrInsertFunction("__kmpc_push_num_threads", FunctionType::get(voidType, { identPtr, int32, int32 }, false));
+  this->forkCall = M.getOrInsertFunction("__kmpc_fork_call", FunctionType::get(voidType, { identPtr, int32, microtaskPtr }, true));
+  this->forStaticInit = M.getOrInsertFunction("__kmpc_for_static_init_8", FunctionType::get(voidType, { identPtr, int32, int32, int32Ptr, int64Ptr, int64Ptr, int64Ptr, int64, int64 }, false));
+  this->forStaticFini = M.getOrInsertFunction("__kmpc_for_static_fini", FunctionType::get(voidType, { identPtr, int32 }, false));
+  this->dispatchInit = M.getOrInsertFunction("__kmpc_dispatch_init_8", FunctionType::get(voidType, { identPtr, int32, int32, int64, int64, int64, int64 }, false));
+  this->dispatchNext = M.getOrInsertFunction("__kmpc_dispatch_next_8", FunctionType::get(int32, { identPtr, int32, int32Ptr, int64Ptr, int64Ptr, int64Ptr }, false));
+  this->barrier = M.getOrInsertFunction("__kmpc_barrier", FunctionType::get(voidType, { identPtr, int32 }, false));
+  this->getThreadNum = M.getOrInsertFunction("omp_get_thread_num", FunctionType::get(int32, {}, false));
+  this->getNumThreads = M.getOrInsertFunction("omp_get_num_threads", FunctionType::get(int32, {}, false));
+
+  return ;
+}
+
+GlobalVariable * OpenMPRuntime::fetchOrCreateIdent (void) {
+
+  /*
+   * Check if we have already created the descriptor.
+   */
+  if (this->ident != nullptr){
+    return this->ident;
+  }
+
+  /*
+   * Create the string that describes the source location.
+   * libomp only uses it for debugging.
+   */
+  auto &cxt = this->M.getContext();
+  auto locationString = ConstantDataArray::getString(cxt, ";unknown;unknown;0;0;;");
+  auto locationGlobal = new GlobalVariable(this->M, locationString->getType(), true, GlobalValue::PrivateLinkage, locationString, ".noelle.omp.loc.str");
+  auto zero32 = ConstantInt::get(this->int32, 0);
+  auto locationPtr = ConstantExpr::getInBoundsGetElementPtr(locationString->getType(), locationGlobal, ArrayRef<Constant *>({ zero32, zero32 }));
+
+  /*
+   * Create the descriptor.
+   * The flag 2 is KMP_IDENT_KMPC.
+   */
+  auto identInit = ConstantStruct::get(this->identType, {
+    zero32,
+    ConstantInt::get(this->int32, 2),
+    zero32,
+    zero32,
+    locationPtr
+  });
+  this->ident = new GlobalVariable(this->M, this->identType, true, GlobalValue::PrivateLinkage, identInit, ".noelle.omp.ident");
+
+  return this->ident;
+}
+
+Function * OpenMPRuntime::createMicrotask (
+  std::vector<Type *> sharedArgumentTypes
+  ) {
+
+  /*
+   * Define the signature of the microtask.
+   */
+  auto int32Ptr = PointerType::getUnqual(this->int32);
+  std::vector<Type *> argTypes{ int32Ptr, int32Ptr };
+  for (auto t : sharedArgumentTypes){
+    argTypes.push_back(t);
+  }
+  auto &cxt = this->M.getContext();
+  auto signature = FunctionType::get(Type::getVoidTy(cxt), argTypes, false);
+
+  /*
+   * Create the microtask with an empty entry basic block.
+   */
+  auto microtask = Function::Create(signature, GlobalValue::InternalLinkage, ".noelle.omp_outlined", this->M);
+  BasicBlock::Create(cxt, "", microtask);
+
+  return microtask;
+}
+
+Value * OpenMPRuntime::getGlobalThreadID (
+  IRBuilder<> &builder,
+  Function *microtask
+  ) {
+
+  /*
+   * The global thread ID is passed by libomp as first argument of the microtask.
+   */
+  auto gtidPtr = &*microtask->arg_begin();
+  auto gtid = builder.CreateLoad(gtidPtr);
+
+  return gtid;
+}
+
+void OpenMPRuntime::createForkCall (
+  IRBuilder<> &builder,
+  Function *microtask,
+  std::vector<Value *> sharedArguments,
+  Value *numThreads
+  ) {
+  auto ident = this->fetchOrCreateIdent();
+
+  /*
+   * Request the number of threads of the next parallel region.
+   */
+  auto gtid = builder.CreateCall(this->globalThreadNum, { ident });
+  auto numThreads32 = builder.CreateZExtOrTrunc(numThreads, this->int32);
+  builder.CreateCall(this->pushNumThreads, { ident, gtid, numThreads32 });
+
+  /*
+   * Fork.
+   */
+  std::vector<Value *> forkArgs{
+    ident,
+    ConstantInt::get(this->int32, sharedArguments.size()),
+    builder.CreateBitCast(microtask, PointerType::getUnqual(this->microtaskSignature))
+  };
+  for (auto arg : sharedArguments){
+    forkArgs.push_back(arg);
+  }
+  builder.CreateCall(this->forkCall, forkArgs);
+
+  return ;
+}
+
+BasicBlock * OpenMPRuntime::createWorksharingLoop (
+  IRBuilder<> &builder,
+  Function *microtask,
+  Value *numberOfIndices,
+  Schedule schedule,
+  std::function<void (IRBuilder<> &bodyBuilder, Value *index)> body
+  ) {
+  auto &cxt = this->M.getContext();
+  auto ident = this->fetchOrCreateIdent();
+  auto gtid = this->getGlobalThreadID(builder, microtask);
+
+  /*
+   * Allocate the variables libomp uses to return the indices assigned to the calling thread.
+   */
+  auto &entryBB = microtask->getEntryBlock();
+  IRBuilder<> allocaBuilder(&entryBB, entryBB.begin());
+  auto lastIterPtr = allocaBuilder.CreateAlloca(this->int32);
+  auto lowerPtr = allocaBuilder.CreateAlloca(this->int64);
+  auto upperPtr = allocaBuilder.CreateAlloca(this->int64);
+  auto stridePtr = allocaBuilder.CreateAlloca(this->int64);
+
+  /*
+   * Define the bounds of the indices to distribute.
+   */
+  auto zero = ConstantInt::get(this->int64, 0);
+  auto one = ConstantInt::get(this->int64, 1);
+  auto upperBound = builder.CreateSub(builder.CreateZExtOrTrunc(numberOfIndices, this->int64), one);
+
+  /*
+   * Create the basic blocks of the loop.
+   */
+  auto fetchBB = BasicBlock::Create(cxt, "omp.fetch", microtask);
+  auto chunkBB = BasicBlock::Create(cxt, "omp.chunk", microtask);
+  auto bodyBB = BasicBlock::Create(cxt, "omp.body", microtask);
+  auto exitBB = BasicBlock::Create(cxt, "omp.exit", microtask);
+
+  /*
+   * Initialize the work-sharing loop.
+   */
+  builder.CreateStore(ConstantInt::get(this->int32, 0), lastIterPtr);
+  builder.CreateStore(zero, lowerPtr);
+  builder.CreateStore(upperBound, upperPtr);
+  builder.CreateStore(one, stridePtr);
+  auto isStatic = (schedule == Schedule::STATIC);
+  if (isStatic){
+    builder.CreateCall(this->forStaticInit, {
+      ident, gtid, ConstantInt::get(this->int32, schedule),
+      lastIterPtr, lowerPtr, upperPtr, stridePtr,
+      one, one
+    });
+  } else {
+    builder.CreateCall(this->dispatchInit, {
+      ident, gtid, ConstantInt::get(this->int32, schedule),
+      zero, upperBound, one, one
+    });
+  }
+  builder.CreateBr(fetchBB);
+
+  /*
+   * Fetch the next chunk of indices.
+   *
+   * With the static schedule, the calling thread has exactly one block of indices, which has been assigned by __kmpc_for_static_init_8.
+   * With the other schedules, blocks are fetched until __kmpc_dispatch_next_8 returns 0.
+   */
+  IRBuilder<> fetchBuilder(fetchBB);
+  PHINode *firstVisitPHI = nullptr;
+  if (isStatic){
+    firstVisitPHI = fetchBuilder.CreatePHI(IntegerType::get(cxt, 1), 2);
+    firstVisitPHI->addIncoming(ConstantInt::getTrue(cxt), builder.GetInsertBlock());
+    auto lowerValue = fetchBuilder.CreateLoad(lowerPtr);
+    auto upperValue = fetchBuilder.CreateLoad(upperPtr);
+    auto isNotEmpty = fetchBuilder.CreateICmpSLE(lowerValue, upperValue);
+    fetchBuilder.CreateCondBr(fetchBuilder.CreateAnd(firstVisitPHI, isNotEmpty), chunkBB, exitBB);
+
+  } else {
+    auto hasMoreWork = fetchBuilder.CreateCall(this->dispatchNext, { ident, gtid, lastIterPtr, lowerPtr, upperPtr, stridePtr });
+    auto isNotDone = fetchBuilder.CreateICmpNE(hasMoreWork, ConstantInt::get(this->int32, 0));
+    fetchBuilder.CreateCondBr(isNotDone, chunkBB, exitBB);
+  }
+
+  /*
+   * Load the bounds of the current chunk.
+   */
+  IRBuilder<> chunkBuilder(chunkBB);
+  auto chunkLower = chunkBuilder.CreateLoad(lowerPtr);
+  auto chunkUpper = chunkBuilder.CreateLoad(upperPtr);
+  chunkBuilder.CreateBr(bodyBB);
+
+  /*
+   * Execute the body for all indices of the current chunk.
+   */
+  IRBuilder<> bodyBuilder(bodyBB);
+  auto indexPHI = bodyBuilder.CreatePHI(this->int64, 2);
+  indexPHI->addIncoming(chunkLower, chunkBB);
+  body(bodyBuilder, indexPHI);
+  auto nextIndex = bodyBuilder.CreateAdd(indexPHI, one);
+  indexPHI->addIncoming(nextIndex, bodyBuilder.GetInsertBlock());
+  auto isChunkOver = bodyBuilder.CreateICmpSGT(nextIndex, chunkUpper);
+  bodyBuilder.CreateCondBr(isChunkOver, fetchBB, bodyBB);
+  if (firstVisitPHI != nullptr){
+    firstVisitPHI->addIncoming(ConstantInt::getFalse(cxt), bodyBuilder.GetInsertBlock());
+  }
+
+  /*
+   * Finalize the work-sharing loop.
+   */
+  IRBuilder<> exitBuilder(exitBB);
+  if (isStatic){
+    exitBuilder.CreateCall(this->forStaticFini, { ident, gtid });
+  }
+
+  return exitBB;
+}
+
+CallInst * OpenMPRuntime::createBarrier (
+  IRBuilder<> &builder,
+  Value *globalThreadID
+  ) {
+  auto ident = this->fetchOrCreateIdent();
+  return builder.CreateCall(this->barrier, { ident, globalThreadID });
+}
+
+CallInst * OpenMPRuntime::createGetThreadNum (IRBuilder<> &builder) {
+  return builder.CreateCall(this->getThreadNum);
+}
+
+CallInst * OpenMPRuntime::createGetNumThreads (IRBuilder<> &builder) {
+  return builder.CreateCall(this->getNumThreads);
+}
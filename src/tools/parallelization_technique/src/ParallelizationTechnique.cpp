@@ -18,12 +18,34 @@ ParallelizationTechnique::ParallelizationTechnique (
   Hot &p,
   Verbosity v
   )
-  : module{module}, verbose{v}, tasks{}, envBuilder{nullptr}, profile{p}
+  : module{module}, verbose{v}, tasks{}, envBuilder{nullptr}, profile{p}, runtime{ParallelizationRuntime::NOELLE}, openMPRuntime{nullptr}
   {
 
   return ;
 }
 
+void ParallelizationTechnique::setParallelizationRuntime (ParallelizationRuntime runtime) {
+  this->runtime = runtime;
+
+  return ;
+}
+
+ParallelizationRuntime ParallelizationTechnique::getParallelizationRuntime (void) const {
+  return this->runtime;
+}
+
+OpenMPRuntime * ParallelizationTechnique::getOpenMPRuntime (void) {
+
+  /*
+   * Declare the OpenMP APIs only the first time they are needed.
+   */
+  if (this->openMPRuntime == nullptr){
+    this->openMPRuntime = new OpenMPRuntime(this->module);
+  }
+
+  return this->openMPRuntime;
+}
+
 Value * ParallelizationTechnique::getEnvArray (void) const { 
   return envBuilder->getEnvArray(); 
 }
@@ -132,7 +154,7 @@ void ParallelizationTechnique::populateLiveInEnvironment (LoopDependenceInfo *LD
   return ;
 }
 
-BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependenceInfo *LDI, Value *numberOfThreadsExecuted) {
+BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependenceInfo *LDI, Value *numberOfThreadsExecuted, std::unordered_map<int, Value *> reducedLiveOutVariables) {
   auto builder = new IRBuilder<>(this->entryPointOfParallelizedLoop);
 
   /*
@@ -149,12 +171,24 @@ BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependen
   /*
    * Collect reduction operation information needed to accumulate reducable variables after parallelization execution
    */
-  std::unordered_map<int, int> reducableBinaryOps;
+  std::unordered_map<int, std::function<Value * (IRBuilder<> &builder, Value *accumulatedValue, Value *privateValue)>> reducers;
   std::unordered_map<int, Value *> initialValues;
   for (auto envInd : LDI->environment->getEnvIndicesOfLiveOutVars()) {
     auto isReduced = envBuilder->isReduced(envInd);
     if (!isReduced) continue;
 
+    /*
+     * Variables already reduced start from their final value and they do not accumulate the private copies of the tasks.
+     */
+    auto reducedVariable = reducedLiveOutVariables.find(envInd);
+    if (reducedVariable != reducedLiveOutVariables.end()) {
+      reducers[envInd] = [](IRBuilder<> &reductionBuilder, Value *accumulatedValue, Value *privateValue) -> Value * {
+        return accumulatedValue;
+      };
+      initialValues[envInd] = reducedVariable->second;
+      continue;
+    }
+
     auto producer = LDI->environment->producerAt(envInd);
     auto producerSCC = sccManager->getSCCDAG()->sccOfValue(producer);
     auto producerSCCAttributes = sccManager->getSCCAttrs(producerSCC);
@@ -163,8 +197,10 @@ BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependen
      * HACK: Need to get accumulator that feeds directly into producer PHI, not any intermediate one
      */
     auto firstAccumI = *(producerSCCAttributes->getAccumulators().begin());
-    auto binOpCode = firstAccumI->getOpcode();
-    reducableBinaryOps[envInd] = sccManager->accumOpInfo.accumOpForType(binOpCode, producer->getType());
+    auto accumOpInfo = &sccManager->accumOpInfo;
+    reducers[envInd] = [accumOpInfo, firstAccumI](IRBuilder<> &reductionBuilder, Value *accumulatedValue, Value *privateValue) -> Value * {
+      return accumOpInfo->generateAccumulation(reductionBuilder, firstAccumI, accumulatedValue, privateValue);
+    };
 
     PHINode *loopEntryProducerPHI = fetchLoopEntryPHIOfProducer(LDI, producer);
     auto initValPHIIndex = loopEntryProducerPHI->getBasicBlockIndex(loopPreHeader);
@@ -175,7 +211,7 @@ BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependen
   auto afterReductionB = this->envBuilder->reduceLiveOutVariables(
     this->entryPointOfParallelizedLoop,
     *builder,
-    reducableBinaryOps,
+    reducers,
     initialValues,
     numberOfThreadsExecuted);
 
@@ -392,14 +428,14 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
   rootLoop->getFunction()->print(errs());
 
   /*
-   * Check every stack object that can be safely cloned.
+   * Check every stack and heap object that can be safely cloned.
    */
   for (auto location : memoryCloningAnalysis->getClonableMemoryLocations()) {
 
     /*
-     * Fetch the stack object.
+     * Fetch the memory object.
      */
-    auto alloca = location->getAllocation();
+    auto allocation = location->getAllocation();
 
     /*
      * Check if this is an allocation used by this task
@@ -424,9 +460,9 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
      *
      * The stack object can be safely cloned (thanks to the object-cloning analysis) and it is used by our loop.
      *
-     * First, we need to remove the alloca instruction to be a live-in.
+     * First, we need to remove the allocation to be a live-in.
      */
-    task->removeLiveIn(alloca);
+    task->removeLiveIn(allocation);
 
     /*
      * Now we need to traverse operands of loop instructions to clone
@@ -436,6 +472,16 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
     auto &entryBlock = (*task->getTaskBody()->begin());
     auto firstInstruction = &*entryBlock.begin();
     IRBuilder<> entryBuilder(&entryBlock);
+
+    /*
+     * Heap objects are cloned by acquiring a private buffer from the pool of the runtime.
+     * The buffer must be acquired before the clones of the casts and GEPs of the object (see below) use it.
+     */
+    Instruction *heapObjectClone = nullptr;
+    if (location->isHeapObject()) {
+      heapObjectClone = this->acquirePrivateCopyOfHeapObject(LDI, taskIndex, location, entryBuilder);
+    }
+
     std::queue<Instruction *> instructionsToConvertOperandsOf;
     for (auto I : taskInstructions) {
       instructionsToConvertOperandsOf.push(I);
@@ -522,9 +568,9 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
           }
 
           /*
-           * Check if the current operand is the alloca instruction that will be cloned.
+           * Check if the current operand is the allocation that will be cloned.
            */
-          if (opJ == alloca){
+          if (opJ == allocation){
             assert(!task->isAnOriginalLiveIn(opJ));
             continue ;
           }
@@ -571,10 +617,18 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
       }
     }
 
+    /*
+     * Keep track of the original-clone mapping of heap objects.
+     */
+    if (heapObjectClone != nullptr) {
+      task->addInstruction(allocation, heapObjectClone);
+      continue ;
+    }
+
     /*
      * Clone the stack object at the beginning of the task.
      */
-    auto allocaClone = alloca->clone();
+    auto allocaClone = allocation->clone();
     auto firstInst = &*entryBlock.begin();
     entryBuilder.SetInsertPoint(firstInst);
     entryBuilder.Insert(allocaClone);
@@ -582,7 +636,7 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
     /*
      * Keep track of the original-clone mapping.
      */
-    task->addInstruction(alloca, allocaClone);
+    task->addInstruction(allocation, allocaClone);
   }
   task->getTaskBody()->print(errs());
   rootLoop->getFunction()->print(errs());
@@ -590,6 +644,76 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
   return ;
 }
 
+Instruction * ParallelizationTechnique::acquirePrivateCopyOfHeapObject (
+  LoopDependenceInfo *LDI,
+  int taskIndex,
+  const ClonableMemoryLocation *location,
+  IRBuilder<> &entryBuilder
+){
+
+  /*
+   * Fetch the APIs of the pool of private buffers.
+   */
+  auto acquireFunction = this->module.getFunction("NOELLE_acquirePrivateBuffer");
+  auto releaseFunction = this->module.getFunction("NOELLE_releasePrivateBuffer");
+  if (acquireFunction == nullptr){
+    errs() << "NOELLE: ERROR = function NOELLE_acquirePrivateBuffer couldn't be found\n";
+    abort();
+  }
+  if (releaseFunction == nullptr){
+    errs() << "NOELLE: ERROR = function NOELLE_releasePrivateBuffer couldn't be found\n";
+    abort();
+  }
+
+  /*
+   * Fetch the task.
+   */
+  auto task = this->tasks[taskIndex];
+  auto envUser = this->envBuilder->getUser(taskIndex);
+  auto allocation = location->getAllocation();
+
+  /*
+   * Compute the size of the heap object just before dispatching the loop.
+   * If the size is not a constant, it becomes a new live-in of the task.
+   */
+  IRBuilder<> dispatcherBuilder(this->entryPointOfParallelizedLoop);
+  auto sizeInBytes = location->generateCodeToComputeSizeInBytes(dispatcherBuilder);
+  Value *sizeInBytesInTask = sizeInBytes;
+  if (!isa<Constant>(sizeInBytes)){
+    auto envIndex = LDI->environment->addLiveInValue(sizeInBytes, {});
+    this->envBuilder->addVariableToEnvironment(envIndex, sizeInBytes->getType());
+    envUser->addLiveInIndex(envIndex);
+    envUser->createEnvPtr(entryBuilder, envIndex, sizeInBytes->getType());
+    sizeInBytesInTask = entryBuilder.CreateLoad(envUser->getEnvPtr(envIndex));
+  }
+
+  /*
+   * Acquire the private copy of the task.
+   * Buffers are recycled by the runtime across invocations of the loop, so the memory allocator is rarely invoked.
+   */
+  auto sizeType = acquireFunction->getFunctionType()->getParamType(0);
+  auto buffer = entryBuilder.CreateCall(acquireFunction, ArrayRef<Value *>({
+    entryBuilder.CreateZExtOrTrunc(sizeInBytesInTask, sizeType)
+  }));
+  auto privateCopy = cast<Instruction>(entryBuilder.CreatePointerCast(buffer, allocation->getType()));
+
+  /*
+   * Release the private copy when the task exits.
+   */
+  auto exitBlock = task->getExit();
+  auto exitTerminator = exitBlock->getTerminator();
+  IRBuilder<> exitBuilder(exitBlock);
+  if (exitTerminator != nullptr){
+    exitBuilder.SetInsertPoint(exitTerminator);
+  }
+  auto bufferType = releaseFunction->getFunctionType()->getParamType(0);
+  exitBuilder.CreateCall(releaseFunction, ArrayRef<Value *>({
+    exitBuilder.CreatePointerCast(privateCopy, bufferType)
+  }));
+
+  return privateCopy;
+}
+
 void ParallelizationTechnique::generateCodeToLoadLiveInVariables (
   LoopDependenceInfo *LDI, 
   int taskIndex
@@ -1428,5 +1552,9 @@ void ParallelizationTechnique::reset () {
 ParallelizationTechnique::~ParallelizationTechnique () {
   reset();
 
+  if (this->openMPRuntime != nullptr){
+    delete this->openMPRuntime;
+  }
+
   return ;
 }
@@ -0,0 +1,319 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "Parallelizer.hpp"
+
+#include "llvm/IR/IntrinsicInst.h"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+namespace llvm::noelle {
+
+  std::vector<Instruction *> Parallelizer::getCodeAfterLoopIndependentOfIt (
+    LoopDependenceInfo *LDI,
+    BasicBlock *loopExitBlock
+    ) {
+    std::vector<Instruction *> independentInstructions{};
+
+    /*
+    * Fetch the loop.
+    */
+    auto loopStructure = LDI->getLoopStructure();
+
+    /*
+    * Fetch the dependence graph of the loop.
+    * This graph includes the instructions outside the loop that depend on (or that the loop depends on) instructions of the loop.
+    */
+    auto loopDG = LDI->getLoopDG();
+
+    /*
+    * Collect the code of the exit block that is independent of the loop.
+    * This code starts after the PHI nodes that merge the live-out values of the loop and it ends right before the first instruction that depends on the loop.
+    */
+    for (auto &I : *loopExitBlock){
+
+      /*
+      * Live-out values of the loop are merged by PHI nodes.
+      */
+      if (isa<PHINode>(&I)){
+        continue ;
+      }
+
+      /*
+      * The terminator must stay in the exit block.
+      */
+      if (I.isTerminator()){
+        break ;
+      }
+
+      /*
+      * Instructions that change the stack, that can raise exceptions, or that synchronize with other threads cannot run while the parallelized loop is executing.
+      * Calls that never return (e.g., exit) cannot run either as they would end the program before the loop.
+      */
+      if (  false
+            || isa<AllocaInst>(&I)
+            || I.isEHPad()
+            || I.mayThrow()
+            || I.isAtomic()
+        ){
+        break ;
+      }
+      if (auto callInst = dyn_cast<CallBase>(&I)){
+        if (  false
+              || callInst->doesNotReturn()
+              || callInst->isInlineAsm()
+          ){
+          break ;
+        }
+      }
+      if (  false
+            || (isa<LoadInst>(&I) && cast<LoadInst>(&I)->isVolatile())
+            || (isa<StoreInst>(&I) && cast<StoreInst>(&I)->isVolatile())
+            || (isa<MemIntrinsic>(&I) && cast<MemIntrinsic>(&I)->isVolatile())
+        ){
+        break ;
+      }
+
+      /*
+      * Check that the instruction does not consume values computed by the loop, including its live-out values.
+      */
+      auto usesLoopValues = false;
+      for (auto &op : I.operands()){
+        if (auto opInst = dyn_cast<Instruction>(op.get())){
+          if (  false
+                || loopStructure->isIncluded(opInst)
+                || (isa<PHINode>(opInst) && (opInst->getParent() == loopExitBlock))
+            ){
+            usesLoopValues = true;
+            break ;
+          }
+        }
+      }
+      if (usesLoopValues){
+        break ;
+      }
+
+      /*
+      * Check that there is no dependence (data, memory, or control) between the instruction and the loop.
+      * Any edge connected to an external node of the loop dependence graph links it to an instruction of the loop.
+      * Hence, stores and calls that only access memory the loop does not touch can run while the loop executes.
+      */
+      if (loopDG->isInGraph(&I)){
+        auto node = loopDG->fetchNode(&I);
+        if (node->numConnectedEdges() > 0){
+          break ;
+        }
+      }
+
+      /*
+      * The instruction can run in parallel with the loop.
+      */
+      independentInstructions.push_back(&I);
+    }
+
+    return independentInstructions;
+  }
+
+  bool Parallelizer::overlapIndependentCodeWithParallelizedLoop (
+    LoopDependenceInfo *LDI,
+    Noelle &par,
+    CallInst *dispatcherCall,
+    BasicBlock *exitPoint
+    ) {
+
+    /*
+    * Fetch the verbosity level.
+    */
+    auto verbose = par.getVerbosity();
+
+    /*
+    * Fetch the loop.
+    */
+    auto loopStructure = LDI->getLoopStructure();
+    auto loopFunction = loopStructure->getFunction();
+    auto M = loopFunction->getParent();
+
+    /*
+    * The invocation of the dispatcher is the one emitted by DOALL.
+    */
+    if (dispatcherCall == nullptr){
+      return false;
+    }
+
+    /*
+    * Fetch the asynchronous APIs of the runtime.
+    */
+    auto asyncDispatcher = M->getFunction("NOELLE_DOALLDispatcherAsync");
+    auto joinFunction = M->getFunction("NOELLE_DOALLJoin");
+    if (  false
+          || (asyncDispatcher == nullptr)
+          || (joinFunction == nullptr)
+      ){
+      return false;
+    }
+
+    /*
+    * We only handle loops with a single exit.
+    */
+    auto loopExitBlocks = loopStructure->getLoopExitBasicBlocks();
+    if (loopExitBlocks.size() != 1){
+      return false;
+    }
+    auto loopExitBlock = loopExitBlocks[0];
+
+    /*
+    * Fetch the PHI nodes that merge the live-out values of the loop.
+    * The parallelized loop must provide all of them.
+    */
+    std::vector<PHINode *> liveOutPHIs{};
+    for (auto &phi : loopExitBlock->phis()){
+      if (phi.getBasicBlockIndex(exitPoint) == -1){
+        return false;
+      }
+      liveOutPHIs.push_back(&phi);
+    }
+
+    /*
+    * Identify the code after the loop that does not depend on it.
+    */
+    auto independentInstructions = this->getCodeAfterLoopIndependentOfIt(LDI, loopExitBlock);
+    if (independentInstructions.size() == 0){
+      return false;
+    }
+    if (verbose != Verbosity::Disabled) {
+      errs() << "Parallelizer:  " << independentInstructions.size() << " instructions after the loop will run while the parallelized loop is executing\n";
+    }
+
+    /*
+    * Split the exit block: the first part includes the PHI nodes of the live-out values, the second one the independent code, and the last one the rest starting from the first instruction that depends on the loop.
+    */
+    auto independentBlock = loopExitBlock;
+    if (liveOutPHIs.size() > 0){
+      independentBlock = loopExitBlock->splitBasicBlock(loopExitBlock->getFirstNonPHI());
+    }
+    auto firstDependentInst = independentInstructions.back()->getNextNode();
+    auto restOfExitBlock = independentBlock->splitBasicBlock(firstDependentInst);
+
+    /*
+    * Dispatch the parallelized loop asynchronously.
+    */
+    IRBuilder<> builder(dispatcherCall);
+    std::vector<Value *> dispatcherArgs{};
+    for (auto &arg : dispatcherCall->arg_operands()){
+      dispatcherArgs.push_back(arg.get());
+    }
+    auto handle = builder.CreateCall(asyncDispatcher, dispatcherArgs);
+
+    /*
+    * Execute the independent code while the parallelized loop runs.
+    */
+    std::unordered_map<Value *, Value *> clones{};
+    for (auto inst : independentInstructions){
+      auto cloneInst = inst->clone();
+      for (auto &op : cloneInst->operands()){
+        auto it = clones.find(op.get());
+        if (it != clones.end()){
+          op.set(it->second);
+        }
+      }
+      builder.Insert(cloneInst);
+      clones[inst] = cloneInst;
+    }
+
+    /*
+    * Join the parallelized loop.
+    * The join is executed right before the code that depends on the loop (e.g., the code that reduces and propagates its live-out values and the rest of the exit block).
+    */
+    auto joinCall = builder.CreateCall(joinFunction, { handle });
+    dispatcherCall->replaceAllUsesWith(joinCall);
+    dispatcherCall->eraseFromParent();
+
+    /*
+    * The parallelized loop skips the independent code as it has been executed already.
+    */
+    auto exitTerminator = exitPoint->getTerminator();
+    for (auto i = 0; i < exitTerminator->getNumSuccessors(); i++){
+      if (exitTerminator->getSuccessor(i) == loopExitBlock){
+        exitTerminator->setSuccessor(i, restOfExitBlock);
+      }
+    }
+
+    /*
+    * Merge the live-out values of the loop along the two paths.
+    */
+    IRBuilder<> phiBuilder(&*restOfExitBlock->begin());
+    for (auto liveOutPHI : liveOutPHIs){
+
+      /*
+      * Fetch the live-out value computed by the parallelized loop.
+      */
+      auto parallelizedValue = liveOutPHI->getIncomingValueForBlock(exitPoint);
+      liveOutPHI->removeIncomingValue(exitPoint, false);
+
+      /*
+      * Collect the uses outside the PHI nodes of the exit block.
+      */
+      std::vector<Use *> usesToReplace{};
+      for (auto &use : liveOutPHI->uses()){
+        auto userInst = cast<Instruction>(use.getUser());
+        if (userInst->getParent() != loopExitBlock){
+          usesToReplace.push_back(&use);
+        }
+      }
+
+      /*
+      * Merge.
+      */
+      auto phi = phiBuilder.CreatePHI(liveOutPHI->getType(), 2);
+      phi->addIncoming(liveOutPHI, independentBlock);
+      phi->addIncoming(parallelizedValue, exitPoint);
+      for (auto use : usesToReplace){
+        use->set(phi);
+      }
+    }
+
+    /*
+    * Merge the values computed by the independent code along the two paths.
+    */
+    for (auto inst : independentInstructions){
+      if (inst->getType()->isVoidTy()){
+        continue ;
+      }
+
+      /*
+      * Collect the uses outside the independent code.
+      */
+      std::vector<Use *> usesToReplace{};
+      for (auto &use : inst->uses()){
+        auto userInst = cast<Instruction>(use.getUser());
+        if (userInst->getParent() != independentBlock){
+          usesToReplace.push_back(&use);
+        }
+      }
+      if (usesToReplace.size() == 0){
+        continue ;
+      }
+
+      /*
+      * Merge.
+      */
+      auto phi = phiBuilder.CreatePHI(inst->getType(), 2);
+      phi->addIncoming(inst, independentBlock);
+      phi->addIncoming(clones[inst], exitPoint);
+      for (auto use : usesToReplace){
+        use->set(phi);
+      }
+    }
+
+    return true;
+  }
+
+}
@@ -18,7 +18,11 @@ namespace llvm::noelle {
   std::vector<LoopDependenceInfo *> Parallelizer::selectTheOrderOfLoopsToParallelize (
     Noelle &noelle, 
     Hot *profiles,
-    noelle::StayConnectedNestedLoopForestNode *tree
+    noelle::StayConnectedNestedLoopForestNode *tree,
+    DSWP &dswp,
+    DOALL &doall,
+    HELIX &helix,
+    Heuristics *h
     ) {
     std::vector<LoopDependenceInfo *> selectedLoops{};
 
@@ -28,10 +32,14 @@ namespace llvm::noelle {
     auto verbose = noelle.getVerbosity();
 
     /*
-    * Compute the amount of time that can be saved by a parallelization technique per loop.
+    * Estimate the amount of time that can be saved by parallelizing each loop on its own.
     */
-    std::map<LoopDependenceInfo *, uint64_t> timeSavedLoops;
-    auto selector = [&noelle, &timeSavedLoops, profiles](StayConnectedNestedLoopForestNode *n, uint32_t treeLevel) -> bool {
+    std::map<LoopDependenceInfo *, double> timeSavedLoops;
+    std::map<LoopDependenceInfo *, double> timeLoops;
+    std::map<LoopDependenceInfo *, std::string> techniqueLoops;
+    std::unordered_map<StayConnectedNestedLoopForestNode *, LoopDependenceInfo *> nodeLoops;
+    SpeedupModel model(profiles);
+    auto selector = [this, &noelle, &timeSavedLoops, &timeLoops, &techniqueLoops, &nodeLoops, &model, profiles, &dswp, &doall, &helix, h](StayConnectedNestedLoopForestNode *n, uint32_t treeLevel) -> bool {
 
       /*
       * Fetch the loop.
@@ -39,105 +47,102 @@ namespace llvm::noelle {
       auto ls = n->getLoop();
       auto optimizations = { LoopDependenceInfoOptimization::MEMORY_CLONING_ID };
       auto ldi = noelle.getLoop(ls, optimizations);
+      nodeLoops[n] = ldi;
 
       /*
-      * Fetch the set of sequential SCCs.
+      * Fetch the time spent in the loop.
+      * The unit is the same for every loop of the forest (see SpeedupModel) so savings can be compared across loops.
       */
-      auto sccManager = ldi->getSCCManager();
-      auto sequentialSCCs = sccManager->getSCCsOfType(SCCAttrs::SCCType::SEQUENTIAL);
+      timeLoops[ldi] = model.getSequentialTime(ldi);
 
       /*
-      * Find the biggest sequential SCC.
+      * Estimate the time saved.
       */
-      uint64_t biggestSCCTime = 0;
-      for (auto sequentialSCC : sequentialSCCs){
-        assert(sequentialSCC->mustExecuteSequentially());
-
-        /*
-        * Fetch the SCC.
-        */
-        auto currentSCC = sequentialSCC->getSCC();
-
-        /*
-        * Check if the SCC can be removed by a transformation.
-        */
-        if (sequentialSCC->isInductionVariableSCC()){
-          continue ;
-        }
-        if (sequentialSCC->canBeCloned()){
-          continue ;
-        }
-        if (sequentialSCC->canBeClonedUsingLocalMemoryLocations()){
-          continue ;
-        }
+      std::string technique{};
+      timeSavedLoops[ldi] = this->estimateTimeSavedByParallelizingLoop(ldi, noelle, profiles, dswp, doall, helix, h, technique);
+      techniqueLoops[ldi] = technique;
 
-        auto areAllDataLCDsFromDisjointMemoryAccesses = true;
-        auto domainSpaceAnalysis = ldi->getLoopIterationDomainSpaceAnalysis();
-        sccManager->iterateOverLoopCarriedDataDependences(currentSCC, [
-          &areAllDataLCDsFromDisjointMemoryAccesses, domainSpaceAnalysis
-        ](DGEdge<Value> *dep) -> bool {
-          if (dep->isControlDependence()) return false;
-
-          if (!dep->isMemoryDependence()) {
-            areAllDataLCDsFromDisjointMemoryAccesses = false;
-            return true;
-          }
-
-          auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
-          auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
-          areAllDataLCDsFromDisjointMemoryAccesses &= fromInst && toInst && domainSpaceAnalysis->
-            areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst);
-          return !areAllDataLCDsFromDisjointMemoryAccesses;
-        });
-        if (areAllDataLCDsFromDisjointMemoryAccesses) {
-          continue;
-        }
+      return false;
+    };
+    tree->visitPreOrder(selector);
 
-        /*
-        * Fetch the time spent in the current SCC.
-        */
-        auto currentSCCTime = profiles->getTotalInstructions(currentSCC);
+    /*
+    * Choose the loops to parallelize in the tree.
+    *
+    * Parallelizing a loop excludes its sub-loops. Hence, the best plan for the sub-tree rooted at a loop either includes only that loop or it is the union of the best plans of its children.
+    * These plans are computed bottom-up.
+    */
+    std::unordered_map<StayConnectedNestedLoopForestNode *, double> bestSavings;
+    std::unordered_map<StayConnectedNestedLoopForestNode *, double> childrenSavings;
+    std::unordered_set<StayConnectedNestedLoopForestNode *> isParallelizedOnItsOwn;
+    auto planner = [&bestSavings, &childrenSavings, &isParallelizedOnItsOwn, &nodeLoops, &timeSavedLoops, &techniqueLoops](StayConnectedNestedLoopForestNode *n, uint32_t treeLevel) -> bool {
 
-        /*
-        * Compute the biggest SCC.
-        */
-        if (currentSCCTime > biggestSCCTime){
-          biggestSCCTime = currentSCCTime;
-        }
+      /*
+      * Compare parallelizing the loop with parallelizing the best set of its sub-loops.
+      * Ties go to the loop as it dispatches tasks less often.
+      */
+      auto ldi = nodeLoops[n];
+      auto loopSavings = timeSavedLoops[ldi];
+      auto subLoopsSavings = childrenSavings[n];
+      if (  true
+            && (techniqueLoops[ldi] != "")
+            && (loopSavings > 0)
+            && (loopSavings >= subLoopsSavings)
+        ){
+        isParallelizedOnItsOwn.insert(n);
+        bestSavings[n] = loopSavings;
+      } else {
+        bestSavings[n] = subLoopsSavings;
       }
 
       /*
-      * Compute the maximum amount of time saved by any parallelization technique.
+      * Propagate the result to the parent.
       */
-      timeSavedLoops[ldi] = 0;
-      if (profiles->getIterations(ls) > 0){
-        auto instsPerIteration = profiles->getAverageTotalInstructionsPerIteration(ls);
-        auto instsInBiggestSCCPerIteration = ((double)biggestSCCTime) / ((double)profiles->getIterations(ls));
-        assert(instsInBiggestSCCPerIteration <= instsPerIteration);
-        auto timeSavedPerIteration = (double)(instsPerIteration - instsInBiggestSCCPerIteration);
-        auto timeSaved = timeSavedPerIteration * profiles->getIterations(ls);
-        timeSavedLoops[ldi] = (uint64_t)timeSaved;
+      auto parent = n->getParent();
+      if (parent != nullptr){
+        childrenSavings[parent] += bestSavings[n];
       }
 
       return false;
     };
-    tree->visitPreOrder(selector);
+    tree->visitPostOrder(planner);
 
     /*
-    * Sort the loops depending on the amount of time that can be saved by a parallelization technique.
+    * Collect the plan: the loops parallelized on their own that are not included in a loop parallelized already.
     */
-    for (auto loopPair : timeSavedLoops){
-
-      /*
-      * Fetch the loop.
-      */
-      auto ldi = loopPair.first;
+    std::vector<LoopDependenceInfo *> plan{};
+    std::vector<LoopDependenceInfo *> alternatives{};
+    for (auto &pair : nodeLoops){
+      auto n = pair.first;
+      auto ldi = pair.second;
+      auto isInPlan = isParallelizedOnItsOwn.find(n) != isParallelizedOnItsOwn.end();
+      for (auto ancestor = n->getParent(); isInPlan && (ancestor != nullptr); ancestor = ancestor->getParent()){
+        if (isParallelizedOnItsOwn.find(ancestor) != isParallelizedOnItsOwn.end()){
+          isInPlan = false;
+        }
+      }
+      if (isInPlan){
+        plan.push_back(ldi);
+        continue ;
+      }
 
       /*
-      * Add it.
+      * The other loops are parallelized only if the ones in the plan cannot be (e.g., because the code generation of a technique fails).
+      * Loops that would slow down the program are dropped unless parallelization is forced.
       */
-      selectedLoops.push_back(ldi);
+      if (  true
+            && (!this->forceParallelization)
+            && (timeSavedLoops[ldi] < 0)
+        ){
+        delete ldi;
+        continue ;
+      }
+      alternatives.push_back(ldi);
     }
+
+    /*
+    * Sort the loops depending on the amount of time that can be saved by a parallelization technique.
+    */
     auto compareOperator = [&timeSavedLoops](LoopDependenceInfo *l1, LoopDependenceInfo *l2){
       auto s1 = timeSavedLoops[l1];
       auto s2 = timeSavedLoops[l2];
@@ -153,23 +158,97 @@ namespace llvm::noelle {
       auto l2LS = l2->getLoopStructure();
       return l1LS->getNestingLevel() < l2LS->getNestingLevel();
     };
-    std::sort(selectedLoops.begin(), selectedLoops.end(), compareOperator);
+    std::sort(plan.begin(), plan.end(), compareOperator);
+    std::sort(alternatives.begin(), alternatives.end(), compareOperator);
+    selectedLoops.insert(selectedLoops.end(), plan.begin(), plan.end());
+    selectedLoops.insert(selectedLoops.end(), alternatives.begin(), alternatives.end());
 
     /*
-    * Print the order and the savings.
+    * Print the plan and the savings.
     */
     if (verbose != Verbosity::Disabled) {
-      errs() << "Parallelizer: LoopSelector: Start\n";
-      errs() << "Parallelizer: LoopSelector:   Order of loops and their maximum savings\n";
-      for (auto l : selectedLoops){
-        auto ls = l->getLoopStructure();
-        auto savedTimeRelative = ((double)timeSavedLoops[l]) / ((double) profiles->getTotalInstructions(ls));
+      auto printLoop = [&timeSavedLoops, &timeLoops, &techniqueLoops](LoopDependenceInfo *l) {
+        auto savedTimeRelative = (timeLoops[l] > 0) ? (timeSavedLoops[l] / timeLoops[l]) : 0;
         savedTimeRelative *= 100;
-        errs() << "Parallelizer: LoopSelector:    Loop " << l->getID() << " savings = " << savedTimeRelative << "%\n";
+        errs() << "Parallelizer: LoopSelector:    Loop " << l->getID() << " (" << (techniqueLoops[l] == "" ? "no technique" : techniqueLoops[l]) << ") savings = " << savedTimeRelative << "%\n";
+      };
+      errs() << "Parallelizer: LoopSelector: Start\n";
+      errs() << "Parallelizer: LoopSelector:   Plan of the nesting tree (predicted savings = " << bestSavings[tree] << ")\n";
+      for (auto l : plan){
+        printLoop(l);
+      }
+      errs() << "Parallelizer: LoopSelector:   Alternatives if the plan cannot be applied\n";
+      for (auto l : alternatives){
+        printLoop(l);
       }
       errs() << "Parallelizer: LoopSelector: End\n";
     }
 
     return selectedLoops;
   }
+
+  double Parallelizer::estimateTimeSavedByParallelizingLoop (
+    LoopDependenceInfo *ldi,
+    Noelle &noelle,
+    Hot *profiles,
+    DSWP &dswp,
+    DOALL &doall,
+    HELIX &helix,
+    Heuristics *h,
+    std::string &technique
+    ) {
+
+    /*
+    * Fetch the time spent in the loop.
+    * Time is measured in cycles if loops have been timed. Otherwise, it is measured in instructions executed.
+    */
+    SpeedupModel model(profiles);
+    auto loopTime = model.getSequentialTime(ldi);
+
+    /*
+    * Fetch the cores available.
+    */
+    auto cores = ldi->getMaximumNumberOfCores();
+
+    /*
+    * Estimate the time spent in the loop once parallelized by the technique the parallelizer would choose.
+    * The estimate includes the cost of dispatching and joining the tasks of every invocation.
+    */
+    technique = "";
+    double parallelTime = loopTime;
+    if (  true
+          && noelle.isTransformationEnabled(DOALL_ID)
+          && ldi->isTransformationEnabled(DOALL_ID)
+          && doall.canBeAppliedToLoop(ldi, noelle, h)
+      ){
+      technique = "DOALL";
+      parallelTime = model.predictDOALLTime(ldi, cores);
+
+    } else if ( true
+                && noelle.isTransformationEnabled(HELIX_ID)
+                && ldi->isTransformationEnabled(HELIX_ID)
+                && helix.canBeAppliedToLoop(ldi, noelle, h)
+      ){
+      technique = "HELIX";
+      parallelTime = model.predictHELIXTime(ldi, cores);
+
+    } else if ( true
+                && noelle.isTransformationEnabled(DSWP_ID)
+                && ldi->isTransformationEnabled(DSWP_ID)
+                && dswp.canBeAppliedToLoop(ldi, noelle, h)
+      ){
+      technique = "DSWP";
+      parallelTime = model.predictDSWPTime(ldi, cores);
+    }
+    if (technique == ""){
+      return 0;
+    }
+
+    /*
+    * Compute the time saved.
+    */
+    auto timeSaved = loopTime - parallelTime;
+
+    return timeSaved;
+  }
 }
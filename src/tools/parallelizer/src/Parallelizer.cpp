@@ -166,6 +166,43 @@ namespace llvm::noelle {
       exitIndex,
       loopExitBlocks
     );
+
+    /*
+    * Tell the runtime which loop is about to be dispatched.
+    * The runtime uses this ID to aggregate the hardware performance counters of its workers per loop.
+    */
+    auto setLoopIDFunction = loopFunction->getParent()->getFunction("NOELLE_setCurrentLoopID");
+    if (setLoopIDFunction != nullptr){
+      IRBuilder<> entryBuilder(&*entryPoint->getFirstInsertionPt());
+      entryBuilder.CreateCall(setLoopIDFunction, { ConstantInt::get(par.int64, LDI->getID()) });
+    }
+
+    /*
+    * Guard the parallelized loop with its trip count.
+    *
+    * Invocations of the loop that do not execute enough iterations to amortize the cost of dispatching the parallelized loop run the original sequential loop.
+    */
+    if (  true
+          && this->enableTripCountGuard
+          && (!this->forceParallelization)
+      ){
+      if (verbose != Verbosity::Disabled) {
+        errs() << "Parallelizer:  Guard the parallelized loop with its trip count\n";
+      }
+      this->guardParallelizedLoopWithTripCount(LDI, par, par.getProfiles(), loopPreHeader);
+    }
+
+    /*
+    * Overlap the code after the loop that does not depend on it with the parallelized loop.
+    */
+    if (  true
+          && this->enableAsyncDispatch
+          && (usedTechnique == &doall)
+          && (doall.getParallelizationRuntime() == ParallelizationRuntime::NOELLE)
+      ){
+      this->overlapIndependentCodeWithParallelizedLoop(LDI, par, doall.getDispatcherCall(), exitPoint);
+    }
+
     // if (verbose >= Verbosity::Maximal) {
     //   loopFunction->print(errs() << "Final printout:\n"); errs() << "\n";
     // }
@@ -65,6 +65,12 @@ namespace llvm::noelle {
        */
       bool forceParallelization;
       bool forceNoSCCPartition;
+      bool enableTripCountGuard;
+      bool useOpenMPRuntime;
+      bool enableAsyncDispatch;
+      bool deterministicReductions;
+      uint64_t minimumInstructionsPerInvocation;
+      bool isMinimumInstructionsPerInvocationUserDefined;
 
       /*
        * Methods
@@ -82,10 +88,57 @@ namespace llvm::noelle {
 
       bool collectThreadPoolHelperFunctionsAndTypes (Module &M, Noelle &par) ;
 
+      bool guardParallelizedLoopWithTripCount (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        Hot *profiles,
+        BasicBlock *loopPreHeader
+        ) ;
+
+      uint64_t computeMinimumTripCountToParallelize (
+        LoopDependenceInfo *LDI,
+        Hot *profiles
+        ) ;
+
+      bool overlapIndependentCodeWithParallelizedLoop (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        CallInst *dispatcherCall,
+        BasicBlock *exitPoint
+        ) ;
+
+      std::vector<Instruction *> getCodeAfterLoopIndependentOfIt (
+        LoopDependenceInfo *LDI,
+        BasicBlock *loopExitBlock
+        ) ;
+
+      /*
+       * Select the loops of @tree to parallelize.
+       * The loops of the plan that maximizes the time saved in the whole tree come first. The other loops follow as alternatives.
+       */
       std::vector<LoopDependenceInfo *> selectTheOrderOfLoopsToParallelize (
         Noelle &noelle, 
         Hot *profiles,
-        noelle::StayConnectedNestedLoopForestNode *tree
+        noelle::StayConnectedNestedLoopForestNode *tree,
+        DSWP &dswp,
+        DOALL &doall,
+        HELIX &helix,
+        Heuristics *h
+        ) ;
+
+      /*
+       * Estimate the time saved by parallelizing @ldi (in the unit of the profiles of the loop, which is cycles or instructions).
+       * The result is negative if the parallelization slows down the loop. @technique is set to the technique the parallelizer would use (empty if none is applicable).
+       */
+      double estimateTimeSavedByParallelizingLoop (
+        LoopDependenceInfo *ldi,
+        Noelle &noelle,
+        Hot *profiles,
+        DSWP &dswp,
+        DOALL &doall,
+        HELIX &helix,
+        Heuristics *h,
+        std::string &technique
         ) ;
 
       /*
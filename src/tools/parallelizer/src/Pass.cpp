@@ -19,12 +19,23 @@ using namespace llvm::noelle;
 */
 static cl::opt<bool> ForceParallelization("noelle-parallelizer-force", cl::ZeroOrMore, cl::Hidden, cl::desc("Force the parallelization"));
 static cl::opt<bool> ForceNoSCCPartition("dswp-no-scc-merge", cl::ZeroOrMore, cl::Hidden, cl::desc("Force no SCC merging when parallelizing"));
+static cl::opt<bool> DisableTripCountGuard("noelle-parallelizer-no-trip-count-guard", cl::ZeroOrMore, cl::Hidden, cl::desc("Do not guard parallelized loops with a runtime check on their trip count"));
+static cl::opt<bool> UseOpenMPRuntime("noelle-parallelizer-openmp", cl::ZeroOrMore, cl::Hidden, cl::desc("Generate calls to the OpenMP runtime (libomp) instead of the NOELLE runtime for DOALL and HELIX loops"));
+static cl::opt<bool> EnableAsyncDispatch("noelle-parallelizer-async", cl::ZeroOrMore, cl::Hidden, cl::desc("Overlap the code after a parallelized loop that does not depend on it with the execution of the loop"));
+static cl::opt<bool> DeterministicReductions("noelle-parallelizer-deterministic-reductions", cl::ZeroOrMore, cl::Hidden, cl::desc("Reduce floating point variables of DOALL loops in an order that does not depend on the number of cores"));
+static cl::opt<uint64_t> MinimumInstructionsPerInvocation("noelle-parallelizer-min-insts-per-invocation", cl::ZeroOrMore, cl::Hidden, cl::init(2000), cl::desc("Minimum number of instructions a loop invocation needs to execute to be worth parallelizing"));
   
 Parallelizer::Parallelizer()
   :
   ModulePass{ID}, 
   forceParallelization{false},
-  forceNoSCCPartition{false}
+  forceNoSCCPartition{false},
+  enableTripCountGuard{true},
+  useOpenMPRuntime{false},
+  enableAsyncDispatch{false},
+  deterministicReductions{false},
+  minimumInstructionsPerInvocation{2000},
+  isMinimumInstructionsPerInvocationUserDefined{false}
   {
 
   return ;
@@ -33,6 +44,12 @@ Parallelizer::Parallelizer()
 bool Parallelizer::doInitialization (Module &M) {
   this->forceParallelization = (ForceParallelization.getNumOccurrences() > 0);
   this->forceNoSCCPartition = (ForceNoSCCPartition.getNumOccurrences() > 0);
+  this->enableTripCountGuard = (DisableTripCountGuard.getNumOccurrences() == 0);
+  this->useOpenMPRuntime = (UseOpenMPRuntime.getNumOccurrences() > 0);
+  this->enableAsyncDispatch = (EnableAsyncDispatch.getNumOccurrences() > 0);
+  this->deterministicReductions = (DeterministicReductions.getNumOccurrences() > 0);
+  this->minimumInstructionsPerInvocation = MinimumInstructionsPerInvocation.getValue();
+  this->isMinimumInstructionsPerInvocationUserDefined = (MinimumInstructionsPerInvocation.getNumOccurrences() > 0);
 
   return false; 
 }
@@ -78,6 +95,24 @@ bool Parallelizer::runOnModule (Module &M) {
     verbosity
   };
 
+  /*
+  * Select the parallel runtime.
+  * DSWP relies on the queues of the NOELLE runtime, so it keeps using it.
+  */
+  if (this->useOpenMPRuntime){
+    errs() << "Parallelizer:  Use the OpenMP runtime for DOALL and HELIX loops\n";
+    doall.setParallelizationRuntime(ParallelizationRuntime::OPENMP);
+    helix.setParallelizationRuntime(ParallelizationRuntime::OPENMP);
+  }
+
+  /*
+  * Make the reductions of floating point variables reproducible.
+  */
+  if (this->deterministicReductions){
+    errs() << "Parallelizer:  Reduce floating point variables deterministically\n";
+    doall.setDeterministicReductions(true);
+  }
+
   /*
   * Collect information about C++ code we link parallelized loops with.
   */
@@ -127,7 +162,7 @@ bool Parallelizer::runOnModule (Module &M) {
     * Check if the latency of each loop invocation is enough to justify the parallelization.
     */
     auto averageInstsPerInvocation = profiles->getAverageTotalInstructionsPerInvocation(ls);
-    auto averageInstsPerInvocationThreshold = 2000;
+    auto averageInstsPerInvocationThreshold = this->minimumInstructionsPerInvocation;
     if (  true
           && (!this->forceParallelization)
           && (averageInstsPerInvocation < averageInstsPerInvocationThreshold)
@@ -143,15 +178,34 @@ bool Parallelizer::runOnModule (Module &M) {
 
     /*
     * Check the number of iterations per invocation.
+    *
+    * When the distribution of the iterations is available, we use the median as the average can be misleading (e.g., for loops with bimodal trip counts).
     */
+    auto iterationsThreshold = 12;
+    if (profiles->hasLoopIterationsDistribution(ls)){
+      auto medianIterations = profiles->getLoopIterationsPercentile(ls, 50);
+      if (  true
+            && (!this->forceParallelization)
+            && (medianIterations < iterationsThreshold)
+        ){
+        errs() << "Parallelizer:    Loop " << loopID << " has " << medianIterations << " number of iterations per loop invocation (median)\n";
+        errs() << "Parallelizer:      It is too low. The threshold is " << iterationsThreshold << "\n";
+
+        /*
+        * Remove the loop.
+        */
+        return true;
+      }
+
+      return false;
+    }
     auto averageIterations = profiles->getAverageLoopIterationsPerInvocation(ls);
-    auto averageIterationThreshold = 12;
     if (  true
           && (!this->forceParallelization)
-          && (averageIterations < averageIterationThreshold)
+          && (averageIterations < iterationsThreshold)
       ){
       errs() << "Parallelizer:    Loop " << loopID << " has " << averageIterations << " number of iterations on average per loop invocation\n";
-      errs() << "Parallelizer:      It is too low. The threshold is " << averageIterationThreshold << "\n";
+      errs() << "Parallelizer:      It is too low. The threshold is " << iterationsThreshold << "\n";
 
       /*
       * Remove the loop.
@@ -221,6 +275,9 @@ bool Parallelizer::runOnModule (Module &M) {
       errs() << prefix << "  Average instructions per invocation = " << averageInstsPerInvocation << " %\n"; 
       auto averageIterations = profiles->getAverageLoopIterationsPerInvocation(loopStructure);
       errs() << prefix << "  Average iterations per invocation = " << averageIterations << " %\n"; 
+      if (profiles->hasLoopIterationsDistribution(loopStructure)){
+        errs() << prefix << "  Iterations per invocation (10th, 50th, 90th percentiles) = " << profiles->getLoopIterationsPercentile(loopStructure, 10) << ", " << profiles->getLoopIterationsPercentile(loopStructure, 50) << ", " << profiles->getLoopIterationsPercentile(loopStructure, 90) << "\n"; 
+      }
       errs() << prefix << "\n";
 
       return false;
@@ -241,7 +298,7 @@ bool Parallelizer::runOnModule (Module &M) {
     /*
     * Select the loops to parallelize.
     */
-    auto loopsToParallelize = this->selectTheOrderOfLoopsToParallelize(noelle, profiles, tree);
+    auto loopsToParallelize = this->selectTheOrderOfLoopsToParallelize(noelle, profiles, tree, dswp, doall, helix, heuristics);
 
     /*
     * Parallelize the loops.
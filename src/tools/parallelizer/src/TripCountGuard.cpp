@@ -0,0 +1,145 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "Parallelizer.hpp"
+#include "Architecture.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+namespace llvm::noelle {
+
+  uint64_t Parallelizer::computeMinimumTripCountToParallelize (
+    LoopDependenceInfo *LDI,
+    Hot *profiles
+    ) {
+
+    /*
+    * Fetch the loop.
+    */
+    auto ls = LDI->getLoopStructure();
+
+    /*
+    * Estimate the cost of a single iteration.
+    *
+    * When profiles are available, we use the average number of instructions executed per iteration (callees included).
+    * Otherwise, we fall back to the static number of instructions of the loop body, which is a lower bound of the dynamic one.
+    */
+    double instsPerIteration = 0;
+    if (profiles->isAvailable()){
+      instsPerIteration = profiles->getAverageTotalInstructionsPerIteration(ls);
+    }
+    if (  false
+          || (instsPerIteration < 1)
+          || std::isinf(instsPerIteration)
+      ){
+      instsPerIteration = (double)profiles->getStaticInstructions(ls);
+    }
+    if (instsPerIteration < 1){
+      instsPerIteration = 1;
+    }
+
+    /*
+    * Fetch the number of instructions an invocation needs to execute to amortize the cost of dispatching the parallelized loop.
+    *
+    * When the communication cost model has been calibrated, and the user did not set this threshold, we derive it from the measured latency to dispatch and join the tasks.
+    * Running the loop on N cores saves at most (1 - 1/N) of its sequential time, which must exceed that latency.
+    */
+    double minimumInstructions = this->minimumInstructionsPerInvocation;
+    auto cores = LDI->getMaximumNumberOfCores();
+    if (  true
+          && (!this->isMinimumInstructionsPerInvocationUserDefined)
+          && Architecture::isCommunicationCostModelCalibrated()
+          && (cores > 1)
+      ){
+      auto dispatchInstructions = Architecture::fromNanosecondsToInstructions(Architecture::getForkJoinLatency(cores));
+      minimumInstructions = dispatchInstructions / (1.0 - (1.0 / cores));
+    }
+
+    /*
+    * Compute the number of iterations needed to amortize the cost of dispatching the parallelized loop.
+    */
+    auto minimumTrips = (uint64_t)std::ceil(minimumInstructions / instsPerIteration);
+
+    return minimumTrips;
+  }
+
+  bool Parallelizer::guardParallelizedLoopWithTripCount (
+    LoopDependenceInfo *LDI,
+    Noelle &par,
+    Hot *profiles,
+    BasicBlock *loopPreHeader
+    ) {
+
+    /*
+    * Fetch the verbosity level.
+    */
+    auto verbose = par.getVerbosity();
+
+    /*
+    * Compute the minimum number of iterations that make the parallelized loop worth dispatching.
+    */
+    auto minimumTrips = this->computeMinimumTripCountToParallelize(LDI, profiles);
+    if (minimumTrips <= 1){
+      return false;
+    }
+
+    /*
+    * Check if the trip count is known at compile time.
+    * If every invocation executes enough iterations, the guard would always select the parallelized loop.
+    */
+    if (  true
+          && LDI->doesHaveCompileTimeKnownTripCount()
+          && (LDI->getCompileTimeTripCount() >= minimumTrips)
+      ){
+      return false;
+    }
+
+    /*
+    * Fetch the branch that selects between the parallelized loop and the sequential one.
+    * This branch has been generated by Noelle::linkTransformedLoopToOriginalFunction.
+    */
+    auto preHeaderTerminator = loopPreHeader->getTerminator();
+    auto preHeaderBr = dyn_cast<BranchInst>(preHeaderTerminator);
+    if (  false
+          || (preHeaderBr == nullptr)
+          || (!preHeaderBr->isConditional())
+      ){
+      return false;
+    }
+
+    /*
+    * Compute the trip count of the current invocation of the loop.
+    */
+    IRBuilder<> guardBuilder(preHeaderBr);
+    auto tripCount = IVUtility::generateCodeToComputeTripCount(LDI->getLoopStructure(), LDI->getLoopGoverningIVAttribution(), guardBuilder);
+    if (tripCount == nullptr){
+      if (verbose != Verbosity::Disabled) {
+        errs() << "Parallelizer:  The trip count of the loop cannot be computed at the preheader. No guard has been added\n";
+      }
+      return false;
+    }
+
+    /*
+    * Execute the parallelized loop only if the current invocation has enough iterations.
+    */
+    auto isWorthIt = guardBuilder.CreateICmpUGE(tripCount, ConstantInt::get(par.int64, minimumTrips));
+    auto oldCondition = preHeaderBr->getCondition();
+    auto newCondition = guardBuilder.CreateAnd(oldCondition, isWorthIt);
+    preHeaderBr->setCondition(newCondition);
+
+    if (verbose != Verbosity::Disabled) {
+      errs() << "Parallelizer:  The parallelized loop runs only for invocations with at least " << minimumTrips << " iterations\n";
+    }
+
+    return true;
+  }
+
+}
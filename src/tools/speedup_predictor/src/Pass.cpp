@@ -0,0 +1,92 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "SystemHeaders.hpp"
+#include "SpeedupPredictor.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+static cl::opt<std::string> SpeedupReportFileName("noelle-speedup-report", cl::ZeroOrMore, cl::Hidden, cl::desc("File where the predicted speedups are written"));
+
+SpeedupPredictor::SpeedupPredictor()
+  :
+  ModulePass(ID)
+  {
+
+  return ;
+}
+
+bool SpeedupPredictor::doInitialization (Module &M) {
+  this->reportFileName = SpeedupReportFileName.getNumOccurrences() > 0 ? SpeedupReportFileName.getValue() : "noelle_speedups.csv";
+
+  return false;
+}
+
+bool SpeedupPredictor::runOnModule (Module &M) {
+
+  /*
+   * Fetch the outputs of the passes we rely on.
+   */
+  auto& noelle = getAnalysis<Noelle>();
+  auto verbose = noelle.getVerbosity();
+  if (verbose != Verbosity::Disabled) {
+    errs() << "SpeedupPredictor: Start\n";
+  }
+
+  /*
+   * Fetch the profiles.
+   */
+  auto profiles = noelle.getProfiles();
+  if (!profiles->isAvailable()){
+    errs() << "SpeedupPredictor: WARNING: the profiles are not available\n";
+  }
+
+  /*
+   * Open the report.
+   */
+  std::error_code EC;
+  raw_fd_ostream report(this->reportFileName, EC, sys::fs::F_Text);
+  if (EC){
+    errs() << "SpeedupPredictor: ERROR: cannot open " << this->reportFileName << ": " << EC.message() << "\n";
+    return false;
+  }
+  report << "loop_id,function,nesting_level,hotness,time_unit,time,invocations,iterations,sequential_fraction,sequential_sccs,biggest_sequential_scc_per_iteration,sequential_per_iteration,queues,dispatch_per_invocation,technique,cores,applicable,predicted_speedup\n";
+
+  /*
+   * Predict the speedups of the hot loops.
+   */
+  SpeedupModel model(profiles);
+  auto loops = noelle.getLoops();
+  for (auto ldi : *loops){
+    if (verbose != Verbosity::Disabled) {
+      errs() << "SpeedupPredictor:   Loop " << ldi->getID() << "\n";
+    }
+    this->printReport(report, ldi, profiles, model);
+    delete ldi;
+  }
+  delete loops;
+
+  if (verbose != Verbosity::Disabled) {
+    errs() << "SpeedupPredictor: Exit\n";
+  }
+
+  return false;
+}
+
+void SpeedupPredictor::getAnalysisUsage (AnalysisUsage &AU) const {
+  AU.addRequired<Noelle>();
+
+  return ;
+}
+
+// Next there is code to register your pass to "opt"
+char SpeedupPredictor::ID = 0;
+static RegisterPass<SpeedupPredictor> X("SpeedupPredictor", "Predict the speedup of loops for every parallelization technique");
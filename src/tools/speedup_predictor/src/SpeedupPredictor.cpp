@@ -0,0 +1,136 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "SpeedupPredictor.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+bool SpeedupPredictor::isDOALLApplicable (LoopDependenceInfo *ldi, SpeedupModel &model) const {
+
+  /*
+   * The loop must have a single exit.
+   */
+  auto ls = ldi->getLoopStructure();
+  if (ls->numberOfExitBasicBlocks() > 1){
+    return false;
+  }
+
+  /*
+   * The live-out values must be reducible.
+   */
+  auto sccManager = ldi->getSCCManager();
+  if (!sccManager->areAllLiveOutValuesReducable(ldi->environment)){
+    return false;
+  }
+
+  /*
+   * The trip count must be controlled by an induction variable.
+   */
+  if (ldi->getLoopGoverningIVAttribution() == nullptr){
+    return false;
+  }
+
+  /*
+   * Iterations must be independent.
+   */
+  if (model.getSequentialSCCs(ldi).size() > 0){
+    return false;
+  }
+
+  return true;
+}
+
+bool SpeedupPredictor::isHELIXApplicable (LoopDependenceInfo *ldi, SpeedupModel &model) const {
+
+  /*
+   * HELIX synchronizes any loop-carried dependence.
+   */
+  return true;
+}
+
+bool SpeedupPredictor::isDSWPApplicable (LoopDependenceInfo *ldi, SpeedupModel &model) const {
+
+  /*
+   * DSWP needs at least one sequential stage. Otherwise, the loop is a DOALL.
+   */
+  return model.getSequentialSCCs(ldi).size() > 0;
+}
+
+void SpeedupPredictor::printReport (
+  raw_ostream &report,
+  LoopDependenceInfo *ldi,
+  Hot *profiles,
+  SpeedupModel &model
+  ) const {
+
+  /*
+   * Fetch the loop.
+   */
+  auto ls = ldi->getLoopStructure();
+  auto f = ls->getFunction();
+
+  /*
+   * Fetch the characteristics of the loop that bound its speedups.
+   */
+  auto sequentialTime = model.getSequentialTime(ldi);
+  auto invocations = profiles->getInvocations(ls);
+  auto iterations = profiles->getIterations(ls);
+  auto timeOfSequentialSCCs = model.getTimeOfSequentialSCCs(ldi);
+  auto timeOfBiggestSequentialSCC = model.getTimeOfBiggestSequentialSCC(ldi);
+  auto sequentialFraction = (sequentialTime > 0) ? (timeOfSequentialSCCs / sequentialTime) : 0;
+  auto biggestSequentialSCCPerIteration = (iterations > 0) ? (timeOfBiggestSequentialSCC / iterations) : 0;
+  auto sequentialPerIteration = (iterations > 0) ? (timeOfSequentialSCCs / iterations) : 0;
+  auto queues = model.getNumberOfQueues(ldi);
+  auto unit = model.isTimeMeasuredInCycles() ? "cycles" : "instructions";
+
+  /*
+   * Predict the speedups for powers of two cores below the cores available to the loop, and for all the cores available.
+   */
+  auto maxCores = std::max(ldi->getMaximumNumberOfCores(), (uint32_t)1);
+  std::vector<uint32_t> coreCounts{};
+  for (uint32_t cores = 1; cores < maxCores; cores *= 2){
+    coreCounts.push_back(cores);
+  }
+  coreCounts.push_back(maxCores);
+  std::vector<std::tuple<std::string, bool, std::function<double (uint32_t)>>> techniques{
+    std::make_tuple("DOALL", this->isDOALLApplicable(ldi, model), [&model, ldi](uint32_t cores) -> double { return model.predictDOALLTime(ldi, cores); }),
+    std::make_tuple("HELIX", this->isHELIXApplicable(ldi, model), [&model, ldi](uint32_t cores) -> double { return model.predictHELIXTime(ldi, cores); }),
+    std::make_tuple("DSWP", this->isDSWPApplicable(ldi, model), [&model, ldi](uint32_t cores) -> double { return model.predictDSWPTime(ldi, cores); })
+  };
+  for (auto &technique : techniques){
+    for (auto cores : coreCounts){
+      auto parallelTime = std::get<2>(technique)(cores);
+      auto dispatchPerInvocation = (invocations > 0) ? (model.getDispatchTime(ldi, cores) / invocations) : 0;
+      auto speedup = (parallelTime > 0) ? (sequentialTime / parallelTime) : 1;
+      report << ldi->getID()
+             << "," << f->getName()
+             << "," << ls->getNestingLevel()
+             << "," << profiles->getDynamicTotalInstructionCoverage(ls)
+             << "," << unit
+             << "," << sequentialTime
+             << "," << invocations
+             << "," << iterations
+             << "," << sequentialFraction
+             << "," << model.getSequentialSCCs(ldi).size()
+             << "," << biggestSequentialSCCPerIteration
+             << "," << sequentialPerIteration
+             << "," << queues
+             << "," << dispatchPerInvocation
+             << "," << std::get<0>(technique)
+             << "," << cores
+             << "," << (std::get<1>(technique) ? 1 : 0)
+             << "," << speedup
+             << "\n";
+    }
+  }
+
+  return ;
+}
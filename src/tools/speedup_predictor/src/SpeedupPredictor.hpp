@@ -0,0 +1,60 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "Noelle.hpp"
+#include "SpeedupModel.hpp"
+
+using namespace llvm;
+
+namespace llvm::noelle {
+
+  /*
+   * Predict the speedup of the hot loops of the program for every parallelization technique and number of cores.
+   * The loops are not transformed.
+   *
+   * The predictions are written to a CSV file with one row per loop, technique, and number of cores.
+   */
+  class SpeedupPredictor : public ModulePass {
+    public:
+      static char ID; 
+
+      SpeedupPredictor();
+
+      bool doInitialization (Module &M) override ;
+
+      bool runOnModule (Module &M) override ;
+      
+      void getAnalysisUsage(AnalysisUsage &AU) const override ;
+
+    private:
+      std::string reportFileName;
+
+      /*
+       * Check whether the structure of the loop allows a technique to parallelize it.
+       * This check does not include the profitability heuristics of the techniques.
+       */
+      bool isDOALLApplicable (LoopDependenceInfo *ldi, SpeedupModel &model) const ;
+
+      bool isHELIXApplicable (LoopDependenceInfo *ldi, SpeedupModel &model) const ;
+
+      bool isDSWPApplicable (LoopDependenceInfo *ldi, SpeedupModel &model) const ;
+
+      void printReport (
+        raw_ostream &report,
+        LoopDependenceInfo *ldi,
+        Hot *profiles,
+        SpeedupModel &model
+        ) const ;
+  };
+
+}
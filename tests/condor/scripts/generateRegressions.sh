@@ -84,7 +84,7 @@ function generateAllCondorJobs {
   noelleOptions="-noelle-inliner-avoid-hoist-to-main -noelle-disable-helix" ;
   generateCondor "$condorFile" "$noelleOptions" "$parOptions" "$feOptions"
 
-  noelleOptions="-noelle-disable-dswp -noelle-disable-doall -noelle-disable-helix -noelle-disable-inliner -noelle-disable-whilifier -noelle-disable-loop-distribution -noelle-disable-scev-simplification" ;
+  noelleOptions="-noelle-disable-dswp -noelle-disable-doall -noelle-disable-helix -noelle-disable-inliner -noelle-disable-whilifier -noelle-disable-loop-distribution -noelle-disable-scev-simplification -noelle-disable-loop-alias-versioning" ;
   generateCondor "$condorFile" "$noelleOptions" "$parOptions" "$feOptions"
 
   return 
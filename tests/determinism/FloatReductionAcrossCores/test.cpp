@@ -0,0 +1,45 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+double computation (double *a, double *b, long long int iters){
+  double sum = 0.1;
+  double product = 1.0;
+
+  for (auto i=0; i < iters; ++i){
+    sum += a[i];
+    product *= b[i];
+  }
+
+  return sum + product;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  double *array = (double *) calloc(iterations, sizeof(double));
+  double *factors = (double *) calloc(iterations, sizeof(double));
+
+  /*
+   * The values have different magnitudes and they are not exactly representable.
+   * Hence, their sum and their product depend on the order they are combined.
+   */
+  for (auto i=0; i < iterations; ++i){
+    array[i] = (((i % 2) == 0) ? 1e8 : -1e8) / (i + 3.0) + 1.0 / (i + 7.0);
+    factors[i] = 1.0 + (((i % 5) == 0) ? 1e-3 : -1e-3) / (i % 11 + 1.0);
+  }
+
+  /*
+   * Print the exact bits of the result.
+   */
+  auto s = computation(array, factors, iterations);
+  printf("%a\n", s);
+
+  return 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*
+ * Helpers shared by the microbenchmarks of the NOELLE runtime.
+ *
+ * This header must be included after the runtime (Parallelizer_utils.cpp).
+ */
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#define REPETITIONS 11
+
+typedef std::chrono::steady_clock benchmarkClock;
+
+static double nanosecondsSince (benchmarkClock::time_point start){
+  auto end = benchmarkClock::now();
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+static double median (std::vector<double> samples){
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+/*
+ * Push and pop values of the lock-free queues allocated by the DSWP dispatcher.
+ */
+template <typename T>
+static void lockFreeQueuePush (ThreadSafeLockFreeQueue<T> *queue, T *val){
+  queue->push(*val);
+  return ;
+}
+
+template <typename T>
+static void lockFreeQueuePop (ThreadSafeLockFreeQueue<T> *queue, T *val){
+  queue->waitPop(*val);
+  return ;
+}
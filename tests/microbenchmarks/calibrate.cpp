@@ -0,0 +1,354 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Calibration of the communication cost model of NOELLE (see Architecture.hpp).
+ *
+ * The primitives of the NOELLE runtime are measured on the current machine and the results are printed to the standard output in the format read by the option -noelle-architecture:
+ *    PROPERTY [PARAMETER]* VALUE
+ * All latencies are in nanoseconds.
+ */
+#include "Parallelizer_utils.cpp"
+#include "Benchmark.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <fstream>
+#include <set>
+#include <string>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**********************************************************************
+ *                Topology
+ **********************************************************************/
+typedef struct {
+  int32_t socket;
+  int32_t core;
+} logicalCore_t;
+
+static int32_t readTopologyFile (uint32_t cpu, const char *name){
+  auto fileName = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + name;
+  std::ifstream file(fileName);
+  int32_t value = -1;
+  if (!(file >> value)){
+    return -1;
+  }
+  return value;
+}
+
+static std::vector<logicalCore_t> fetchTopology (void){
+  std::vector<logicalCore_t> cores;
+  auto logicalCores = std::thread::hardware_concurrency();
+  for (auto cpu = 0; cpu < logicalCores; cpu++){
+    auto socket = readTopologyFile(cpu, "physical_package_id");
+    auto core = readTopologyFile(cpu, "core_id");
+    if (  false
+          || (socket < 0)
+          || (core < 0)
+      ){
+
+      /*
+       * The topology is not exposed: every logical core is assumed to be a physical core of the same socket.
+       */
+      socket = 0;
+      core = cpu;
+    }
+    cores.push_back({ socket, core });
+  }
+
+  return cores;
+}
+
+/*
+ * Find a pair of logical cores at a given distance.
+ * Return false if there is no such pair.
+ */
+static bool findCores (std::vector<logicalCore_t> &cores, const std::string &distance, uint32_t *first, uint32_t *second){
+  for (auto i = 0; i < cores.size(); i++){
+    for (auto j = i + 1; j < cores.size(); j++){
+      auto sameSocket = cores[i].socket == cores[j].socket;
+      auto sameCore = sameSocket && (cores[i].core == cores[j].core);
+      if (  false
+            || ((distance == "smt") && sameCore)
+            || ((distance == "socket") && sameSocket && !sameCore)
+            || ((distance == "cross_socket") && !sameSocket)
+        ){
+        *first = i;
+        *second = j;
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+static void pinThread (std::thread &t, uint32_t cpu){
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  pthread_setaffinity_np(t.native_handle(), sizeof(cpu_set_t), &cpus);
+
+  return ;
+}
+
+/**********************************************************************
+ *                Units
+ **********************************************************************/
+static double measureInstructionLatency (void){
+  auto iterations = 100000000;
+  std::vector<double> samples;
+  for (auto r = 0; r < REPETITIONS; r++){
+    uint64_t value = r;
+    auto start = benchmarkClock::now();
+    for (auto i = 0; i < iterations; i++){
+
+      /*
+       * Chain of dependent integer instructions.
+       */
+      value += i;
+      asm volatile("" : "+r"(value));
+      value ^= i;
+      asm volatile("" : "+r"(value));
+      value += 1;
+      asm volatile("" : "+r"(value));
+      value ^= 3;
+      asm volatile("" : "+r"(value));
+    }
+    samples.push_back(nanosecondsSince(start) / (4.0 * iterations));
+  }
+
+  return median(samples);
+}
+
+static double measureCycleLatency (void){
+  #if defined(__x86_64__) || defined(__i386__)
+
+  /*
+   * The loop profiler measures time with the time-stamp counter.
+   */
+  std::vector<double> samples;
+  for (auto r = 0; r < REPETITIONS; r++){
+    auto start = benchmarkClock::now();
+    auto startTicks = __rdtsc();
+    while (nanosecondsSince(start) < 10000000);
+    auto ticks = __rdtsc() - startTicks;
+    samples.push_back(nanosecondsSince(start) / ticks);
+  }
+  return median(samples);
+  #else
+
+  /*
+   * The loop profiler measures time in nanoseconds.
+   */
+  return 1;
+  #endif
+}
+
+/**********************************************************************
+ *                Core to core
+ **********************************************************************/
+static double measureCoreToCoreLatency (uint32_t firstCore, uint32_t secondCore){
+  auto roundTrips = 100000;
+  std::vector<double> samples;
+  for (auto r = 0; r < REPETITIONS; r++){
+
+    /*
+     * Bounce a cache line between the two cores.
+     */
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> flag{0};
+    auto start = benchmarkClock::now();
+    std::thread other([&flag, roundTrips](){
+      for (auto i = 0; i < roundTrips; i++){
+        while (flag.load(std::memory_order_acquire) != (2 * i + 1));
+        flag.store(2 * i + 2, std::memory_order_release);
+      }
+    });
+    pinThread(other, secondCore);
+    std::thread self([&flag, roundTrips](){
+      for (auto i = 0; i < roundTrips; i++){
+        flag.store(2 * i + 1, std::memory_order_release);
+        while (flag.load(std::memory_order_acquire) != (2 * i + 2));
+      }
+    });
+    pinThread(self, firstCore);
+    self.join();
+    other.join();
+    samples.push_back(nanosecondsSince(start) / (2.0 * roundTrips));
+  }
+
+  return median(samples);
+}
+
+/**********************************************************************
+ *                Queues
+ **********************************************************************/
+template <typename QueueType, typename T>
+static void measureQueue (
+  int64_t width,
+  const std::string &distance,
+  uint32_t producerCore,
+  uint32_t consumerCore,
+  void (*push)(QueueType *, T *),
+  void (*pop)(QueueType *, T *)
+  ){
+
+  /*
+   * Measure the cost of pushing and popping values when the queue streams them.
+   */
+  auto values = 1000000;
+  std::vector<double> pushSamples;
+  std::vector<double> popSamples;
+  for (auto r = 0; r < REPETITIONS; r++){
+    auto queue = new QueueType();
+    double popTime = 0;
+    double pushTime = 0;
+    std::thread consumer([queue, pop, values, &popTime](){
+      T value;
+      auto start = benchmarkClock::now();
+      for (auto i = 0; i < values; i++){
+        pop(queue, &value);
+      }
+      popTime = nanosecondsSince(start);
+    });
+    pinThread(consumer, consumerCore);
+    std::thread producer([queue, push, values, &pushTime](){
+      auto start = benchmarkClock::now();
+      for (auto i = 0; i < values; i++){
+        T value = (T) i;
+        push(queue, &value);
+      }
+      pushTime = nanosecondsSince(start);
+    });
+    pinThread(producer, producerCore);
+    producer.join();
+    consumer.join();
+    delete queue;
+    pushSamples.push_back(pushTime / values);
+    popSamples.push_back(popTime / values);
+  }
+  printf("queue_push_ns %ld %s %.2f\n", (long)width, distance.c_str(), median(pushSamples));
+  printf("queue_pop_ns %ld %s %.2f\n", (long)width, distance.c_str(), median(popSamples));
+
+  /*
+   * Measure the time a value takes to go from the producer to the consumer by bouncing it between two queues.
+   */
+  auto roundTrips = 100000;
+  std::vector<double> transferSamples;
+  for (auto r = 0; r < REPETITIONS; r++){
+    auto ping = new QueueType();
+    auto pong = new QueueType();
+    auto start = benchmarkClock::now();
+    std::thread other([ping, pong, push, pop, roundTrips](){
+      T value;
+      for (auto i = 0; i < roundTrips; i++){
+        pop(ping, &value);
+        push(pong, &value);
+      }
+    });
+    pinThread(other, consumerCore);
+    std::thread self([ping, pong, push, pop, roundTrips](){
+      T value = 0;
+      for (auto i = 0; i < roundTrips; i++){
+        push(ping, &value);
+        pop(pong, &value);
+      }
+    });
+    pinThread(self, producerCore);
+    self.join();
+    other.join();
+    transferSamples.push_back(nanosecondsSince(start) / (2.0 * roundTrips));
+    delete ping;
+    delete pong;
+  }
+  printf("queue_transfer_ns %ld %s %.2f\n", (long)width, distance.c_str(), median(transferSamples));
+  fflush(stdout);
+
+  return ;
+}
+
+/**********************************************************************
+ *                Fork/join
+ **********************************************************************/
+static void emptyTask (void *env, int64_t coreID, int64_t numCores, int64_t chunkSize){
+  return ;
+}
+
+static void measureForkJoin (uint32_t cores){
+  std::vector<double> samples;
+  for (auto r = 0; r < REPETITIONS; r++){
+    auto start = benchmarkClock::now();
+    NOELLE_DOALLDispatcher(emptyTask, nullptr, cores, 1);
+    samples.push_back(nanosecondsSince(start));
+  }
+  printf("fork_join_ns %u %.2f\n", cores, median(samples));
+  fflush(stdout);
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Describe the topology.
+   */
+  auto cores = fetchTopology();
+  std::set<int32_t> sockets;
+  std::set<std::pair<int32_t, int32_t>> physicalCores;
+  for (auto &core : cores){
+    sockets.insert(core.socket);
+    physicalCores.insert(std::make_pair(core.socket, core.core));
+  }
+  printf("# Generated by tests/microbenchmarks/calibrate\n");
+  printf("logical_cores %lu\n", (unsigned long)cores.size());
+  printf("physical_cores %lu\n", (unsigned long)physicalCores.size());
+  printf("sockets %lu\n", (unsigned long)sockets.size());
+
+  /*
+   * Measure the units used by the profiles.
+   */
+  printf("instruction_ns %.4f\n", measureInstructionLatency());
+  printf("cycle_ns %.4f\n", measureCycleLatency());
+  fflush(stdout);
+
+  /*
+   * Measure the communication costs for every distance available in the machine.
+   */
+  for (auto distance : { "smt", "socket", "cross_socket" }){
+    uint32_t firstCore, secondCore;
+    if (!findCores(cores, distance, &firstCore, &secondCore)){
+      continue ;
+    }
+    printf("core_to_core_ns %s %.2f\n", distance, measureCoreToCoreLatency(firstCore, secondCore));
+
+    /*
+     * Queues are measured as allocated by the DSWP dispatcher.
+     */
+    measureQueue(8, distance, firstCore, secondCore, lockFreeQueuePush<int8_t>, lockFreeQueuePop<int8_t>);
+    measureQueue(16, distance, firstCore, secondCore, lockFreeQueuePush<int16_t>, lockFreeQueuePop<int16_t>);
+    measureQueue(32, distance, firstCore, secondCore, lockFreeQueuePush<int32_t>, lockFreeQueuePop<int32_t>);
+    measureQueue(64, distance, firstCore, secondCore, lockFreeQueuePush<int64_t>, lockFreeQueuePop<int64_t>);
+  }
+
+  /*
+   * Measure the cost of dispatching tasks.
+   */
+  uint32_t maxCores = cores.size();
+  for (uint32_t c = 1; c < maxCores; c *= 2){
+    measureForkJoin(c);
+  }
+  measureForkJoin(maxCores);
+
+  return 0;
+}
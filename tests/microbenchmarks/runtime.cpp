@@ -0,0 +1,281 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Microbenchmarks of the primitives of the NOELLE runtime.
+ *
+ * The runtime is included (rather than linked) to reach its internal state (e.g., the DOALL argument allocator).
+ * Results are printed to the standard output as CSV with the header
+ *    benchmark,parameter,metric,value
+ * where every value is the median of the repetitions of that benchmark.
+ */
+#include "Parallelizer_utils.cpp"
+#include "Benchmark.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+static void printResult (const char *benchmark, int64_t parameter, const char *metric, double value){
+  printf("%s,%ld,%s,%.2f\n", benchmark, (long)parameter, metric, value);
+  fflush(stdout);
+}
+
+/*
+ * Fetch the number of cores the runtime can use.
+ */
+static uint32_t getNumberOfCores (void){
+  auto envVar = getenv("NOELLE_CORES");
+  if (envVar != nullptr){
+    return atoi(envVar);
+  }
+  return std::thread::hardware_concurrency();
+}
+
+/**********************************************************************
+ *                DOALL
+ **********************************************************************/
+static void emptyDOALLTask (void *env, int64_t coreID, int64_t numCores, int64_t chunkSize){
+  return ;
+}
+
+/*
+ * Iterations of the loop executed by chunkedDOALLTask.
+ */
+static int64_t chunkedLoopIterations = 0;
+
+static void chunkedDOALLTask (void *env, int64_t coreID, int64_t numCores, int64_t chunkSize){
+
+  /*
+   * Mirror the code generated by DOALL: each task starts from its first chunk and jumps over the chunks of the other tasks.
+   * The body of a chunk only touches its bounds so the time measured is dominated by moving from one chunk to the next.
+   * Each task writes to its own cache line to avoid measuring false sharing.
+   */
+  auto sinks = (volatile int64_t *) env;
+  auto sink = &sinks[coreID * (CACHE_LINE_SIZE / sizeof(int64_t))];
+  for (auto chunkStart = coreID * chunkSize; chunkStart < chunkedLoopIterations; chunkStart += numCores * chunkSize){
+    auto chunkEnd = std::min(chunkStart + chunkSize, chunkedLoopIterations);
+    (*sink) = chunkEnd;
+  }
+
+  return ;
+}
+
+static void reductionDOALLTask (void *env, int64_t coreID, int64_t numCores, int64_t chunkSize){
+
+  /*
+   * Each task stores its partial result in its own cache line as the code generated by DOALL does.
+   */
+  auto partials = (int64_t *) env;
+  partials[coreID * (CACHE_LINE_SIZE / sizeof(int64_t))] = coreID + 1;
+
+  return ;
+}
+
+static void benchmarkDOALLForkJoin (uint32_t maxCores){
+  for (auto cores = 1; cores <= maxCores; cores *= 2){
+    std::vector<double> samples;
+    for (auto r = 0; r < REPETITIONS; r++){
+      auto start = benchmarkClock::now();
+      NOELLE_DOALLDispatcher(emptyDOALLTask, nullptr, cores, 1);
+      samples.push_back(nanosecondsSince(start));
+    }
+    printResult("doall_fork_join", cores, "ns", median(samples));
+  }
+
+  return ;
+}
+
+/*
+ * Chunks are assigned statically and cyclically to the tasks (there is no chunk to grab at run time).
+ * Hence, this measures the cost of stepping from one chunk of a task to its next one.
+ */
+static void benchmarkDOALLStaticChunkStepping (uint32_t maxCores){
+  chunkedLoopIterations = 1 << 20;
+  auto sinks = (int64_t *) aligned_alloc(CACHE_LINE_SIZE, maxCores * CACHE_LINE_SIZE);
+  for (auto chunkSize = 1; chunkSize <= 1024; chunkSize *= 4){
+    std::vector<double> samples;
+    for (auto r = 0; r < REPETITIONS; r++){
+      auto start = benchmarkClock::now();
+      NOELLE_DOALLDispatcher(chunkedDOALLTask, (void *)sinks, maxCores, chunkSize);
+      samples.push_back(nanosecondsSince(start));
+    }
+    auto chunksPerCore = (double)chunkedLoopIterations / (double)(chunkSize * maxCores);
+    printResult("doall_static_chunk_stepping", chunkSize, "ns_per_chunk", median(samples) / chunksPerCore);
+  }
+  free(sinks);
+
+  return ;
+}
+
+static void benchmarkReduction (uint32_t maxCores){
+  auto partials = (int64_t *) aligned_alloc(CACHE_LINE_SIZE, maxCores * CACHE_LINE_SIZE);
+  for (auto cores = 1; cores <= maxCores; cores *= 2){
+    std::vector<double> samples;
+    for (auto r = 0; r < REPETITIONS; r++){
+      auto start = benchmarkClock::now();
+      auto info = NOELLE_DOALLDispatcher(reductionDOALLTask, (void *)partials, cores, 1);
+
+      /*
+       * Reduce the partial results as the code generated after the dispatcher does.
+       */
+      volatile int64_t total = 0;
+      for (auto i = 0; i < info.numberOfThreadsUsed; i++){
+        total += partials[i * (CACHE_LINE_SIZE / sizeof(int64_t))];
+      }
+      samples.push_back(nanosecondsSince(start));
+    }
+    printResult("reduction", cores, "ns", median(samples));
+  }
+  free(partials);
+
+  return ;
+}
+
+static void benchmarkDOALLArgsContention (uint32_t maxCores){
+  auto requestsPerThread = 100000;
+  for (auto threads = 1; threads <= maxCores; threads *= 2){
+    std::vector<double> samples;
+    for (auto r = 0; r < REPETITIONS; r++){
+      std::vector<std::thread> requesters;
+      auto start = benchmarkClock::now();
+      for (auto t = 0; t < threads; t++){
+        requesters.push_back(std::thread([requestsPerThread, maxCores](){
+          for (auto i = 0; i < requestsPerThread; i++){
+            uint32_t index;
+            runtime.getDOALLArgs(maxCores, &index);
+            runtime.releaseDOALLArgs(index);
+          }
+        }));
+      }
+      for (auto &requester : requesters){
+        requester.join();
+      }
+      samples.push_back(nanosecondsSince(start) / requestsPerThread);
+    }
+    printResult("doall_args_contention", threads, "ns_per_request", median(samples));
+  }
+
+  return ;
+}
+
+/**********************************************************************
+ *                HELIX
+ **********************************************************************/
+static void benchmarkHELIXWaitSignal (void){
+  auto roundTrips = 100000;
+
+  /*
+   * Allocate two sequential segments at the stride used by the HELIX dispatcher.
+   * The first one is available while the second one is locked.
+   */
+  auto segments = (pthread_spinlock_t *) aligned_alloc(CACHE_LINE_SIZE, 2 * CACHE_LINE_SIZE);
+  auto ping = (void *) segments;
+  auto pong = (void *) (((char *) segments) + CACHE_LINE_SIZE);
+
+  std::vector<double> samples;
+  for (auto r = 0; r < REPETITIONS; r++){
+    pthread_spin_init((pthread_spinlock_t *)ping, PTHREAD_PROCESS_PRIVATE);
+    pthread_spin_init((pthread_spinlock_t *)pong, PTHREAD_PROCESS_PRIVATE);
+    pthread_spin_lock((pthread_spinlock_t *)pong);
+
+    auto start = benchmarkClock::now();
+    std::thread other([roundTrips, ping, pong](){
+      for (auto i = 0; i < roundTrips; i++){
+        HELIX_wait(pong);
+        HELIX_signal(ping);
+      }
+    });
+    for (auto i = 0; i < roundTrips; i++){
+      HELIX_wait(ping);
+      HELIX_signal(pong);
+    }
+    other.join();
+    samples.push_back(nanosecondsSince(start) / roundTrips);
+  }
+  printResult("helix_wait_signal", 2, "ns_per_round_trip", median(samples));
+  free((void *)segments);
+
+  return ;
+}
+
+/**********************************************************************
+ *                DSWP
+ **********************************************************************/
+template <typename QueueType, typename T>
+static void benchmarkQueueThroughput (
+  const char *benchmark,
+  int64_t width,
+  void (*push)(QueueType *, T *),
+  void (*pop)(QueueType *, T *)
+  ){
+  auto values = 1000000;
+  std::vector<double> samples;
+  for (auto r = 0; r < REPETITIONS; r++){
+    auto queue = new QueueType();
+    auto start = benchmarkClock::now();
+    std::thread consumer([queue, pop, values](){
+      T value;
+      for (auto i = 0; i < values; i++){
+        pop(queue, &value);
+      }
+    });
+    for (auto i = 0; i < values; i++){
+      T value = (T) i;
+      push(queue, &value);
+    }
+    consumer.join();
+    auto elapsed = nanosecondsSince(start);
+    delete queue;
+    samples.push_back(((double)values) / (elapsed / 1e9));
+  }
+  printResult(benchmark, width, "values_per_second", median(samples));
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Fetch the number of cores to test.
+   */
+  auto maxCores = getNumberOfCores();
+  if (argc > 1){
+    maxCores = std::min((uint32_t)atoi(argv[1]), maxCores);
+  }
+  if (maxCores < 1){
+    maxCores = 1;
+  }
+
+  /*
+   * Run the benchmarks.
+   */
+  printf("benchmark,parameter,metric,value\n");
+  benchmarkDOALLForkJoin(maxCores);
+  benchmarkDOALLStaticChunkStepping(maxCores);
+  benchmarkReduction(maxCores);
+  benchmarkDOALLArgsContention(maxCores);
+  benchmarkHELIXWaitSignal();
+
+  /*
+   * Queues are measured both through the entry points of the runtime and as allocated by the DSWP dispatcher.
+   */
+  benchmarkQueueThroughput("dswp_queue_throughput", 8, queuePush8, queuePop8);
+  benchmarkQueueThroughput("dswp_queue_throughput", 16, queuePush16, queuePop16);
+  benchmarkQueueThroughput("dswp_queue_throughput", 32, queuePush32, queuePop32);
+  benchmarkQueueThroughput("dswp_queue_throughput", 64, queuePush64, queuePop64);
+  benchmarkQueueThroughput("dswp_lock_free_queue_throughput", 8, lockFreeQueuePush<int8_t>, lockFreeQueuePop<int8_t>);
+  benchmarkQueueThroughput("dswp_lock_free_queue_throughput", 16, lockFreeQueuePush<int16_t>, lockFreeQueuePop<int16_t>);
+  benchmarkQueueThroughput("dswp_lock_free_queue_throughput", 32, lockFreeQueuePush<int32_t>, lockFreeQueuePop<int32_t>);
+  benchmarkQueueThroughput("dswp_lock_free_queue_throughput", 64, lockFreeQueuePush<int64_t>, lockFreeQueuePop<int64_t>);
+
+  return 0;
+}
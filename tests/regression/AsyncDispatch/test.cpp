@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]) * 100;
+  if (iterations == 0) return 0;
+
+  long long int *a = (long long int *) malloc(sizeof(long long int) * iterations);
+  long long int *b = (long long int *) malloc(sizeof(long long int) * 16);
+
+  long long int sum = 0;
+  for (auto i=0; i < iterations; i++){
+    a[i] = (i * 3) + argc;
+    sum += a[i];
+  }
+
+  /*
+   * This code does not depend on the loop above: it only writes memory the loop does not access.
+   */
+  long long int k = argc * 7;
+  long long int m = (k * k) + iterations;
+  long long int n = m ^ (k << 3);
+  memset(b, 0, sizeof(long long int) * 16);
+  b[0] = k;
+  b[1] = m;
+  b[2] = n;
+
+  /*
+   * This code depends on the loop above.
+   */
+  auto s = a[0] + a[iterations - 1] + n;
+  printf("%lld %lld %lld %lld\n", s, sum, m, n);
+  for (auto i=0; i < 16; i++){
+    printf("%lld\n", b[i]);
+  }
+
+  return 0;
+}
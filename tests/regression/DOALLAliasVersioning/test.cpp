@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+void update (long long int *dst, long long int *src, long long int iters){
+
+  /*
+   * @dst and @src may alias.
+   * Hence, the loop can be parallelized only if run-time checks prove that the ranges of memory accessed through them do not overlap.
+   */
+  for (auto i=0; i < iters; ++i){
+    dst[i] = (src[i] * 3 + i) % 1000003;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  long long int *a = (long long int *) calloc(iterations * 2, sizeof(long long int));
+  for (auto i=0; i < iterations * 2; ++i){
+    a[i] = (i * 7919) % 1009;
+  }
+
+  /*
+   * The ranges do not overlap.
+   */
+  update(a + iterations, a, iterations);
+
+  /*
+   * The ranges overlap.
+   */
+  update(a + 1, a, iterations - 1);
+
+  long long int s = 0;
+  for (auto i=0; i < iterations * 2; ++i){
+    s += a[i];
+  }
+  printf("%lld %lld %lld\n", a[iterations - 1], a[iterations * 2 - 1], s);
+
+  return 0;
+}
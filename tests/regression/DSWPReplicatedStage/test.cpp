@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+void pipeline (long long int *b, long long int iters){
+
+  /*
+   * The update of "state" is a small sequential stage.
+   * The computation of b[i] is a large stage without loop-carried dependences, which can be replicated.
+   */
+  long long int state = 1;
+  for (auto i=0; i < iters; ++i){
+    state = (state * 1103515245 + 12345) % 2147483648;
+    auto v = state;
+    for (auto j=0; j < 50; ++j){
+      v = (v * v + j) % 1000003;
+    }
+    b[i] = v;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  long long int *b = (long long int *) calloc(iterations, sizeof(long long int));
+
+  pipeline(b, iterations);
+
+  long long int s = 0;
+  for (auto i=0; i < iterations; ++i){
+    s += b[i];
+  }
+  printf("%lld %lld %lld\n", b[iterations - 1], b[iterations / 2], s);
+
+  return 0;
+}
@@ -0,0 +1,40 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+double computation (double *a, double *b, long long int iters){
+  double sum = 0.5;
+  double difference = 1000;
+  double product = 3;
+  auto last = iters - 1;
+
+  for (auto i=0; i <= last; ++i){
+    sum += a[i];
+    difference -= a[i] * 0.5;
+    product *= b[i];
+  }
+
+  return sum + difference + product;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  double *array = (double *) calloc(iterations, sizeof(double));
+  double *factors = (double *) calloc(iterations, sizeof(double));
+  for (auto i=0; i < iterations; ++i){
+    array[i] = ((i * 7919) % 1009) * 0.25;
+    factors[i] = ((i % 3) == 0) ? 2.0 : (((i % 3) == 1) ? 0.5 : 1.0);
+  }
+
+  auto s = computation(array, factors, iterations);
+  printf("%.3f\n", s);
+
+  return 0;
+}
@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+long long int search (long long int *input, long long int iters, long long int key){
+
+  /*
+   * The loop has three exits: the one governed by the induction variable and two early ones.
+   * The bound of the loop is known only at run time.
+   */
+  for (long long int i=0; i < iters; ++i){
+    if (input[i] == key){
+      printf("Found %lld at %lld\n", key, i);
+      return i;
+    }
+    if (input[i] < 0){
+      printf("Invalid element at %lld\n", i);
+      return -1;
+    }
+  }
+  printf("%lld not found\n", key);
+
+  return -1;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  long long int *input = (long long int *) calloc(iterations, sizeof(long long int));
+  for (auto i=0; i < iterations; ++i){
+    input[i] = (i * 7919) % 1009;
+  }
+
+  long long int s = 0;
+  s += search(input, iterations, input[(iterations / 2) + 3]);
+  s += search(input, iterations, 2000);
+  input[(iterations * 3) / 4] = -1;
+  s += search(input, iterations, 2000);
+  printf("%lld\n", s);
+
+  return 0;
+}
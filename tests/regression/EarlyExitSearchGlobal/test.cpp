@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ELEMENTS 100000
+
+long long int input[ELEMENTS];
+
+long long int search (long long int key){
+
+  /*
+   * The loop has three exits: the one governed by the induction variable and two early ones.
+   * The bound of the loop and the size of the array are known at compile time.
+   */
+  for (long long int i=0; i < ELEMENTS; ++i){
+    if (input[i] == key){
+      printf("Found %lld at %lld\n", key, i);
+      return i;
+    }
+    if (input[i] < 0){
+      printf("Invalid element at %lld\n", i);
+      return -1;
+    }
+  }
+  printf("%lld not found\n", key);
+
+  return -1;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s SEED\n", argv[0]);
+    return -1;
+  }
+  auto seed = atoll(argv[1]);
+  for (auto i=0; i < ELEMENTS; ++i){
+    input[i] = ((i + seed) * 7919) % 100003;
+  }
+
+  long long int s = 0;
+  s += search(input[(ELEMENTS / 2) + 3]);
+  s += search(200000);
+  input[(ELEMENTS * 3) / 4] = -1;
+  s += search(200000);
+  printf("%lld\n", s);
+
+  return 0;
+}
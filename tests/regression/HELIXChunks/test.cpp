@@ -0,0 +1,45 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+void scan (long long int *a, long long int *b, long long int iters){
+
+  /*
+   * The loop body is too small to synchronize every iteration.
+   * The update of "state" is a sequential segment while the computation of b[i] can run in parallel.
+   */
+  long long int state = 1;
+  for (auto i=0; i < iters; ++i){
+    b[i] = (a[i] * a[i]) % 97;
+    state = (state * 31 + a[i]) % 1000003;
+    a[i] = state;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  long long int *a = (long long int *) calloc(iterations, sizeof(long long int));
+  long long int *b = (long long int *) calloc(iterations, sizeof(long long int));
+  for (auto i=0; i < iterations; ++i){
+    a[i] = (i * 7919) % 1009;
+  }
+
+  scan(a, b, iterations);
+
+  long long int s = 0;
+  for (auto i=0; i < iterations; ++i){
+    s += a[i] + b[i];
+  }
+  printf("%lld %lld %lld\n", a[iterations - 1], b[iterations / 2], s);
+
+  return 0;
+}
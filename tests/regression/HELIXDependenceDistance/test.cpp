@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+void recurrence (long long int *a, long long int *b, long long int iters){
+
+  /*
+   * Every iteration depends on the one executed 4 iterations before.
+   * Hence, up to 4 consecutive iterations can execute their sequential segment concurrently.
+   */
+  for (auto i=4; i < iters; ++i){
+    b[i] = (b[i] * b[i] + i) % 97;
+    a[i] = (a[i - 4] * 31 + b[i]) % 1000003;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  long long int *a = (long long int *) calloc(iterations, sizeof(long long int));
+  long long int *b = (long long int *) calloc(iterations, sizeof(long long int));
+  for (auto i=0; i < iterations; ++i){
+    a[i] = i % 13;
+    b[i] = (i * 7919) % 1009;
+  }
+
+  recurrence(a, b, iterations);
+
+  long long int s = 0;
+  for (auto i=0; i < iterations; ++i){
+    s += a[i] + b[i];
+  }
+  printf("%lld %lld %lld\n", a[iterations - 1], b[iterations / 2], s);
+
+  return 0;
+}
@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+long long int accumulate (long long int *a, long long int *b, long long int iters){
+
+  /*
+   * The accumulation of @sum is a sequential segment.
+   * The update of @b does not feed it, so it can be scheduled after the segment.
+   */
+  long long int sum = 0;
+  for (auto i=0; i < iters; ++i){
+    b[i] = (b[i] * b[i] + i) % 97;
+    sum = (sum * 31 + a[i]) % 1000003;
+    b[i] += sum % 7;
+  }
+
+  return sum;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  long long int *a = (long long int *) calloc(iterations, sizeof(long long int));
+  long long int *b = (long long int *) calloc(iterations, sizeof(long long int));
+  for (auto i=0; i < iterations; ++i){
+    a[i] = i % 13;
+    b[i] = (i * 7919) % 1009;
+  }
+
+  auto r = accumulate(a, b, iterations);
+
+  long long int s = 0;
+  for (auto i=0; i < iterations; ++i){
+    s += b[i];
+  }
+  printf("%lld %lld\n", r, s);
+
+  return 0;
+}
@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BINS 16
+
+void computation (long long int *input, long long int *output, long long int iters){
+
+  /*
+   * The scratch buffer is allocated once and reused by every iteration.
+   */
+  long long int *bins = (long long int *) malloc(BINS * sizeof(long long int));
+
+  for (auto i=0; i < iters; ++i){
+    memset(bins, 0, BINS * sizeof(long long int));
+    for (auto j=0; j < 64; ++j){
+      bins[(input[i] + (j * j)) % BINS] += j;
+    }
+    long long int mostFrequent = 0;
+    for (auto j=0; j < BINS; ++j){
+      if (bins[j] > bins[mostFrequent]){
+        mostFrequent = j;
+      }
+    }
+    output[i] = mostFrequent;
+  }
+
+  free(bins);
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  long long int *input = (long long int *) calloc(iterations, sizeof(long long int));
+  long long int *output = (long long int *) calloc(iterations, sizeof(long long int));
+  for (auto i=0; i < iterations; ++i){
+    input[i] = (i * 7919) % 1009;
+  }
+
+  computation(input, output, iterations);
+
+  long long int s = 0;
+  for (auto i=0; i < iterations; ++i){
+    s += output[i] * (i % 7);
+  }
+  printf("%lld\n", s);
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BINS 64
+
+long long int computation (int *idx, long long int *w, long long int iters, long long int heapBins){
+  long long int stackHist[BINS];
+  for (auto i=0; i < BINS; ++i){
+    stackHist[i] = 0;
+  }
+  long long int *heapHist = (long long int *) malloc(heapBins * sizeof(long long int));
+  for (auto i=0; i < heapBins; ++i){
+    heapHist[i] = 1;
+  }
+
+  for (auto i=0; i < iters; ++i){
+    stackHist[idx[i] % BINS] += w[i];
+  }
+
+  for (auto i=0; i < iters; ++i){
+    heapHist[idx[i] % heapBins] ^= w[i];
+  }
+
+  long long int s = 0;
+  for (auto i=0; i < BINS; ++i){
+    s += stackHist[i] * (i + 1);
+  }
+  for (auto i=0; i < heapBins; ++i){
+    s += heapHist[i] % 1000;
+  }
+  free(heapHist);
+
+  return s;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  int *idx = (int *) calloc(iterations, sizeof(int));
+  long long int *w = (long long int *) calloc(iterations, sizeof(long long int));
+  for (auto i=0; i < iterations; ++i){
+    idx[i] = (i * 7919) % 1009;
+    w[i] = (i % 13) + 1;
+  }
+
+  auto s = computation(idx, w, iterations, 1000);
+  printf("%lld\n", s);
+
+  return 0;
+}
@@ -0,0 +1,42 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+long long int computation (long long int *a, double *b, long long int iters){
+  long long int minValue = 1000000;
+  long long int maxValue = -1000000;
+  unsigned long long int maxUnsigned = 0;
+  double maxFloat = -1000000;
+
+  for (auto i=0; i < iters; ++i){
+    minValue = (a[i] < minValue) ? a[i] : minValue;
+    maxValue = (maxValue > a[i]) ? maxValue : a[i];
+    maxUnsigned = ((unsigned long long int)a[i] > maxUnsigned) ? (unsigned long long int)a[i] : maxUnsigned;
+    maxFloat = fmax(maxFloat, b[i]);
+  }
+
+  return minValue + maxValue + (long long int)(maxUnsigned % 1000) + (long long int)maxFloat;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  long long int *array = (long long int *) calloc(iterations, sizeof(long long int));
+  double *arrayOfFloats = (double *) calloc(iterations, sizeof(double));
+  for (auto i=0; i < iterations; ++i){
+    array[i] = ((i * 7919) % 1009) - 500;
+    arrayOfFloats[i] = ((i * 104729) % 2003) / 3.0;
+  }
+
+  auto s = computation(array, arrayOfFloats, iterations);
+  printf("%lld\n", s);
+
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/*
+ * Floating point min/max written as selects restart from the value that follows a NaN.
+ * Hence, they must not be reduced in parallel without fast-math flags.
+ */
+double computation (double *a, long long int iters){
+  double maxValue = -1000000;
+  double minValue = 1000000;
+
+  for (auto i=0; i < iters; ++i){
+    maxValue = (maxValue > a[i]) ? maxValue : a[i];
+    minValue = (a[i] < minValue) ? a[i] : minValue;
+  }
+
+  return maxValue - minValue;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  double *array = (double *) calloc(iterations, sizeof(double));
+  for (auto i=0; i < iterations; ++i){
+    array[i] = ((i * 104729) % 2003) / 3.0;
+  }
+
+  /*
+   * Inject NaNs in the first half of the array.
+   */
+  for (auto i=0; i < (iterations / 2); i += 7){
+    array[i] = NAN;
+  }
+
+  auto s = computation(array, iterations);
+  printf("%f\n", s);
+
+  return 0;
+}
@@ -0,0 +1,36 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+long long int computation (long long int *a, long long int iters){
+  long long int s = 0;
+  long long int c = 0;
+
+  for (auto i=0; i < iters; ++i){
+    s = (a[i] > 10) ? (s + a[i]) : s;
+    c = (a[i] % 3 == 0) ? (c + 1) : c;
+  }
+
+  return s + c;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  long long int *array = (long long int *) calloc(iterations, sizeof(long long int));
+  for (auto i=0; i < iterations; ++i){
+    array[i] = (i * argc) % 23;
+  }
+
+  auto s = computation(array, iterations);
+  printf("%lld\n", s);
+
+  return 0;
+}
@@ -0,0 +1,36 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+long long int computation (long long int *a, long long int iters){
+  long long int s = 0;
+  long long int t = 0xFF;
+
+  for (auto i=0; i < iters; ++i){
+    s ^= a[i];
+    t ^= a[i] * 3;
+  }
+
+  return s + t;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  long long int *array = (long long int *) calloc(iterations, sizeof(long long int));
+  for (auto i=0; i < iterations; ++i){
+    array[i] = i * argc;
+  }
+
+  auto s = computation(array, iterations);
+  printf("%lld\n", s);
+
+  return 0;
+}
@@ -26,5 +26,7 @@ rootDir="`git rev-parse --show-toplevel`" ;
 
 echo "Adding symbolic links for regression tests" ;
 linkParUtils regression
+echo "Adding symbolic links for determinism tests" ;
+linkParUtils determinism
 echo "Adding symbolic links for performance tests" ;
 linkParUtils performance
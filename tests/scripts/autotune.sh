@@ -0,0 +1,211 @@
+#!/bin/bash
+
+# Autotune the per-loop configuration (INDEX_FILE) of a performance test.
+#
+# Every line of the configuration describes a loop (in the order NOELLE enumerates them):
+#   parallelize unroll peel techniquesToDisable cores DOALLChunkFactor 0 0 0
+#
+# The search is a coordinate descent: for one loop and one parameter at a time, every candidate value is tried while the rest of the configuration is fixed, and the fastest one is kept.
+# The descent stops when a whole round does not improve the execution time.
+#
+# Only the parallelized binary is rebuilt between trials.
+# The profiles and the PDG embedded in baseline_with_metadata.bc are computed once and reused by all trials.
+#
+# Execution times are cached in autotuner_cache.txt across sessions.
+# The key of a trial includes the configuration, the bitcode with metadata, the inputs, and the options, so a change to any of them invalidates the times measured before.
+
+function compileConfiguration {
+  local configurationFile=$1 ;
+
+  export INDEX_FILE="$configurationFile" ;
+  rm -f test_parallelized_unoptimized.bc test_parallelized.bc parallelized ;
+  make parallelized NOELLE_OPTIONS="$NOELLE_OPTIONS" PARALLELIZATION_OPTIONS="$PARALLELIZATION_OPTIONS" RUNTIME_CFLAGS="-DNDEBUG" >> autotuner_compiler_output.txt 2>&1 ;
+
+  return $? ;
+}
+
+function measureConfiguration {
+  local ARGS=$(< perf_args.info) ;
+
+  # Measure the execution times
+  local tempFile=`mktemp` ;
+  for j in `seq 1 $RUNS` ; do
+    local start=`date +%s%N` ;
+    ./parallelized $ARGS &> autotuner_output.txt ;
+    if test $? -ne 0 ; then
+      rm $tempFile ;
+      return 1 ;
+    fi
+    local end=`date +%s%N` ;
+    echo $(( ($end - $start) / 1000000 )) >> $tempFile ;
+  done
+
+  # Check the output
+  cmp autotuner_output.txt autotuner_baseline_output.txt &> /dev/null ;
+  if test $? -ne 0 ; then
+    rm $tempFile ;
+    return 1 ;
+  fi
+
+  # Print the median (in milliseconds)
+  local median=`sort -g $tempFile | awk -v median=$(( $RUNS / 2 )) '{ if (NR - 1 == median) print ; }'` ;
+  echo $median ;
+  rm $tempFile ;
+
+  return 0 ;
+}
+
+function evaluateConfiguration {
+  local configurationFile=$1 ;
+
+  # Check if the configuration has been evaluated already
+  local key=${SESSION_KEY}_`md5sum < $configurationFile | awk '{print $1}'` ;
+  local cachedTime=`awk -v key=$key '{ if ($1 == key) print $2 ; }' $CACHE` ;
+  if test "$cachedTime" != "" ; then
+    echo $cachedTime ;
+    return ;
+  fi
+
+  # Evaluate the configuration
+  local measuredTime=$FAILURE ;
+  compileConfiguration $configurationFile ;
+  if test $? -eq 0 ; then
+    local result ;
+    result=`measureConfiguration` ;
+    if test $? -eq 0 ; then
+      measuredTime=$result ;
+    fi
+  fi
+  echo "$key $measuredTime" >> $CACHE ;
+  echo $measuredTime ;
+
+  return ;
+}
+
+function setField {
+  local inputFile=$1 ;
+  local loop=$2 ;
+  local field=$3 ;
+  local value=$4 ;
+  local outputFile=$5 ;
+
+  awk -v loop=$loop -v field=$field -v value=$value '{
+    if (NR == loop){
+      $field = value ;
+    }
+    print ;
+  }' $inputFile > $outputFile ;
+
+  return ;
+}
+
+function autotune {
+  local testDir=$1 ;
+
+  pushd ./ > /dev/null ;
+  cd $testDir ;
+  echo "Autotuning `basename $testDir`" ;
+
+  # Fetch the initial configuration
+  if ! test -f autotuner.info ; then
+    echo "ERROR: `pwd` does not include autotuner.info" ;
+    popd > /dev/null ;
+    return 1 ;
+  fi
+  cp autotuner.info autotuner_best.info ;
+  local loops=`wc -l < autotuner_best.info` ;
+
+  # Build the baseline and the metadata shared by all trials
+  export INDEX_FILE="`pwd`/autotuner_best.info" ;
+  > autotuner_compiler_output.txt ;
+  make baseline baseline_with_metadata.bc NOELLE_OPTIONS="$NOELLE_OPTIONS" PARALLELIZATION_OPTIONS="$PARALLELIZATION_OPTIONS" RUNTIME_CFLAGS="-DNDEBUG" >> autotuner_compiler_output.txt 2>&1 ;
+  if test $? -ne 0 ; then
+    echo "ERROR: `pwd` cannot be compiled" ;
+    popd > /dev/null ;
+    return 1 ;
+  fi
+  ./baseline $(< perf_args.info) &> autotuner_baseline_output.txt ;
+  if test $? -ne 0 ; then
+    echo "ERROR: the baseline of `pwd` failed (see autotuner_baseline_output.txt)" ;
+    popd > /dev/null ;
+    return 1 ;
+  fi
+
+  # Compute the key of the session: trials cached with a different bitcode, inputs, or options are ignored
+  SESSION_KEY=`cat baseline_with_metadata.bc perf_args.info <(echo "$NOELLE_OPTIONS $PARALLELIZATION_OPTIONS $RUNS") | md5sum | awk '{print $1}'` ;
+
+  # Evaluate the initial configuration
+  CACHE="`pwd`/autotuner_cache.txt" ;
+  touch $CACHE ;
+  local bestTime=$(evaluateConfiguration "`pwd`/autotuner_best.info") ;
+  echo "  Initial configuration: $bestTime ms" ;
+
+  # Candidate values of each parameter.
+  # Fields: 1 = parallelize, 4 = techniques to disable, 5 = cores, 6 = DOALL chunk factor.
+  # Techniques: 0 = all enabled, 4 = DOALL only, 5 = HELIX only, 6 = DSWP only.
+  local -a candidates ;
+  candidates[1]="0 1" ;
+  candidates[4]="0 4 5 6" ;
+  candidates[5]="" ;
+  for (( cores = 2 ; cores <= $MAX_CORES ; cores *= 2 )) ; do
+    candidates[5]="${candidates[5]} $cores" ;
+  done
+  if (( ($MAX_CORES & ($MAX_CORES - 1)) != 0 )) ; then
+    candidates[5]="${candidates[5]} $MAX_CORES" ;
+  fi
+  candidates[6]="0 1 3 7 15 31 63" ;
+
+  # Coordinate descent
+  local candidateFile="`pwd`/autotuner_candidate.info" ;
+  for round in `seq 1 $MAX_ROUNDS` ; do
+    local improved=0 ;
+    for loop in `seq 1 $loops` ; do
+      for field in 1 4 5 6 ; do
+        for value in ${candidates[$field]} ; do
+          setField autotuner_best.info $loop $field $value $candidateFile ;
+          local candidateTime=`evaluateConfiguration $candidateFile` ;
+          if (( $candidateTime < $bestTime )) ; then
+            echo "  Round $round: loop $loop, field $field = $value: $candidateTime ms" ;
+            bestTime=$candidateTime ;
+            cp $candidateFile autotuner_best.info ;
+            improved=1 ;
+          fi
+        done
+      done
+    done
+    if test $improved -eq 0 ; then
+      break ;
+    fi
+  done
+  rm -f $candidateFile ;
+
+  # Rebuild the best configuration
+  compileConfiguration "`pwd`/autotuner_best.info" ;
+  echo "  Best configuration: $bestTime ms (autotuner_best.info)" ;
+
+  popd > /dev/null ;
+  return 0 ;
+}
+
+# Options
+RUNS=${AUTOTUNER_RUNS:-3} ;
+MAX_ROUNDS=${AUTOTUNER_ROUNDS:-3} ;
+MAX_CORES=${AUTOTUNER_MAX_CORES:-`nproc`} ;
+FAILURE=999999999 ;
+NOELLE_OPTIONS=${NOELLE_OPTIONS:-"-noelle-verbose=0"} ;
+PARALLELIZATION_OPTIONS=${PARALLELIZATION_OPTIONS:-" "} ;
+
+export PATH=`pwd`/../install/bin:$PATH ;
+
+# Fetch the tests to autotune
+tests="$@" ;
+if test "$tests" == "" ; then
+  tests=`ls -d performance/*/` ;
+fi
+
+# Autotune
+for i in $tests ; do
+  autotune $i ;
+done
+
+exit 0;
@@ -22,6 +22,7 @@ function cleanTests {
 ./scripts/add_symbolic_link.sh ;
 
 cleanTests regression
+cleanTests determinism
 cleanTests performance
 cleanTests unit
 
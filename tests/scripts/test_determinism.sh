@@ -0,0 +1,76 @@
+#!/bin/bash
+
+function runningTestsWithCores {
+  local optionsToUse="$1" ;
+  local coresToTest="$2" ;
+
+  echo "Testing with \"${optionsToUse}\" on ${coresToTest} cores" ;
+
+  local checked_tests=0 ;
+  local passed_tests=0 ;
+  local dirs_of_failed_tests="" ;
+
+  for i in `ls`; do
+    if ! test -d $i ; then
+      continue ;
+    fi
+    checked_tests=`echo "$checked_tests + 1" | bc` ;
+    cd $i ;
+    echo -n -e "\r   Testing `basename $i`                                                 " ;
+
+    # Generate the input
+    make input.txt &> /dev/null ;
+
+    # Parallelize the test for every number of cores and keep the outputs
+    local failed="0" ;
+    rm -f output_parallelized_*.txt ;
+    for cores in $coresToTest ; do
+      make clean > /dev/null ;
+      make PARALLELIZATION_OPTIONS="-noelle-verbose=3 ${optionsToUse} -noelle-max-cores=${cores}" >> compiler_output.txt 2>&1 ;
+      timeout 30m ./parallelized `cat input.txt` &> output_parallelized_${cores}.txt ;
+      if test $? -ne 0 ; then
+        failed="1" ;
+      fi
+    done
+
+    # The loop must have been reduced deterministically
+    grep -q "deterministically" compiler_output.txt ;
+    if test $? -ne 0 ; then
+      failed="1" ;
+    fi
+
+    # The output must be bitwise identical for every number of cores
+    for cores in $coresToTest ; do
+      cmp output_parallelized_`echo $coresToTest | awk '{print $1}'`.txt output_parallelized_${cores}.txt &> /dev/null ;
+      if test $? -ne 0 ; then
+        failed="1" ;
+      fi
+    done
+
+    if test "$failed" == "1" ; then
+      dirs_of_failed_tests="${i} ${dirs_of_failed_tests}" ;
+    else
+      passed_tests=`echo "$passed_tests + 1" | bc` ;
+    fi
+    cd ../ ;
+  done
+
+  # Print the results
+  echo -n -e "\r   Tests passed: ${passed_tests} / ${checked_tests}                                                                   " ;
+  echo "" ;
+  if test "${dirs_of_failed_tests}" != "" ; then
+    echo "    Tests failed: ${dirs_of_failed_tests}" ;
+  fi
+  echo "" ;
+}
+
+export PATH=`pwd`/../install/bin:$PATH
+
+cd determinism ;
+
+# The floating point reductions of DOALL loops must not depend on the number of cores
+runningTestsWithCores "-noelle-parallelizer-force -noelle-disable-helix -noelle-disable-dswp -noelle-parallelizer-deterministic-reductions" "2 3 4 7 8" ;
+
+cd ../ ;
+
+exit 0;
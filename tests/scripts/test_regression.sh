@@ -43,7 +43,7 @@ function runningTests {
     make clean > /dev/null ; 
 
     # Compile
-    make PARALLELIZATION_OPTIONS="$2" >> compiler_output.txt 2>&1 ;
+    make PARALLELIZATION_OPTIONS="$2" RUNTIME_LIBS="${runtimeLibraries}" >> compiler_output.txt 2>&1 ;
     
     # Generate the input
     make input.txt &> /dev/null ;
@@ -55,8 +55,23 @@ function runningTests {
     timeout 30m ./parallelized `cat input.txt` &> output_parallelized.txt ;
 
     # Check the output ;
+    local failed="0" ;
     cmp output_baseline.txt output_parallelized.txt &> /dev/null ;
     if test $? -ne 0 ; then
+      failed="1" ;
+    fi
+
+    # Check that the compiler applied what the test expects (one message per line of the file)
+    if test "${compilerOutputToCheck}" != "" && test -f "${compilerOutputToCheck}" ; then
+      while read -r message ; do
+        grep -q -F -- "$message" compiler_output.txt ;
+        if test $? -ne 0 ; then
+          failed="1" ;
+        fi
+      done < "${compilerOutputToCheck}" ;
+    fi
+
+    if test "$failed" == "1" ; then
       dirs_of_failed_tests="${i} ${dirs_of_failed_tests}" ;
     else
       passed_tests=`echo "$passed_tests + 1" | bc` ;
@@ -77,6 +92,12 @@ function runningTests {
 
 export PATH=`pwd`/../install/bin:$PATH
 
+# Tests can include a file listing messages the compiler must print when they are parallelized by a given configuration (see compilerOutputToCheck)
+compilerOutputToCheck="" ;
+
+# Libraries the parallelized binaries must be linked with besides the NOELLE runtime (e.g., libomp when loops are parallelized for the OpenMP runtime)
+runtimeLibraries="" ;
+
 cd regression ;
 
 # Test enablers
@@ -85,7 +106,9 @@ runningTestsWrapper -noelle-disable-helix -noelle-disable-dswp -noelle-disable-d
 # Test parallelization techniques
 runningTestsWrapper 
 
+compilerOutputToCheck="doall_compiler_output.info" ;
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-helix ;
+compilerOutputToCheck="" ;
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-helix -dswp-no-scc-merge ;
 
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-dswp ;
@@ -100,6 +123,23 @@ runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-dis
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp ;
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp -dswp-no-scc-merge ;
 
+# Test the code generated for the OpenMP runtime (libomp)
+runtimeLibraries="-fopenmp" ;
+compilerOutputToCheck="openmp_doall_compiler_output.info" ;
+runningTestsWrapper -noelle-parallelizer-force -noelle-disable-helix -noelle-disable-dswp -noelle-parallelizer-openmp ;
+compilerOutputToCheck="openmp_helix_compiler_output.info" ;
+runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp -noelle-parallelizer-openmp ;
+compilerOutputToCheck="" ;
+runtimeLibraries="" ;
+
+# Test the asynchronous dispatch of DOALL loops
+compilerOutputToCheck="async_compiler_output.info" ;
+runningTestsWrapper -noelle-parallelizer-force -noelle-disable-helix -noelle-disable-dswp -noelle-parallelizer-async ;
+compilerOutputToCheck="" ;
+
+# Test the deterministic reduction of floating point variables in DOALL loops
+runningTestsWrapper -noelle-parallelizer-force -noelle-disable-helix -noelle-disable-dswp -noelle-parallelizer-deterministic-reductions ;
+
 cd ../ ;
 
 exit 0;